@@ -38,6 +38,10 @@
 
 #define HASH_TYPE_ECC SHA256  /**< Hash type */
 
+#define ECDH_BATCH 32       /**< Maximum number of signatures combined in one ECDSA batch check */
+#define ECDH_BATCH_BITS 128 /**< Size of random multipliers in ECDSA batch verification */
+#define PBKDF2_LANES 8      /**< Number of PBKDF2 output blocks iterated together */
+
 #define ECDH_OK                     0     /**< Function completed without error */
 /*#define ECDH_DOMAIN_ERROR          -1*/
 #define ECDH_INVALID_PUBLIC_KEY    -2 /**< Public Key is Invalid */
@@ -48,6 +52,26 @@
 #define ECDH_DIV_BY_ZERO           -7
 #define ECDH_BAD_ASSUMPTION        -8*/
 
+/**
+ * @brief Hash state of an HMAC, for whichever hash the key uses
+ */
+typedef union
+{
+    hash256 h256;   /**< SHA-256 state */
+    hash512 h512;   /**< SHA-384/512 state */
+} hmac_state;
+
+/**
+ * @brief HMAC key, with the hash states after absorbing the padded key
+ */
+typedef struct
+{
+    int sha;        /**< Hash type */
+    hmac_state i;   /**< State after K^ipad */
+    hmac_state o;   /**< State after K^opad */
+    hmac_state s;   /**< State of message in progress */
+} hmac_ctx;
+
 /* ECDH Auxiliary Functions */
 
 /**
@@ -96,6 +120,58 @@ extern void HASH(int h,octet *I,octet *O);
  */
 extern int HMAC(int h,octet *M,octet *K,int len,octet *tag);
 
+/**
+ * @brief Set up an HMAC key
+ *
+ * Set up an HMAC key, hashing the inner and outer padded key blocks once for any number of messages.
+ * Then each message is input with HMAC_update and the tag output with HMAC_final.
+ *
+ * @param C the HMAC key
+ * @param h is the hash type
+ * @param K input key
+ * @return 0 for bad parameters, else 1
+ */
+extern int HMAC_init(hmac_ctx *C,int h,octet *K);
+
+/**
+ * @brief Input part of a message to HMAC
+ *
+ * @param C the HMAC key
+ * @param m the bytes of the message
+ * @param len the number of bytes
+ */
+extern void HMAC_update(hmac_ctx *C,const char *m,size_t len);
+
+/**
+ * @brief Output the HMAC tag of a message
+ *
+ * Output the HMAC tag of the message input since the last tag, as calculated by HMAC, and start the next message.
+ *
+ * @param C the HMAC key
+ * @param len is output desired length of HMAC tag
+ * @param tag is the output HMAC
+ * @return 0 for bad parameters, else 1
+ */
+extern int HMAC_final(hmac_ctx *C,int len,octet *tag);
+
+/**
+ * @brief Calculate HMAC of message M using a key set up by HMAC_init
+ *
+ * @param C the HMAC key
+ * @param M input message octet
+ * @param len is output desired length of HMAC tag
+ * @param tag is the output HMAC, which may be the same octet as M
+ * @return 0 for bad parameters, else 1
+ */
+extern int HMAC_ctx(hmac_ctx *C,octet *M,int len,octet *tag);
+
+/**
+ * @brief Clean up an HMAC key
+ *
+ * @param C the HMAC key
+ */
+extern void HMAC_end(hmac_ctx *C);
+
 /*extern void KDF1(octet *,int,octet *);*/
 
 /**
@@ -125,6 +201,22 @@ extern void KDF2(int h,octet *Z,octet *P,int len,octet *K);
  */
 extern void PBKDF2(int h,octet *P,octet *S,int rep,int len,octet *K);
 
+/**
+ * @brief Password Based Key Derivation Function for a number of passwords and salts
+ *
+ * Derive keys K[i] from passwords P[i] and salts S[i], giving the same keys as PBKDF2. The output
+ * blocks of all the keys are iterated together, in the lanes of vector registers where available.
+ *
+ * @param h is the hash type
+ * @param n the number of keys
+ * @param P input passwords
+ * @param S input salts
+ * @param rep Number of times to be iterated.
+ * @param len is output desired length
+ * @param K are the derived keys
+ */
+extern void PBKDF2_batch(int h,int n,octet *P[],octet *S[],int rep,int len,octet *K[]);
+
 /**
  * @brief AES encrypts a plaintext to a ciphtertext
  *
@@ -265,6 +357,26 @@ extern int ECPSP_DSA(int h,csprng *R,octet *k,octet *s,octet *M,octet *c,octet *
  * @return 0 or an error code
  */
 extern int ECPVP_DSA(int h,octet *W,octet *M,octet *c,octet *d);
+/**
+ * @brief Batch ECDSA Signature Verification
+ *
+ * Verifies n signatures together by checking a random linear combination with one multi-multiplication.
+ * If the combination fails it is split in two until the bad signatures are found.
+ *
+ * @note Only signatures with c given as a compressed point, i.e. 0x02 or 0x03 for the parity of the y-coordinate
+ * of R followed by c, can be batched. Others are checked one at a time by ECPVP_DSA. So are all signatures on
+ * curves with a cofactor, that is Edwards and Montgomery curves and BLS curves, where points outside the group
+ * of prime order could otherwise pass the batch.
+ * @param h is the hash type
+ * @param n number of signatures
+ * @param W array of n input public keys
+ * @param M array of n input messages
+ * @param c array of n components of the input signatures, optionally with a y parity byte
+ * @param d array of n components of the input signatures
+ * @param results array of n outputs, 0 or the error code of ECPVP_DSA for each signature
+ * @return 0 if all signatures are valid, or else an error code
+ */
+extern int ECPVP_DSA_batch(int h,int n,octet *W[],octet *M[],octet *c[],octet *d[],int *results);
 /*#endif*/
 
 #endif
@@ -31,6 +31,9 @@
 #define MPIN_H
 
 #include "amcl.h"
+#ifdef USE_THREADS
+#include <pthread.h>
+#endif
 
 /* Field size is assumed to be greater than or equal to group size */
 
@@ -52,6 +55,7 @@
 #define MPIN_WRONG_ORDER           -18
  */
 #define MPIN_BAD_PIN               -19  /**< Bad PIN number entered */
+#define MPIN_THREAD_ERROR          -20  /**< Worker thread could not be started */
 
 
 /* Configure your PIN here */
@@ -65,6 +69,55 @@
 #define MESSAGE_SIZE 256  /**< Signature message size  */
 #define M_SIZE (MESSAGE_SIZE+2*PFS+1)   /**< Signature message size and G1 size */
 
+#define MPIN_BATCH_BITS 128  /**< Size in bits of the random multipliers used in batch verification */
+#define MPIN_MAX_THREADS 64  /**< Maximum number of worker threads in a MPIN_POOL */
+#define MPIN_HASH_LANES 16   /**< Client IDs hashed together by MPIN_SERVER_1_batch */
+
+/**
+ * @brief MPIN server context - the generator of G2 and the server secret, decoded and validated once
+ *
+ * @note Large when precomputed lines are used, so best allocated statically or on the heap
+ */
+typedef struct
+{
+    ECP2 Q;          /**< Generator of G2, affine */
+    ECP2 sQ;         /**< Server secret, affine */
+    int precomp;     /**< 1 if the precomputed lines TQ and TsQ are valid */
+    pair_table TQ;   /**< Precomputed Miller loop lines of Q */
+    pair_table TsQ;  /**< Precomputed Miller loop lines of sQ */
+} MPIN_SERVER_CTX;
+
+#ifdef USE_THREADS
+/**
+ * @brief Pool of worker threads for MPIN server batch verification
+ */
+typedef struct
+{
+    int nthreads;                       /**< Number of worker threads */
+    pthread_t thread[MPIN_MAX_THREADS]; /**< Worker threads */
+    csprng rng[MPIN_MAX_THREADS];       /**< Random number generator of each worker */
+    pthread_mutex_t call;               /**< Serialises callers of the pool */
+    pthread_mutex_t lock;               /**< Protects the job state below */
+    pthread_cond_t work;                /**< Signalled when a job is posted */
+    pthread_cond_t done;                /**< Signalled when a worker finishes */
+    int generation;                     /**< Incremented for each job posted */
+    int pending;                        /**< Number of workers still busy with the job */
+    int quit;                           /**< Set to stop the workers */
+    /* current job */
+    MPIN_SERVER_CTX *C;                 /**< Server context */
+    int n;                              /**< Number of clients */
+    int d;                              /**< Date */
+    octet **HID;                        /**< H(ID) of each client */
+    octet **HTID;                       /**< H(ID)+H(d|H(ID)) of each client */
+    octet **Y;                          /**< Challenge to each client */
+    octet **U;                          /**< U of each client */
+    octet **UT;                         /**< UT of each client */
+    octet **V;                          /**< V of each client */
+    int *results;                       /**< Result of each client */
+    int rtn[MPIN_MAX_THREADS];          /**< Return code of each worker */
+} MPIN_POOL;
+#endif
+
 /* MPIN support functions */
 
 /* MPIN primitives */
@@ -214,6 +267,29 @@ int MPIN_CLIENT_2(octet *X,octet *Y,octet *V);
  */
 int MPIN_SERVER(int h,int d,octet *HID,octet *HTID,octet *y,octet *SS,octet *U,octet *UT,octet *V,octet *E,octet *F,octet *ID,octet *MESSAGE, int t);
 
+/**
+ * @brief Perform server side of the one-pass version of the M-Pin protocol, using a server context
+ *
+ * As MPIN_SERVER, but with the server secret taken from a server context.
+ *
+ * @param C is the input server context
+ * @param h is the hash type
+ * @param d is input date, in days since the epoch. Set to 0 if Time permits disabled
+ * @param HID is output H(ID), a hash of the client ID
+ * @param HTID is output H(ID)+H(d|H(ID))
+ * @param y is output H(t|U) or H(t|UT) if Time Permits enabled
+ * @param U is input from the client = x.H(ID)
+ * @param UT is input from the client= x.(H(ID)+H(d|H(ID)))
+ * @param V is an input from the client
+ * @param E is an output to help the Kangaroos to find the PIN error, or NULL if not required
+ * @param F is an output to help the Kangaroos to find the PIN error, or NULL if not required
+ * @param ID is the input claimed client identity
+ * @param MESSAGE is the message to be signed
+ * @param t is input epoch time in seconds - a timestamp
+ * @return 0 or an error code
+ */
+int MPIN_SERVER_ctx(MPIN_SERVER_CTX *C,int h,int d,octet *HID,octet *HTID,octet *y,octet *U,octet *UT,octet *V,octet *E,octet *F,octet *ID,octet *MESSAGE, int t);
+
 /**
  * @brief Perform first pass of the server side of the 3-pass version of the M-Pin protocol
  *
@@ -227,6 +303,21 @@ int MPIN_SERVER(int h,int d,octet *HID,octet *HTID,octet *y,octet *SS,octet *U,o
  */
 void MPIN_SERVER_1(int h,int d,octet *ID,octet *HID,octet *HTID);
 
+/**
+ * @brief Perform first pass of the server side of the 3-pass version of the M-Pin protocol for a batch of clients
+ *
+ * Perform first pass of the server side for a batch of clients, with the same results as
+ * MPIN_SERVER_1 for each. The client IDs are hashed together with the multi-buffer hash functions.
+ *
+ * @param h is the hash type
+ * @param d is input date, in days since the epoch. Set to 0 if Time permits disabled
+ * @param n is the number of clients
+ * @param ID is array of n input claimed client identities
+ * @param HID is array of n outputs H(ID), a hash of the client ID
+ * @param HTID is array of n outputs H(ID)+H(d|H(ID)), not used if d is 0
+ */
+void MPIN_SERVER_1_batch(int h,int d,int n,octet *ID[],octet *HID[],octet *HTID[]);
+
 /**
  * @brief Perform third pass on the server side of the 3-pass version of the M-Pin protocol
  *
@@ -249,6 +340,110 @@ void MPIN_SERVER_1(int h,int d,octet *ID,octet *HID,octet *HTID);
  */
 int MPIN_SERVER_2(int d,octet *HID,octet *HTID,octet *y,octet *SS,octet *U,octet *UT,octet *V,octet *E,octet *F);
 
+/**
+ * @brief Initialise a server context from the server secret
+ *
+ * Decode and validate the server secret and the generator of G2 once, for use by MPIN_SERVER_2_ctx and MPIN_SERVER_ctx.
+ *
+ * @param C is the output server context
+ * @param SS is the input server secret
+ * @param p set to 1 to also precompute the pairing lines of the generator and server secret, else 0
+ * @return 0 or an error code
+ */
+int MPIN_SERVER_CTX_CREATE(MPIN_SERVER_CTX *C,octet *SS,int p);
+
+/**
+ * @brief Kill a server context
+ *
+ * Erase the server secret held in the server context.
+ *
+ * @param C is the server context
+ */
+void MPIN_SERVER_CTX_KILL(MPIN_SERVER_CTX *C);
+
+/**
+ * @brief Perform third pass on the server side of the 3-pass version of the M-Pin protocol, using a server context
+ *
+ * As MPIN_SERVER_2, but with the server secret taken from a server context.
+ *
+ * @param C is the input server context
+ * @param d is input date, in days since the epoch. Set to 0 if Time permits disabled
+ * @param HID is input H(ID), a hash of the client ID
+ * @param HTID is input H(ID)+H(d|H(ID))
+ * @param y is the input server's randomly generated challenge
+ * @param U is input from the client = x.H(ID)
+ * @param UT is input from the client= x.(H(ID)+H(d|H(ID)))
+ * @param V is an input from the client
+ * @param E is an output to help the Kangaroos to find the PIN error, or NULL if not required
+ * @param F is an output to help the Kangaroos to find the PIN error, or NULL if not required
+ * @return 0 or an error code
+ * @note The server context is not modified, so may be shared between threads
+ */
+int MPIN_SERVER_2_ctx(MPIN_SERVER_CTX *C,int d,octet *HID,octet *HTID,octet *y,octet *U,octet *UT,octet *V,octet *E,octet *F);
+
+/**
+ * @brief Perform third pass on the server side of the 3-pass version of the M-Pin protocol for a batch of clients
+ *
+ * The checks of all clients are combined with random multipliers into a single double pairing. Only if
+ * that fails is each client checked separately, so the results are those of MPIN_SERVER_2_ctx.
+ *
+ * @param C is the input server context
+ * @param R is a pointer to a cryptographically secure random number generator
+ * @param n is the number of clients
+ * @param d is input date, in days since the epoch. Set to 0 if Time permits disabled
+ * @param HID is array of n inputs H(ID), a hash of the client ID
+ * @param HTID is array of n inputs H(ID)+H(d|H(ID))
+ * @param y is array of n input server's randomly generated challenges
+ * @param U is array of n inputs from the clients = x.H(ID)
+ * @param UT is array of n inputs from the clients= x.(H(ID)+H(d|H(ID)))
+ * @param V is array of n inputs from the clients
+ * @param results is output array of n results, 0 or an error code for each client
+ * @return 0 if all clients are good, else one of the error codes in results
+ * @note PIN error data for the Kangaroos is not returned. Use MPIN_SERVER_2_ctx on a failed client if required
+ */
+int MPIN_SERVER_2_batch(MPIN_SERVER_CTX *C,csprng *R,int n,int d,octet *HID[],octet *HTID[],octet *y[],octet *U[],octet *UT[],octet *V[],int results[]);
+
+#ifdef USE_THREADS
+/**
+ * @brief Start a pool of worker threads for MPIN server batch verification
+ *
+ * Each worker gets its own random number generator, seeded from R.
+ *
+ * @param P is the output pool
+ * @param t is the number of worker threads, at most MPIN_MAX_THREADS
+ * @param R is a pointer to a cryptographically secure random number generator
+ * @return 0 or an error code
+ */
+int MPIN_POOL_CREATE(MPIN_POOL *P,int t,csprng *R);
+
+/**
+ * @brief Stop the worker threads of a pool
+ *
+ * @param P is the pool
+ */
+void MPIN_POOL_KILL(MPIN_POOL *P);
+
+/**
+ * @brief Perform third pass on the server side of the 3-pass version of the M-Pin protocol for a batch of clients, using a pool of threads
+ *
+ * The batch is split evenly between the workers, each of which runs MPIN_SERVER_2_batch on its share.
+ *
+ * @param P is the pool
+ * @param C is the input server context
+ * @param n is the number of clients
+ * @param d is input date, in days since the epoch. Set to 0 if Time permits disabled
+ * @param HID is array of n inputs H(ID), a hash of the client ID
+ * @param HTID is array of n inputs H(ID)+H(d|H(ID))
+ * @param y is array of n input server's randomly generated challenges
+ * @param U is array of n inputs from the clients = x.H(ID)
+ * @param UT is array of n inputs from the clients= x.(H(ID)+H(d|H(ID)))
+ * @param V is array of n inputs from the clients
+ * @param results is output array of n results, 0 or an error code for each client, in the order given
+ * @return 0 if all clients are good, else one of the error codes in results
+ */
+int MPIN_SERVER_2_pool(MPIN_POOL *P,MPIN_SERVER_CTX *C,int n,int d,octet *HID[],octet *HTID[],octet *y[],octet *U[],octet *UT[],octet *V[],int results[]);
+#endif
+
 /**
  * @brief Add two members from the group G1
  *
@@ -33,6 +33,12 @@
 /* this is fixed */
 #define NB 4
 
+#define AES_PIPE 8 /* blocks processed together */
+
+#ifdef AMCL_X86_64
+#include <wmmintrin.h>
+#endif
+
 /* Rotates 32-bit word left by 1, 2 or 3 byte  */
 
 #define ROTL8(x) (((x)<<8)|((x)>>24))
@@ -301,50 +307,60 @@ void AES_getreg(amcl_aes *a,char *ir)
     for (i=0; i<4*NB; i++) ir[i]=a->f[i];
 }
 
-/* SU= 72, Initialise an instance of AMCL_AES and its mode of operation */
-int AES_init(amcl_aes* a,int mode,int nk,char *key,char *iv)
+/* SU= 40, Expand key of nk words into encryption key schedule, returns number of rounds */
+static int expand(unsign32 *fkey,int nk,char *key)
 {
-    /* Key length Nk=16, 24 or 32 bytes */
-    /* Key Scheduler. Create expanded encryption key */
     int i,j,k,N,nr;
-    unsign32 CipherKey[8];
-
-    nk/=4;
 
     if (nk!=4 && nk!=6 && nk!=8) return 0;
 
     nr=6+nk;
-
-    a->Nk=nk;
-    a->Nr=nr;
-
-    AES_reset(a,mode,iv);
-
     N=NB*(nr+1);
 
     for (i=j=0; i<nk; i++,j+=4)
     {
-        CipherKey[i]=pack((uchar *)&key[j]);
+        fkey[i]=pack((uchar *)&key[j]);
     }
-    for (i=0; i<nk; i++) a->fkey[i]=CipherKey[i];
     for (j=nk,k=0; j<N; j+=nk,k++)
     {
-        a->fkey[j]=a->fkey[j-nk]^SubByte(ROTL24(a->fkey[j-1]))^rco[k];
+        fkey[j]=fkey[j-nk]^SubByte(ROTL24(fkey[j-1]))^rco[k];
         if (nk<=6)
         {
             for (i=1; i<nk && (i+j)<N; i++)
-                a->fkey[i+j]=a->fkey[i+j-nk]^a->fkey[i+j-1];
+                fkey[i+j]=fkey[i+j-nk]^fkey[i+j-1];
         }
         else
         {
             for (i=1; i<4 && (i+j)<N; i++)
-                a->fkey[i+j]=a->fkey[i+j-nk]^a->fkey[i+j-1];
-            if ((j+4)<N) a->fkey[j+4]=a->fkey[j+4-nk]^SubByte(a->fkey[j+3]);
+                fkey[i+j]=fkey[i+j-nk]^fkey[i+j-1];
+            if ((j+4)<N) fkey[j+4]=fkey[j+4-nk]^SubByte(fkey[j+3]);
             for (i=5; i<nk && (i+j)<N; i++)
-                a->fkey[i+j]=a->fkey[i+j-nk]^a->fkey[i+j-1];
+                fkey[i+j]=fkey[i+j-nk]^fkey[i+j-1];
         }
 
     }
+    return nr;
+}
+
+/* SU= 72, Initialise an instance of AMCL_AES and its mode of operation */
+int AES_init(amcl_aes* a,int mode,int nk,char *key,char *iv)
+{
+    /* Key length Nk=16, 24 or 32 bytes */
+    /* Key Scheduler. Create expanded encryption key */
+    int i,j,k,N,nr;
+
+    nk/=4;
+
+    nr=expand(a->fkey,nk,key);
+    if (nr==0) return 0;
+
+    a->Nk=nk;
+    a->Nr=nr;
+
+    AES_reset(a,mode,iv);
+
+    N=NB*(nr+1);
+
     /* now for the expanded decrypt key in reverse order */
 
     for (j=0; j<NB; j++) a->rkey[j+N-NB]=a->fkey[j];
@@ -357,8 +373,128 @@ int AES_init(amcl_aes* a,int mode,int nk,char *key,char *iv)
     return 1;
 }
 
-/* SU= 80, Encrypt a single 16 byte block in ECB mode */
-void AES_ecb_encrypt(amcl_aes *a,uchar *buff)
+/* Initialise an encryption only key schedule */
+int AES_enc_init(amcl_aes_enc *e,int nk,char *key)
+{
+    e->Nr=expand(e->fkey,nk/4,key);
+    return (e->Nr!=0);
+}
+
+/* Clean up an encryption only key schedule */
+void AES_enc_end(amcl_aes_enc *e)
+{
+    int i;
+    for (i=0; i<NB*(e->Nr+1); i++) e->fkey[i]=0;
+}
+
+#ifdef AMCL_X86_64
+
+/* AES-NI. Round keys are held as little-endian words, so can be loaded directly. fkey is the
+   schedule of the cipher and rkey that of the equivalent inverse cipher, as expected by AESDEC.
+   Independent blocks are interleaved to hide the latency of the round instructions.
+   Unlike the tables, the instructions take the same time for all data */
+
+#define AES_NI __attribute__((target("aes,sse2")))
+
+/* 1 if the processor supports AES-NI */
+static int aesni_supported(void)
+{
+    return CPU_has(CPU_AES);
+}
+
+AES_NI static void aesni_keys(__m128i *K,const unsign32 *key,int nr)
+{
+    int i;
+    for (i=0; i<=nr; i++) K[i]=_mm_loadu_si128((const __m128i *)&key[NB*i]);
+}
+
+/* encrypt n blocks in ECB mode */
+AES_NI static void aesni_encrypt(const unsign32 *fkey,int nr,uchar *buff,int n)
+{
+    int i,j;
+    __m128i K[15],x[AES_PIPE];
+
+    aesni_keys(K,fkey,nr);
+    for (; n>=AES_PIPE; n-=AES_PIPE,buff+=16*AES_PIPE)
+    {
+        for (j=0; j<AES_PIPE; j++) x[j]=_mm_xor_si128(_mm_loadu_si128((__m128i *)&buff[16*j]),K[0]);
+        for (i=1; i<nr; i++)
+            for (j=0; j<AES_PIPE; j++) x[j]=_mm_aesenc_si128(x[j],K[i]);
+        for (j=0; j<AES_PIPE; j++) _mm_storeu_si128((__m128i *)&buff[16*j],_mm_aesenclast_si128(x[j],K[i]));
+    }
+    for (; n>0; n--,buff+=16)
+    {
+        x[0]=_mm_xor_si128(_mm_loadu_si128((__m128i *)buff),K[0]);
+        for (i=1; i<nr; i++) x[0]=_mm_aesenc_si128(x[0],K[i]);
+        _mm_storeu_si128((__m128i *)buff,_mm_aesenclast_si128(x[0],K[i]));
+    }
+}
+
+/* decrypt n blocks in ECB mode */
+AES_NI static void aesni_decrypt(const amcl_aes *a,uchar *buff,int n)
+{
+    int i,j;
+    __m128i K[15],x[AES_PIPE];
+
+    aesni_keys(K,a->rkey,a->Nr);
+    for (; n>=AES_PIPE; n-=AES_PIPE,buff+=16*AES_PIPE)
+    {
+        for (j=0; j<AES_PIPE; j++) x[j]=_mm_xor_si128(_mm_loadu_si128((__m128i *)&buff[16*j]),K[0]);
+        for (i=1; i<a->Nr; i++)
+            for (j=0; j<AES_PIPE; j++) x[j]=_mm_aesdec_si128(x[j],K[i]);
+        for (j=0; j<AES_PIPE; j++) _mm_storeu_si128((__m128i *)&buff[16*j],_mm_aesdeclast_si128(x[j],K[i]));
+    }
+    for (; n>0; n--,buff+=16)
+    {
+        x[0]=_mm_xor_si128(_mm_loadu_si128((__m128i *)buff),K[0]);
+        for (i=1; i<a->Nr; i++) x[0]=_mm_aesdec_si128(x[0],K[i]);
+        _mm_storeu_si128((__m128i *)buff,_mm_aesdeclast_si128(x[0],K[i]));
+    }
+}
+
+/* counter mode encryption of n blocks */
+AES_NI static void aesni_ctr(amcl_aes *a,uchar *out,const uchar *in,size_t n)
+{
+    int i,j;
+    unsign64 lo=0,hi=0;
+    __m128i K[15],x[AES_PIPE];
+
+    /* the counter is incremented as a little-endian 128-bit number */
+    for (i=7; i>=0; i--)
+    {
+        lo=(lo<<8)|(uchar)a->f[i];
+        hi=(hi<<8)|(uchar)a->f[i+8];
+    }
+
+    aesni_keys(K,a->fkey,a->Nr);
+    for (; n>0; n-=j,in+=16*j,out+=16*j)
+    {
+        for (j=0; j<AES_PIPE && (size_t)j<n; j++)
+        {
+            x[j]=_mm_xor_si128(_mm_set_epi64x((long long)hi,(long long)lo),K[0]);
+            lo++;
+            if (lo==0) hi++;
+        }
+        for (i=1; i<a->Nr; i++)
+            for (j=0; j<AES_PIPE && (size_t)j<n; j++) x[j]=_mm_aesenc_si128(x[j],K[i]);
+        for (j=0; j<AES_PIPE && (size_t)j<n; j++)
+        {
+            x[j]=_mm_aesenclast_si128(x[j],K[i]);
+            _mm_storeu_si128((__m128i *)&out[16*j],_mm_xor_si128(x[j],_mm_loadu_si128((const __m128i *)&in[16*j])));
+        }
+    }
+
+    for (i=0; i<8; i++)
+    {
+        a->f[i]=(char)(lo>>(8*i));
+        a->f[i+8]=(char)(hi>>(8*i));
+    }
+}
+
+#endif
+
+/* SU= 80, Encrypt a single 16 byte block with the tables */
+static void ecb_encrypt(const unsign32 *fkey,int nr,uchar *buff)
 {
     int i,j,k;
     unsign32 p[4],q[4],*x,*y,*t;
@@ -366,7 +502,7 @@ void AES_ecb_encrypt(amcl_aes *a,uchar *buff)
     for (i=j=0; i<NB; i++,j+=4)
     {
         p[i]=pack((uchar *)&buff[j]);
-        p[i]^=a->fkey[i];
+        p[i]^=fkey[i];
     }
 
     k=NB;
@@ -374,22 +510,22 @@ void AES_ecb_encrypt(amcl_aes *a,uchar *buff)
     y=q;
 
     /* State alternates between x and y */
-    for (i=1; i<a->Nr; i++)
+    for (i=1; i<nr; i++)
     {
 
-        y[0]=a->fkey[k]^ftable[MR_TOBYTE(x[0])]^
+        y[0]=fkey[k]^ftable[MR_TOBYTE(x[0])]^
              ROTL8(ftable[MR_TOBYTE(x[1]>>8)])^
              ROTL16(ftable[MR_TOBYTE(x[2]>>16)])^
              ROTL24(ftable[x[3]>>24]);
-        y[1]=a->fkey[k+1]^ftable[MR_TOBYTE(x[1])]^
+        y[1]=fkey[k+1]^ftable[MR_TOBYTE(x[1])]^
              ROTL8(ftable[MR_TOBYTE(x[2]>>8)])^
              ROTL16(ftable[MR_TOBYTE(x[3]>>16)])^
              ROTL24(ftable[x[0]>>24]);
-        y[2]=a->fkey[k+2]^ftable[MR_TOBYTE(x[2])]^
+        y[2]=fkey[k+2]^ftable[MR_TOBYTE(x[2])]^
              ROTL8(ftable[MR_TOBYTE(x[3]>>8)])^
              ROTL16(ftable[MR_TOBYTE(x[0]>>16)])^
              ROTL24(ftable[x[1]>>24]);
-        y[3]=a->fkey[k+3]^ftable[MR_TOBYTE(x[3])]^
+        y[3]=fkey[k+3]^ftable[MR_TOBYTE(x[3])]^
              ROTL8(ftable[MR_TOBYTE(x[0]>>8)])^
              ROTL16(ftable[MR_TOBYTE(x[1]>>16)])^
              ROTL24(ftable[x[2]>>24]);
@@ -402,19 +538,19 @@ void AES_ecb_encrypt(amcl_aes *a,uchar *buff)
 
     /* Last Round */
 
-    y[0]=a->fkey[k]^(unsign32)fbsub[MR_TOBYTE(x[0])]^
+    y[0]=fkey[k]^(unsign32)fbsub[MR_TOBYTE(x[0])]^
          ROTL8((unsign32)fbsub[MR_TOBYTE(x[1]>>8)])^
          ROTL16((unsign32)fbsub[MR_TOBYTE(x[2]>>16)])^
          ROTL24((unsign32)fbsub[x[3]>>24]);
-    y[1]=a->fkey[k+1]^(unsign32)fbsub[MR_TOBYTE(x[1])]^
+    y[1]=fkey[k+1]^(unsign32)fbsub[MR_TOBYTE(x[1])]^
          ROTL8((unsign32)fbsub[MR_TOBYTE(x[2]>>8)])^
          ROTL16((unsign32)fbsub[MR_TOBYTE(x[3]>>16)])^
          ROTL24((unsign32)fbsub[x[0]>>24]);
-    y[2]=a->fkey[k+2]^(unsign32)fbsub[MR_TOBYTE(x[2])]^
+    y[2]=fkey[k+2]^(unsign32)fbsub[MR_TOBYTE(x[2])]^
          ROTL8((unsign32)fbsub[MR_TOBYTE(x[3]>>8)])^
          ROTL16((unsign32)fbsub[MR_TOBYTE(x[0]>>16)])^
          ROTL24((unsign32)fbsub[x[1]>>24]);
-    y[3]=a->fkey[k+3]^(unsign32)fbsub[MR_TOBYTE(x[3])]^
+    y[3]=fkey[k+3]^(unsign32)fbsub[MR_TOBYTE(x[3])]^
          ROTL8((unsign32)fbsub[MR_TOBYTE(x[0]>>8)])^
          ROTL16((unsign32)fbsub[MR_TOBYTE(x[1]>>16)])^
          ROTL24((unsign32)fbsub[x[2]>>24]);
@@ -426,12 +562,33 @@ void AES_ecb_encrypt(amcl_aes *a,uchar *buff)
     }
 }
 
+/* Encrypt a single 16 byte block in ECB mode */
+void AES_ecb_encrypt(const amcl_aes *a,uchar *buff)
+{
+#ifdef AMCL_X86_64
+    if (aesni_supported())
+    {
+        aesni_encrypt(a->fkey,a->Nr,buff,1);
+        return;
+    }
+#endif
+    ecb_encrypt(a->fkey,a->Nr,buff);
+}
+
 /* SU= 80, Decrypt a single 16 byte block in ECB mode */
-void AES_ecb_decrypt(amcl_aes *a,uchar *buff)
+void AES_ecb_decrypt(const amcl_aes *a,uchar *buff)
 {
     int i,j,k;
     unsign32 p[4],q[4],*x,*y,*t;
 
+#ifdef AMCL_X86_64
+    if (aesni_supported())
+    {
+        aesni_decrypt(a,buff,1);
+        return;
+    }
+#endif
+
     for (i=j=0; i<NB; i++,j+=4)
     {
         p[i]=pack((uchar *)&buff[j]);
@@ -640,6 +797,124 @@ unsign32 AES_decrypt(amcl_aes *a,char *buff)
     }
 }
 
+/* Encrypt n 16 byte blocks with an encryption key schedule */
+static void enc_blocks(const unsign32 *fkey,int nr,uchar *buff,int n)
+{
+#ifdef AMCL_X86_64
+    if (aesni_supported())
+    {
+        aesni_encrypt(fkey,nr,buff,n);
+        return;
+    }
+#endif
+    for (; n>0; n--,buff+=16) ecb_encrypt(fkey,nr,buff);
+}
+
+/* Encrypt n 16 byte blocks in ECB mode */
+void AES_ecb_encrypt_blocks(const amcl_aes *a,uchar *buff,int n)
+{
+    enc_blocks(a->fkey,a->Nr,buff,n);
+}
+
+/* Encrypt n 16 byte blocks with an encryption only key schedule */
+void AES_enc_blocks(const amcl_aes_enc *e,uchar *buff,int n)
+{
+    enc_blocks(e->fkey,e->Nr,buff,n);
+}
+
+/* Decrypt n 16 byte blocks in ECB mode */
+static void ecb_decrypt_blocks(const amcl_aes *a,uchar *buff,int n)
+{
+#ifdef AMCL_X86_64
+    if (aesni_supported())
+    {
+        aesni_decrypt(a,buff,n);
+        return;
+    }
+#endif
+    for (; n>0; n--,buff+=16) AES_ecb_decrypt(a,buff);
+}
+
+/* SU= 152, Counter mode encryption of len bytes */
+void AES_ctr_encrypt_bulk(amcl_aes *a,char *out,const char *in,size_t len)
+{
+    size_t i,j,m;
+    char st[16*AES_PIPE];
+
+#ifdef AMCL_X86_64
+    if (aesni_supported())
+    {
+        m=len-len%16;
+        aesni_ctr(a,(uchar *)out,(const uchar *)in,m/16);
+        out+=m;
+        in+=m;
+        len-=m;
+    }
+#endif
+    for (; len>0; len-=m,in+=m,out+=m)
+    {
+        m=(len<16*AES_PIPE)?len:16*AES_PIPE;
+        for (i=0; i<m; i+=16)
+        {
+            for (j=0; j<4*NB; j++) st[i+j]=a->f[j];
+            increment(a->f);
+        }
+        AES_ecb_encrypt_blocks(a,(uchar *)st,(int)((m+15)/16));
+        for (i=0; i<m; i++) out[i]=in[i]^st[i];
+    }
+    for (i=0; i<16*AES_PIPE; i++) st[i]=0;
+}
+
+/* SU= 168, Encrypt n 16 byte blocks in active mode */
+void AES_encrypt_blocks(amcl_aes *a,char *buff,int n)
+{
+    switch (a->mode)
+    {
+    case ECB:
+        AES_ecb_encrypt_blocks(a,(uchar *)buff,n);
+        return;
+    case CTR16:
+        AES_ctr_encrypt_bulk(a,buff,buff,16*(size_t)n);
+        return;
+    default:
+        for (; n>0; n--,buff+=16) AES_encrypt(a,buff);
+        return;
+    }
+}
+
+/* SU= 168, Decrypt n 16 byte blocks in active mode */
+void AES_decrypt_blocks(amcl_aes *a,char *buff,int n)
+{
+    int i,m;
+    char st[16*AES_PIPE+16];
+
+    switch (a->mode)
+    {
+    case ECB:
+        ecb_decrypt_blocks(a,(uchar *)buff,n);
+        return;
+    case CBC:
+        /* decryption of each block only depends on the ciphertext */
+        for (; n>0; n-=m,buff+=16*m)
+        {
+            m=(n<AES_PIPE)?n:AES_PIPE;
+            for (i=0; i<16; i++) st[i]=a->f[i];
+            for (i=0; i<16*m; i++) st[16+i]=buff[i];
+            for (i=0; i<16; i++) a->f[i]=buff[16*(m-1)+i];
+            ecb_decrypt_blocks(a,(uchar *)buff,m);
+            for (i=0; i<16*m; i++) buff[i]^=st[i];
+        }
+        for (i=0; i<16*AES_PIPE+16; i++) st[i]=0;
+        return;
+    case CTR16:
+        AES_ctr_encrypt_bulk(a,buff,buff,16*(size_t)n);
+        return;
+    default:
+        for (; n>0; n--,buff+=16) AES_decrypt(a,buff);
+        return;
+    }
+}
+
 /* Clean up after application of AES */
 void AES_end(amcl_aes *a)
 {
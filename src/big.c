@@ -1040,6 +1040,25 @@ void BIG_mod(BIG b,BIG c)
     }
 }
 
+/* SU= 48, Reduce x mod n in constant time for a given n - x<2^(BASEBITS*NLEN) once normalised, output normalised */
+void BIG_mod_ct(BIG b,BIG c)
+{
+    int k;
+    BIG m,t;
+
+    BIG_norm(b);
+    BIG_copy(m,c);
+    k=BASEBITS*NLEN-BIG_nbits(m);
+    BIG_shl(m,k);
+    for (; k>=0; k--)
+    {
+        BIG_sub(t,b,m);
+        BIG_norm(t);
+        BIG_cmove(b,t,1-(int)((t[NLEN-1]>>(CHUNK-1))&1));
+        BIG_fshr(m,1);
+    }
+}
+
 /* SU= 96, Set a=b mod c, b is destroyed. Slow but rarely used. */
 void BIG_dmod(BIG a,DBIG b,BIG c)
 {
@@ -1209,6 +1228,52 @@ int BIG_lastbits(BIG a,int n)
     return ((int)a[0])&msk;
 }
 
+/* SU= 128, Recode e as width-w NAF, least significant digit first. Returns number of digits */
+int BIG_wnaf(sign8 *naf,BIG e,int w)
+{
+    int n=0,d;
+    BIG t;
+    BIG_copy(t,e);
+    BIG_norm(t);
+    while (!BIG_iszilch(t))
+    {
+        d=0;
+        if (BIG_parity(t))
+        {
+            d=BIG_lastbits(t,w);
+            if (d>=(1<<(w-1))) d-=(1<<w);
+            BIG_dec(t,d);
+            BIG_norm(t);
+        }
+        naf[n++]=(sign8)d;
+        BIG_fshr(t,1);
+    }
+    return n;
+}
+
+/* SU= 128, Recode e into signed c-bit windows, least significant first, digits in range -2^(c-1)+1..2^(c-1).
+   Returns number of digits */
+int BIG_recode(sign8 *d,BIG e,int c)
+{
+    int n=0,v,carry=0;
+    BIG t;
+    BIG_copy(t,e);
+    BIG_norm(t);
+    while (!BIG_iszilch(t) || carry)
+    {
+        v=BIG_lastbits(t,c)+carry;
+        BIG_fshr(t,c);
+        carry=0;
+        if (v>(1<<(c-1)))
+        {
+            v-=(1<<c);
+            carry=1;
+        }
+        d[n++]=(sign8)v;
+    }
+    return n;
+}
+
 /* Create a random 8*MODBYTES size  BIG from a random number generator */
 void BIG_random(BIG m,csprng *rng)
 {
@@ -1337,11 +1402,233 @@ int BIG_jacobi(BIG a,BIG p)
     else return -1;
 }
 
-/* SU= 240, Calculate x=1/y mod n */
+#ifdef dchunk
+
+/* Constant time inversion by Bernstein and Yang's divsteps, see "Fast constant-time gcd computation and modular
+   inversion". Numbers are held as DS_LEN signed digits of DS_BITS bits, the lower digits in [0,2^DS_BITS) and the top
+   digit signed. Batches of DS_BITS divsteps are found from the bottom digits of f and g alone, as a 2x2 matrix with
+   entries of at most 2^DS_BITS, which is then applied to the full f, g and to the coefficients d, e, which are kept in
+   the range (-2p,p). The number of divsteps depends only on the size of the modulus. As arranged by Wuille in
+   libsecp256k1 */
+
+#define DS_BITS (CHUNK-2)                                   /* divsteps in a batch */
+#define DS_MASK (((chunk)1<<DS_BITS)-1)
+#define DS_LEN ((BASEBITS*NLEN+DS_BITS-1)/DS_BITS+1)        /* signed digits */
+
+/* Unpack non-negative normalised BIG a into signed digits x */
+static void ds_frombig(chunk *x,BIG a)
+{
+    int i,k=0,n=0;
+    dchunk t=0;
+    for (i=0; i<NLEN; i++)
+    {
+        t|=(dchunk)a[i]<<n;
+        n+=BASEBITS;
+        while (n>=DS_BITS)
+        {
+            x[k++]=(chunk)(t&DS_MASK);
+            t>>=DS_BITS;
+            n-=DS_BITS;
+        }
+    }
+    for (; k<DS_LEN; k++)
+    {
+        x[k]=(chunk)(t&DS_MASK);
+        t>>=DS_BITS;
+    }
+}
+
+/* Pack non-negative normalised signed digits x into BIG r */
+static void ds_tobig(BIG r,const chunk *x)
+{
+    int i,k=0,n=0;
+    dchunk t=0;
+    for (i=0; i<NLEN; i++)
+    {
+        for (; n<BASEBITS && k<DS_LEN; k++,n+=DS_BITS)
+            t|=(dchunk)x[k]<<n;
+        r[i]=(chunk)(t&BMASK);
+        t>>=BASEBITS;
+        n-=BASEBITS;
+    }
+}
+
+/* Propagate carries, leaving the top digit signed */
+static void ds_norm(chunk *x)
+{
+    int i;
+    chunk c=0;
+    for (i=0; i<DS_LEN-1; i++)
+    {
+        c+=x[i];
+        x[i]=c&DS_MASK;
+        c>>=DS_BITS;
+    }
+    x[DS_LEN-1]+=c;
+}
+
+/* x+=p if mask is all ones, else x unchanged */
+static void ds_cadd(chunk *x,const chunk *p,chunk mask)
+{
+    int i;
+    for (i=0; i<DS_LEN; i++) x[i]+=p[i]&mask;
+    ds_norm(x);
+}
+
+/* DS_BITS divsteps on the bottom digits f,g of odd f and g, starting from delta. On exit t is the transition matrix
+   scaled by 2^DS_BITS. Returns the new delta */
+static chunk ds_divsteps(chunk delta,chunk f,chunk g,chunk *t)
+{
+    int i;
+    chunk u=1,v=0,q=0,r=1,c,odd,h,nf;
+
+    for (i=0; i<DS_BITS; i++)
+    {
+        odd=-(g&1);
+        c=((-delta)>>(CHUNK-1))&odd;  /* delta>0 and g odd, swap */
+
+        delta=1+((delta^c)-c);
+
+        nf=f^((f^g)&c);
+        h=(f^c)-c;
+        g=(g+(h&odd))>>1;
+        f=nf;
+
+        nf=u^((u^q)&c);
+        h=(u^c)-c;
+        q+=h&odd;
+        u=nf+nf;
+
+        nf=v^((v^r)&c);
+        h=(v^c)-c;
+        r+=h&odd;
+        v=nf+nf;
+    }
+    t[0]=u;
+    t[1]=v;
+    t[2]=q;
+    t[3]=r;
+    return delta;
+}
+
+/* (f,g)=t.(f,g)/2^DS_BITS, exactly */
+static void ds_update_fg(chunk *f,chunk *g,const chunk *t)
+{
+    int i;
+    dchunk cf,cg;
+
+    cf=(dchunk)t[0]*f[0]+(dchunk)t[1]*g[0];
+    cg=(dchunk)t[2]*f[0]+(dchunk)t[3]*g[0];
+    cf>>=DS_BITS;
+    cg>>=DS_BITS;
+    for (i=1; i<DS_LEN; i++)
+    {
+        cf+=(dchunk)t[0]*f[i]+(dchunk)t[1]*g[i];
+        cg+=(dchunk)t[2]*f[i]+(dchunk)t[3]*g[i];
+        f[i-1]=(chunk)(cf&DS_MASK);
+        g[i-1]=(chunk)(cg&DS_MASK);
+        cf>>=DS_BITS;
+        cg>>=DS_BITS;
+    }
+    f[DS_LEN-1]=(chunk)cf;
+    g[DS_LEN-1]=(chunk)cg;
+}
+
+/* (d,e)=t.(d,e)/2^DS_BITS mod p, pinv=1/p mod 2^DS_BITS. d and e stay in (-2p,p) */
+static void ds_update_de(chunk *d,chunk *e,const chunk *t,const chunk *p,chunk pinv)
+{
+    int i;
+    chunk sd=d[DS_LEN-1]>>(CHUNK-1);
+    chunk se=e[DS_LEN-1]>>(CHUNK-1);
+    dchunk md,me,cd,ce;
+
+    /* add multiples of p to keep in range, and to clear the bottom digits */
+    md=(dchunk)(t[0]&sd)+(t[1]&se);
+    me=(dchunk)(t[2]&sd)+(t[3]&se);
+    cd=(dchunk)t[0]*d[0]+(dchunk)t[1]*e[0];
+    ce=(dchunk)t[2]*d[0]+(dchunk)t[3]*e[0];
+    md-=(((dchunk)pinv*(cd&DS_MASK))+md)&DS_MASK;
+    me-=(((dchunk)pinv*(ce&DS_MASK))+me)&DS_MASK;
+
+    cd+=md*p[0];
+    ce+=me*p[0];
+    cd>>=DS_BITS;
+    ce>>=DS_BITS;
+    for (i=1; i<DS_LEN; i++)
+    {
+        cd+=(dchunk)t[0]*d[i]+(dchunk)t[1]*e[i]+md*p[i];
+        ce+=(dchunk)t[2]*d[i]+(dchunk)t[3]*e[i]+me*p[i];
+        d[i-1]=(chunk)(cd&DS_MASK);
+        e[i-1]=(chunk)(ce&DS_MASK);
+        cd>>=DS_BITS;
+        ce>>=DS_BITS;
+    }
+    d[DS_LEN-1]=(chunk)cd;
+    e[DS_LEN-1]=(chunk)ce;
+}
+
+/* SU= 64+8*CHUNK*DS_LEN, Calculate x=1/y mod n, n odd, in constant time for a given n. y<2^(BASEBITS*NLEN) once
+   normalised. x=0 if y=0 mod n, undefined for other y not coprime to n */
+void BIG_invmodp(BIG r,BIG a,BIG p)
+{
+    int i,k,nb;
+    chunk f[DS_LEN],g[DS_LEN],d[DS_LEN],e[DS_LEN],pd[DS_LEN],y[DS_LEN],t[4];
+    chunk delta=1,pinv,mask;
+    dchunk z;
+    BIG m;
+
+    BIG_mod_ct(a,p);
+    BIG_copy(m,p);
+    BIG_norm(m);
+    ds_frombig(pd,m);
+    ds_frombig(f,m);
+    ds_frombig(g,a);
+    for (i=0; i<DS_LEN; i++) d[i]=e[i]=0;
+    e[0]=1;
+
+    /* 1/p mod 2^DS_BITS by Newton's method, correct to 3 bits to start */
+    z=pd[0];
+    for (i=0; i<5; i++) z=(z*((2-(dchunk)pd[0]*z)&DS_MASK))&DS_MASK;
+    pinv=(chunk)z;
+
+    /* enough divsteps for g to reach zero, for a modulus of nb bits */
+    nb=BIG_nbits(m);
+    k=(49*nb+(nb<46?80:57))/17;
+    for (i=0; i<k; i+=DS_BITS)
+    {
+        delta=ds_divsteps(delta,f[0],g[0],t);
+        ds_update_fg(f,g,t);
+        ds_update_de(d,e,t,pd,pinv);
+    }
+
+    /* f=+/-1 and d=f/y, now in (-2p,p). Reduce to [0,p) */
+    mask=f[DS_LEN-1]>>(CHUNK-1);
+    for (i=0; i<DS_LEN; i++) d[i]=(d[i]^mask)-mask;
+    ds_norm(d);
+    ds_cadd(d,pd,d[DS_LEN-1]>>(CHUNK-1));
+    ds_cadd(d,pd,d[DS_LEN-1]>>(CHUNK-1));
+    for (k=0; k<2; k++)
+    {
+        for (i=0; i<DS_LEN; i++) y[i]=d[i]-pd[i];
+        ds_norm(y);
+        mask=~(y[DS_LEN-1]>>(CHUNK-1));
+        for (i=0; i<DS_LEN; i++) d[i]^=(d[i]^y[i])&mask;
+    }
+    ds_tobig(r,d);
+}
+
+#else
+
+/* SU= 240, Calculate x=1/y mod n, binary method. x=0 if y=0 mod n, undefined for other y not coprime to n */
 void BIG_invmodp(BIG r,BIG a,BIG p)
 {
     BIG u,v,x1,x2,t,one;
     BIG_mod(a,p);
+    if (BIG_iszilch(a))
+    {
+        BIG_zero(r);
+        return;
+    }
     BIG_copy(u,a);
     BIG_copy(v,p);
     BIG_one(one);
@@ -1401,6 +1688,8 @@ void BIG_invmodp(BIG r,BIG a,BIG p)
         BIG_copy(r,x2);
 }
 
+#endif
+
 /* Calculate x=x mod 2^m  */
 void BIG_mod2m(BIG x,int m)
 {
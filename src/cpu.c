@@ -0,0 +1,180 @@
+/**
+ * @file cpu.c
+ * @date 17th October 2026
+ * @brief Processor features used to choose between implementations
+ *
+ * LICENSE
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*
+ * The field multiplication, AES, GHASH and SHA-256 code each have portable C and x86-64 extension
+ * implementations. The extensions are detected here once, when the library is loaded, and may be
+ * restricted by the AMCL_CPU environment variable, so that one binary can be run on any processor
+ * and each implementation can be benchmarked on the same machine.
+ */
+
+#include <string.h>
+#include "arch.h"
+#include "amcl.h"
+
+#ifdef AMCL_X86_64
+
+static int cpu_use=0;
+static int cpu_done=0;
+
+/* Feature names accepted in AMCL_CPU */
+static const struct
+{
+    const char *name;
+    int f;
+} cpu_names[]=
+{
+    {"bmi2",CPU_BMI2},
+    {"adx",CPU_ADX},
+    {"avx2",CPU_AVX2},
+    {"sha",CPU_SHA},
+    {"aes",CPU_AES},
+    {"pclmul",CPU_PCLMUL},
+    {"avx512ifma",CPU_AVX512IFMA}
+};
+
+/* Features of this processor, including the SSE levels the extension code also needs */
+static int cpu_detect(void)
+{
+    int f=0;
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("bmi2")) f|=CPU_BMI2;
+    if (__builtin_cpu_supports("adx")) f|=CPU_ADX;
+    if (__builtin_cpu_supports("avx2")) f|=CPU_AVX2;
+    if (__builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1")) f|=CPU_SHA;
+    if (__builtin_cpu_supports("aes") && __builtin_cpu_supports("sse2")) f|=CPU_AES;
+    if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3")) f|=CPU_PCLMUL;
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512ifma")) f|=CPU_AVX512IFMA;
+    return f;
+}
+
+/* Restrict features f by a list of names separated by commas or spaces. Named features only are
+   used, or all but those prefixed by - if none are named without. Unknown names select no feature,
+   but without - they still count as named, so "portable" leaves none */
+static int cpu_parse(const char *s,int f)
+{
+    int i,n,neg,pass,use=f;
+    const char *t;
+
+    for (pass=0; pass<2; pass++)
+    {
+        for (t=s; *t; t+=n)
+        {
+            if (*t==',' || *t==' ')
+            {
+                n=1;
+                continue;
+            }
+            neg=(*t=='-');
+            t+=neg;
+            for (n=0; t[n] && t[n]!=',' && t[n]!=' '; n++);
+            if (pass==0)
+            {
+                if (!neg) use=0;
+                continue;
+            }
+            for (i=0; i<(int)(sizeof(cpu_names)/sizeof(cpu_names[0])); i++)
+            {
+                if ((int)strlen(cpu_names[i].name)!=n || strncmp(t,cpu_names[i].name,n)!=0) continue;
+                if (neg) use&=~cpu_names[i].f;
+                else use|=cpu_names[i].f;
+            }
+        }
+    }
+    return use&f;
+}
+
+/* Detect features when the library is loaded, or on first use if that is earlier */
+__attribute__((constructor)) static void cpu_init(void)
+{
+    int f=cpu_detect();
+    const char *s=getenv("AMCL_CPU");
+    if (s!=NULL) f=cpu_parse(s,f);
+    __atomic_store_n(&cpu_use,f,__ATOMIC_RELAXED);
+    __atomic_store_n(&cpu_done,1,__ATOMIC_RELEASE);
+}
+
+/* Features that may be used */
+int CPU_features(void)
+{
+    if (!__atomic_load_n(&cpu_done,__ATOMIC_ACQUIRE)) cpu_init();
+    return __atomic_load_n(&cpu_use,__ATOMIC_RELAXED);
+}
+
+#else
+
+/* Features that may be used */
+int CPU_features(void)
+{
+    return 0;
+}
+
+#endif
+
+/* 1 if all features f may be used */
+int CPU_has(int f)
+{
+    return (CPU_features()&f)==f;
+}
+
+/* Name of implementation chosen for kernel k */
+const char *CPU_backend(int k)
+{
+    switch (k)
+    {
+    case CPU_KERNEL_FP:
+#ifdef AMCL_SATURATED
+        if (CPU_has(CPU_BMI2|CPU_ADX)) return "mulx-adx";
+#endif
+        return "portable";
+    case CPU_KERNEL_AES:
+#ifdef AMCL_X86_64
+        if (CPU_has(CPU_AES)) return "aes-ni";
+#endif
+        return "portable";
+    case CPU_KERNEL_GHASH:
+#ifdef AMCL_X86_64
+        if (CPU_has(CPU_PCLMUL)) return "pclmul";
+#endif
+        return "portable";
+    case CPU_KERNEL_SHA256:
+        switch (HASH256_backend())
+        {
+        case HASH256_AVX2:
+            return "avx2";
+        case HASH256_SHANI:
+            return "sha-ni";
+        default:
+            return "portable";
+        }
+    case CPU_KERNEL_FP_X8:
+#ifdef AMCL_IFMA
+        if (CPU_has(CPU_AVX512IFMA)) return "avx512ifma";
+#endif
+        return "portable";
+    default:
+        return NULL;
+    }
+}
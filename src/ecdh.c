@@ -39,7 +39,8 @@
 /* pad or truncate ouput to length pad if pad!=0 */
 static void hashit(int sha,octet *p,int n,octet *x,octet *w,int pad)
 {
-    int i,c[4],hlen;
+    int hlen;
+    char c[4];
     hash256 sha256;
     hash512 sha512;
     char hh[64];
@@ -59,58 +60,52 @@ static void hashit(int sha,octet *p,int n,octet *x,octet *w,int pad)
 
     hlen=sha;
 
-    for (i=0; i<p->len; i++)
+    switch(sha)
     {
+    case SHA256:
+        HASH256_update(&sha256,p->val,p->len);
+        break;
+    case SHA384:
+        HASH384_update(&sha512,p->val,p->len);
+        break;
+    case SHA512:
+        HASH512_update(&sha512,p->val,p->len);
+        break;
+    }
+    if (n>0)
+    {
+        c[0]=(n>>24)&0xff;
+        c[1]=(n>>16)&0xff;
+        c[2]=(n>>8)&0xff;
+        c[3]=(n)&0xff;
         switch(sha)
         {
         case SHA256:
-            HASH256_process(&sha256,p->val[i]);
+            HASH256_update(&sha256,c,4);
             break;
         case SHA384:
-            HASH384_process(&sha512,p->val[i]);
+            HASH384_update(&sha512,c,4);
             break;
         case SHA512:
-            HASH512_process(&sha512,p->val[i]);
+            HASH512_update(&sha512,c,4);
             break;
         }
     }
-    if (n>0)
+    if (x!=NULL)
     {
-        c[0]=(n>>24)&0xff;
-        c[1]=(n>>16)&0xff;
-        c[2]=(n>>8)&0xff;
-        c[3]=(n)&0xff;
-        for (i=0; i<4; i++)
+        switch(sha)
         {
-            switch(sha)
-            {
-            case SHA256:
-                HASH256_process(&sha256,c[i]);
-                break;
-            case SHA384:
-                HASH384_process(&sha512,c[i]);
-                break;
-            case SHA512:
-                HASH512_process(&sha512,c[i]);
-                break;
-            }
+        case SHA256:
+            HASH256_update(&sha256,x->val,x->len);
+            break;
+        case SHA384:
+            HASH384_update(&sha512,x->val,x->len);
+            break;
+        case SHA512:
+            HASH512_update(&sha512,x->val,x->len);
+            break;
         }
     }
-    if (x!=NULL) for (i=0; i<x->len; i++)
-        {
-            switch(sha)
-            {
-            case SHA256:
-                HASH256_process(&sha256,x->val[i]);
-                break;
-            case SHA384:
-                HASH384_process(&sha512,x->val[i]);
-                break;
-            case SHA512:
-                HASH512_process(&sha512,x->val[i]);
-                break;
-            }
-        }
 
     switch (sha)
     {
@@ -160,42 +155,145 @@ void ECC_KILL_CSPRNG(csprng *RNG)
     RAND_clean(RNG);
 }
 
-/* Calculate HMAC of message M using key K to create tag of length len in octet tag */
+/* SU= 2300, Calculate HMAC of message M using key K to create tag of length len in octet tag */
 int HMAC(int sha,octet *m,octet *k,int olen,octet *tag)
 {
     /* Input is from an octet m        *
      * olen is requested output length in bytes. k is the key  *
      * The output is the calculated tag */
-    int hlen,b;
-    char h[128],k0[128];
-    octet H= {0,sizeof(h),h};
+    int r;
+    hmac_ctx C;
+
+    if (!HMAC_init(&C,sha,k)) return 0;
+    r=HMAC_ctx(&C,m,olen,tag);
+    HMAC_end(&C);
+    return r;
+}
+
+/* Start hash of either size */
+static void hash_init(int sha,hash256 *s256,hash512 *s512)
+{
+    switch (sha)
+    {
+    case SHA256:
+        HASH256_init(s256);
+        break;
+    case SHA384:
+        HASH384_init(s512);
+        break;
+    case SHA512:
+        HASH512_init(s512);
+        break;
+    }
+}
+
+/* Add bytes to hash of either size */
+static void hash_update(int sha,hash256 *s256,hash512 *s512,const char *b,size_t len)
+{
+    switch (sha)
+    {
+    case SHA256:
+        HASH256_update(s256,b,len);
+        break;
+    case SHA384:
+        HASH384_update(s512,b,len);
+        break;
+    case SHA512:
+        HASH512_update(s512,b,len);
+        break;
+    }
+}
+
+/* Finish hash of either size */
+static void hash_final(int sha,hash256 *s256,hash512 *s512,char *h)
+{
+    switch (sha)
+    {
+    case SHA256:
+        HASH256_hash(s256,h);
+        break;
+    case SHA384:
+        HASH384_hash(s512,h);
+        break;
+    case SHA512:
+        HASH512_hash(s512,h);
+        break;
+    }
+}
+
+/* SU= 200, Set up HMAC key, absorbing the padded key blocks */
+int HMAC_init(hmac_ctx *C,int sha,octet *k)
+{
+    int i,b;
+    char k0[128];
     octet K0= {0,sizeof(k0),k0};
 
-    hlen=sha;
-    if (hlen>32) b=128;
+    if (sha!=SHA256 && sha!=SHA384 && sha!=SHA512) return 0;
+    C->sha=sha;
+    if (sha>32) b=128;
     else b=64;
 
-    if (olen<4 /*|| olen>hlen*/) return 0;
-
     if (k->len > b) hashit(sha,k,-1,NULL,&K0,0);
     else            OCT_copy(&K0,k);
 
     OCT_jbyte(&K0,0,b-K0.len);
 
     OCT_xorbyte(&K0,0x36);
-
-    hashit(sha,&K0,-1,m,&H,0);
+    hash_init(sha,&(C->i.h256),&(C->i.h512));
+    hash_update(sha,&(C->i.h256),&(C->i.h512),K0.val,b);
 
     OCT_xorbyte(&K0,0x6a);   /* 0x6a = 0x36 ^ 0x5c */
-    hashit(sha,&K0,-1,&H,&H,olen);
+    hash_init(sha,&(C->o.h256),&(C->o.h512));
+    hash_update(sha,&(C->o.h256),&(C->o.h512),K0.val,b);
 
-    OCT_empty(tag);
+    for (i=0; i<b; i++) k0[i]=0;
 
-    OCT_jbytes(tag,H.val,olen);
+    C->s=C->i;
+    return 1;
+}
+
+/* Add part of message to HMAC */
+void HMAC_update(hmac_ctx *C,const char *m,size_t len)
+{
+    hash_update(C->sha,&(C->s.h256),&(C->s.h512),m,len);
+}
 
+/* Finish HMAC of message, and start the next */
+int HMAC_final(hmac_ctx *C,int olen,octet *tag)
+{
+    int i,hlen=C->sha;
+    char h[128];
+
+    if (olen<4 || olen>128) return 0;
+
+    hash_final(C->sha,&(C->s.h256),&(C->s.h512),h);
+    C->s=C->o;
+    hash_update(C->sha,&(C->s.h256),&(C->s.h512),h,hlen);
+    hash_final(C->sha,&(C->s.h256),&(C->s.h512),h);
+    C->s=C->i;
+
+    /* pad or truncate to olen */
+    for (i=hlen; i<olen; i++) h[i]=0;
+    OCT_empty(tag);
+    OCT_jbytes(tag,h,olen);
     return 1;
 }
 
+/* Calculate HMAC of message M using HMAC key */
+int HMAC_ctx(hmac_ctx *C,octet *m,int olen,octet *tag)
+{
+    HMAC_update(C,m->val,m->len);
+    return HMAC_final(C,olen,tag);
+}
+
+/* Clean up HMAC key */
+void HMAC_end(hmac_ctx *C)
+{
+    size_t i;
+    char *b=(char *)C;
+    for (i=0; i<sizeof(hmac_ctx); i++) b[i]=0;
+}
+
 /* Key Derivation Functions */
 /* Input octet z */
 /* Output key of length olen */
@@ -220,56 +318,157 @@ void KDF1(octet *z,int olen,octet *key)
 }
 */
 
-/* Key Derivation Function - generates key K from inputs Z and P */
+/* SU= 1200, Key Derivation Function - generates key K from inputs Z and P */
 void KDF2(int sha,octet *z,octet *p,int olen,octet *key)
 {
     /* NOTE: the parameter olen is the length of the output k in bytes */
-    char h[64];
-    octet H= {0,sizeof(h),h};
+    char h[64],c[4];
     int counter,cthreshold;
     int hlen=sha;
+    hash256 z256,s256;
+    hash512 z512,s512;
 
     OCT_empty(key);
 
+    /* state after z is the same for every counter */
+    hash_init(sha,&z256,&z512);
+    hash_update(sha,&z256,&z512,z->val,z->len);
+
     cthreshold=ROUNDUP(olen,hlen);
 
     for (counter=1; counter<=cthreshold; counter++)
     {
-        hashit(sha,z,counter,p,&H,0);
-        if (key->len+hlen>olen)  OCT_jbytes(key,H.val,olen%hlen);
-        else                     OCT_joctet(key,&H);
+        s256=z256;
+        s512=z512;
+        c[0]=(counter>>24)&0xff;
+        c[1]=(counter>>16)&0xff;
+        c[2]=(counter>>8)&0xff;
+        c[3]=(counter)&0xff;
+        hash_update(sha,&s256,&s512,c,4);
+        if (p!=NULL) hash_update(sha,&s256,&s512,p->val,p->len);
+        hash_final(sha,&s256,&s512,h);
+        if (key->len+hlen>olen)  OCT_jbytes(key,h,olen%hlen);
+        else                     OCT_jbytes(key,h,hlen);
     }
-
 }
 
-/* Password Based Key Derivation Function - generates key K from password, salt and repeat counter */
-void PBKDF2(int sha,octet *p,octet *s,int rep,int olen,octet *key)
+/* SU= 850, HMAC tags of n messages of len bytes, each with its own key, hashed in vector lanes where available */
+static void hmac_multi(int n,hmac_ctx *C[],char *m[],size_t len,char *tag[])
 {
-    int i,j,len,d=ROUNDUP(olen,sha);
-    char f[EFS],u[EFS];
-    octet F= {0,sizeof(f),f};
-    octet U= {0,sizeof(u),u};
-    OCT_empty(key);
+    int j,sha=C[0]->sha;
+    const hash256 *s256[PBKDF2_LANES];
+    const hash512 *s512[PBKDF2_LANES];
+    size_t l[PBKDF2_LANES],hl[PBKDF2_LANES];
+    char t[PBKDF2_LANES][64],*pt[PBKDF2_LANES];
 
-    for (i=1; i<=d; i++)
+    for (j=0; j<n; j++)
     {
-        len=s->len;
-        OCT_jint(s,i,4);
+        l[j]=len;
+        hl[j]=sha;
+        pt[j]=t[j];
+    }
+    if (sha==SHA256)
+    {
+        for (j=0; j<n; j++) s256[j]=&(C[j]->i.h256);
+        HASH256_multi_final(n,s256,(const char **)m,l,pt);
+        for (j=0; j<n; j++) s256[j]=&(C[j]->o.h256);
+        HASH256_multi_final(n,s256,(const char **)pt,hl,tag);
+        return;
+    }
+    for (j=0; j<n; j++) s512[j]=&(C[j]->i.h512);
+    if (sha==SHA384) HASH384_multi_final(n,s512,(const char **)m,l,pt);
+    else             HASH512_multi_final(n,s512,(const char **)m,l,pt);
+    for (j=0; j<n; j++) s512[j]=&(C[j]->o.h512);
+    if (sha==SHA384) HASH384_multi_final(n,s512,(const char **)pt,hl,tag);
+    else             HASH512_multi_final(n,s512,(const char **)pt,hl,tag);
+}
+
+/* SU= 1000, PBKDF2 blocks F[j] of n<=PBKDF2_LANES jobs, each with HMAC key C[j], salt S[j] and block index b[j].
+   The iterations of all jobs go through the HMAC together */
+static void pbkdf2_blocks(int n,hmac_ctx *C[],octet *S[],const int b[],int rep,char *F[])
+{
+    int i,j,k,sha=C[0]->sha;
+    char u[PBKDF2_LANES][EFS+64],*pu[PBKDF2_LANES],c[4];
+    octet U= {0,sizeof(u[0]),NULL};
 
-        HMAC(sha,s,p,EFS,&F);
+    for (j=0; j<n; j++)
+    {
+        c[0]=(b[j]>>24)&0xff;
+        c[1]=(b[j]>>16)&0xff;
+        c[2]=(b[j]>>8)&0xff;
+        c[3]=(b[j])&0xff;
+        U.val=u[j];
+        HMAC_update(C[j],S[j]->val,S[j]->len);
+        HMAC_update(C[j],c,4);
+        HMAC_final(C[j],EFS,&U);
+        for (i=0; i<EFS; i++) F[j][i]=u[j][i];
+        pu[j]=u[j];
+    }
 
-        s->len=len;
-        OCT_copy(&U,&F);
-        for (j=2; j<=rep; j++)
+    for (k=2; k<=rep; k++)
+    {
+        /* U is the tag truncated or zero padded to EFS bytes */
+        hmac_multi(n,C,pu,EFS,pu);
+        for (j=0; j<n; j++)
         {
-            HMAC(sha,&U,p,EFS,&U);
-            OCT_xor(&F,&U);
+            for (i=sha; i<EFS; i++) u[j][i]=0;
+            for (i=0; i<EFS; i++) F[j][i]^=u[j][i];
         }
+    }
+}
+
+/* SU= 700, PBKDF2 for n passwords and salts. The output blocks of all the keys are shared out among the hash
+   lanes, and H has room for the HMAC keys of min(n,PBKDF2_LANES) passwords */
+static void pbkdf2_keys(int sha,int n,octet *p[],octet *s[],int rep,int olen,octet *key[],hmac_ctx H[])
+{
+    int i,j,k,m,t,d=ROUNDUP(olen,sha);
+    int b[PBKDF2_LANES],w[PBKDF2_LANES];
+    char f[PBKDF2_LANES][EFS],*pf[PBKDF2_LANES];
+    hmac_ctx *C[PBKDF2_LANES];
+    octet *S[PBKDF2_LANES];
 
-        OCT_joctet(key,&F);
+    for (i=0; i<n; i++) OCT_empty(key[i]);
+    if (sha!=SHA256 && sha!=SHA384 && sha!=SHA512) return;
+
+    for (k=0; k<PBKDF2_LANES; k++) pf[k]=f[k];
+
+    /* jobs are taken in order of key, then block, so blocks are appended in order */
+    m=k=0;
+    for (i=0; i<n; i++)
+    {
+        for (j=1; j<=d; j++)
+        {
+            if (k==0 || w[k-1]!=i) HMAC_init(&H[m++],sha,p[i]);
+            C[k]=&H[m-1];
+            S[k]=s[i];
+            b[k]=j;
+            w[k++]=i;
+            if (k==PBKDF2_LANES || (i==n-1 && j==d))
+            {
+                pbkdf2_blocks(k,C,S,b,rep,pf);
+                for (t=0; t<k; t++) OCT_jbytes(key[w[t]],f[t],EFS);
+                for (t=0; t<m; t++) HMAC_end(&H[t]);
+                m=k=0;
+            }
+        }
     }
+    for (t=0; t<EFS*PBKDF2_LANES; t++) f[t/EFS][t%EFS]=0;
 
-    OCT_chop(key,NULL,olen);
+    for (i=0; i<n; i++) OCT_chop(key[i],NULL,olen);
+}
+
+/* SU= 2300, Password Based Key Derivation Function - generates key K from password, salt and repeat counter */
+void PBKDF2(int sha,octet *p,octet *s,int rep,int olen,octet *key)
+{
+    hmac_ctx H;
+    pbkdf2_keys(sha,1,&p,&s,rep,olen,&key,&H);
+}
+
+/* SU= 17600, Password Based Key Derivation Function for n passwords and salts */
+void PBKDF2_batch(int sha,int n,octet *p[],octet *s[],int rep,int olen,octet *key[])
+{
+    hmac_ctx H[PBKDF2_LANES];
+    pbkdf2_keys(sha,n,p,s,rep,olen,key,H);
 }
 
 /* AES encryption/decryption. Encrypt byte array M using key K and returns ciphertext */
@@ -374,14 +573,8 @@ int ECP_KEY_PAIR_GENERATE(csprng *RNG,octet* S,octet *W)
     BIG r,gx,s;
     ECP G;
     int res=0;
-    BIG_rcopy(gx,CURVE_Gx);
-
 #if CURVETYPE!=MONTGOMERY
     BIG gy;
-    BIG_rcopy(gy,CURVE_Gy);
-    ECP_set(&G,gx,gy);
-#else
-    ECP_set(&G,gx);
 #endif
 
     BIG_rcopy(r,CURVE_Order);
@@ -400,7 +593,7 @@ int ECP_KEY_PAIR_GENERATE(csprng *RNG,octet* S,octet *W)
 //	BIG_toBytes(S->val,s);
 #endif
 
-    ECP_mul(&G,s);
+    ECP_mul_gen(&G,s);
 #if CURVETYPE!=MONTGOMERY
     ECP_get(gx,gy,&G);
 #else
@@ -550,12 +743,10 @@ int ECPSP_DSA(int sha,csprng *RNG,octet *K,octet *S,octet *F,octet *C,octet *D)
     char h[128];
     octet H= {0,sizeof(h),h};
 
-    BIG gx,gy,r,s,f,c,d,u,vx;
-    ECP G,V;
+    BIG r,s,f,c,d,u,vx;
+    ECP V;
 
     hashit(sha,F,-1,NULL,&H,sha);
-    BIG_rcopy(gx,CURVE_Gx);
-    BIG_rcopy(gy,CURVE_Gy);
     BIG_rcopy(r,CURVE_Order);
 
     BIG_fromBytes(s,S->val);
@@ -564,8 +755,6 @@ int ECPSP_DSA(int sha,csprng *RNG,octet *K,octet *S,octet *F,octet *C,octet *D)
     if (H.len>MODBYTES) hlen=MODBYTES;
     BIG_fromBytesLen(f,H.val,hlen);
 
-    ECP_set(&G,gx,gy);
-
     do
     {
         if (RNG!=NULL)
@@ -587,8 +776,7 @@ int ECPSP_DSA(int sha,csprng *RNG,octet *K,octet *S,octet *F,octet *C,octet *D)
 #ifdef AES_S
         BIG_mod2m(u,2*AES_S);
 #endif
-        ECP_copy(&V,&G);
-        ECP_mul(&V,u);
+        ECP_mul_gen(&V,u);
 
         ECP_get(vx,vx,&V);
 
@@ -620,14 +808,12 @@ int ECPVP_DSA(int sha,octet *W,octet *F, octet *C,octet *D)
     char h[128];
     octet H= {0,sizeof(h),h};
 
-    BIG r,gx,gy,wx,wy,f,c,d,h2;
+    BIG r,wx,wy,f,c,d,h2;
     int res=0;
-    ECP G,WP;
+    ECP WP;
     int valid;
 
     hashit(sha,F,-1,NULL,&H,sha);
-    BIG_rcopy(gx,CURVE_Gx);
-    BIG_rcopy(gy,CURVE_Gy);
     BIG_rcopy(r,CURVE_Order);
 
     OCT_shl(C,C->len-MODBYTES);
@@ -650,8 +836,6 @@ int ECPVP_DSA(int sha,octet *W,octet *F, octet *C,octet *D)
         BIG_modmul(f,f,d,r);
         BIG_modmul(h2,c,d,r);
 
-        ECP_set(&G,gx,gy);
-
         BIG_fromBytes(wx,&(W->val[1]));
         BIG_fromBytes(wy,&(W->val[EFS+1]));
 
@@ -660,7 +844,7 @@ int ECPVP_DSA(int sha,octet *W,octet *F, octet *C,octet *D)
         if (!valid) res=ECDH_ERROR;
         else
         {
-            ECP_mul2(&WP,&G,h2,f);
+            ECP_mul2_vartime(&WP,NULL,h2,f);
 
             if (ECP_isinf(&WP)) res=ECDH_INVALID;
             else
@@ -675,11 +859,175 @@ int ECPVP_DSA(int sha,octet *W,octet *F, octet *C,octet *D)
     return res;
 }
 
+/* Every point on these curves is in the group of order r. On other curves the multiplier rho of a signature could
+   cancel a small order part of W or R, so the batch could pass a signature that ECPVP_DSA rejects */
+#if CURVETYPE==WEIERSTRASS && CHOICE<BLS_CURVES
+#define ECDSA_PRIME_ORDER
+#endif
+
+/* Signature prepared for batch verification */
+typedef struct
+{
+    BIG u1;   /* f/d */
+    BIG u2;   /* c/d */
+    BIG rho;  /* random multiplier */
+    ECP W;    /* public key */
+    ECP R;    /* R point recovered from c and its y parity */
+} ecdsa_item;
+
+/* Recover R and public key of a signature with a y-parity hint, and add it to the batch seed. Returns 1 if it can be batched */
+static int ecdsa_prepare(int sha,octet *W,octet *F,octet *C,octet *D,ecdsa_item *I,hash256 *seed)
+{
+    char h[128];
+    octet H= {0,sizeof(h),h};
+    BIG r,m,wx,wy,f,c,d;
+    int hlen;
+
+#ifndef ECDSA_PRIME_ORDER
+    return 0;
+#endif
+    if (C->len!=EGS+1 || (C->val[0]!=0x02 && C->val[0]!=0x03)) return 0;
+    if (D->len!=EGS || W->len!=2*EFS+1) return 0;
+
+    BIG_rcopy(r,CURVE_Order);
+    BIG_rcopy(m,Modulus);
+    BIG_fromBytes(c,&(C->val[1]));
+    BIG_fromBytes(d,D->val);
+    if (BIG_iszilch(c) || BIG_comp(c,r)>=0 || BIG_comp(c,m)>=0 || BIG_iszilch(d) || BIG_comp(d,r)>=0)
+        return 0;
+
+    BIG_fromBytes(wx,&(W->val[1]));
+    BIG_fromBytes(wy,&(W->val[EFS+1]));
+    if (!ECP_set(&(I->W),wx,wy)) return 0;
+    if (!ECP_setx(&(I->R),c,C->val[0]&1)) return 0;
+
+    hashit(sha,F,-1,NULL,&H,sha);
+    hlen=H.len;
+    if (hlen>MODBYTES) hlen=MODBYTES;
+    BIG_fromBytesLen(f,H.val,hlen);
+
+    BIG_invmodp(d,d,r);
+    BIG_modmul(I->u1,f,d,r);
+    BIG_modmul(I->u2,c,d,r);
+
+    HASH256_update(seed,W->val,W->len);
+    HASH256_update(seed,C->val,C->len);
+    HASH256_update(seed,D->val,D->len);
+    HASH256_update(seed,H.val,H.len);
+    return 1;
+}
+
+/* Single verification, without changing the caller's signature octets */
+static int ecdsa_single(int sha,octet *W,octet *F,octet *C,octet *D)
+{
+    octet CV= {EGS,EGS,NULL};
+    octet DV= {EGS,EGS,NULL};
+    if (C->len>EGS) CV.val=&(C->val[C->len-EGS]);
+    else CV=*C;
+    if (D->len>EGS) DV.val=&(D->val[D->len-EGS]);
+    else DV=*D;
+    return ECPVP_DSA(sha,W,F,&CV,&DV);
+}
+
+/* Check that sum rho.(u1.G+u2.W-R) vanishes over the k signatures I[idx[]] */
+static int ecdsa_batch_check(int k,int idx[],ecdsa_item I[])
+{
+    int i,j,m=0;
+    BIG r,t,gx,gy,e[2*ECDH_BATCH+1];
+    ECP X[2*ECDH_BATCH+1],T;
+
+    BIG_rcopy(r,CURVE_Order);
+    BIG_zero(e[2*k]);
+    for (i=0; i<k; i++)
+    {
+        j=idx[i];
+        BIG_modmul(t,I[j].rho,I[j].u1,r);
+        BIG_add(e[2*k],e[2*k],t);
+        BIG_norm(e[2*k]);
+        BIG_mod(e[2*k],r);
+
+        ECP_copy(&X[m],&(I[j].W));
+        BIG_modmul(e[m],I[j].rho,I[j].u2,r);
+        m++;
+        ECP_copy(&X[m],&(I[j].R));
+        ECP_neg(&X[m]);
+        BIG_copy(e[m],I[j].rho);
+        m++;
+    }
+    BIG_rcopy(gx,CURVE_Gx);
+    BIG_rcopy(gy,CURVE_Gy);
+    ECP_set(&X[m],gx,gy);
+    m++;
+
+    ECP_muln(&T,m,X,e);
+    return ECP_isinf(&T);
+}
+
+/* Verify k signatures together, bisecting to find the bad ones */
+static void ecdsa_batch_split(int sha,int k,int idx[],ecdsa_item I[],octet *W[],octet *F[],octet *C[],octet *D[],int results[])
+{
+    int i,h;
+    if (k==1)
+    {
+        results[idx[0]]=ecdsa_single(sha,W[idx[0]],F[idx[0]],C[idx[0]],D[idx[0]]);
+        return;
+    }
+    if (ecdsa_batch_check(k,idx,I))
+    {
+        for (i=0; i<k; i++) results[idx[i]]=0;
+        return;
+    }
+    h=k/2;
+    ecdsa_batch_split(sha,h,idx,I,W,F,C,D,results);
+    ecdsa_batch_split(sha,k-h,&idx[h],I,W,F,C,D,results);
+}
+
+/* Batch ECDSA Signature Verification. Signatures C[i],D[i] on F[i] are verified using public keys W[i] */
+int ECPVP_DSA_batch(int sha,int n,octet *W[],octet *F[],octet *C[],octet *D[],int *results)
+{
+    int i,j,b,k,res=0,idx[ECDH_BATCH];
+    char s[32],h[32];
+    hash256 seed,sh;
+    ecdsa_item I[ECDH_BATCH];
+
+    for (i=0; i<n; i+=ECDH_BATCH)
+    {
+        b=n-i;
+        if (b>ECDH_BATCH) b=ECDH_BATCH;
+
+        HASH256_init(&seed);
+        k=0;
+        for (j=0; j<b; j++)
+        {
+            if (ecdsa_prepare(sha,W[i+j],F[i+j],C[i+j],D[i+j],&I[j],&seed)) idx[k++]=j;
+            else results[i+j]=ecdsa_single(sha,W[i+j],F[i+j],C[i+j],D[i+j]);
+        }
+        if (k==0) continue;
+
+        /* multipliers are derived from all the signatures in the batch */
+        HASH256_hash(&seed,s);
+        for (j=0; j<k; j++)
+        {
+            HASH256_init(&sh);
+            HASH256_update(&sh,s,32);
+            HASH256_process(&sh,j);
+            HASH256_hash(&sh,h);
+            BIG_fromBytesLen(I[idx[j]].rho,h,ECDH_BATCH_BITS/8);
+        }
+
+        ecdsa_batch_split(sha,k,idx,I,&W[i],&F[i],&C[i],&D[i],&results[i]);
+    }
+
+    for (i=0; i<n; i++)
+        if (results[i]!=0) res=results[i];
+    return res;
+}
+
 /* IEEE1363 ECIES encryption. Encryption of plaintext M uses public key W and produces ciphertext V,C,T */
 void ECP_ECIES_ENCRYPT(int sha,octet *P1,octet *P2,csprng *RNG,octet *W,octet *M,int tlen,octet *V,octet *C,octet *T)
 {
 
-    int i,len;
+    int i;
     char z[EFS],vz[3*EFS+1],k[2*EAS],k1[EAS],k2[EAS],l2[8],u[EFS];
     octet Z= {0,sizeof(z),z};
     octet VZ= {0,sizeof(vz),vz};
@@ -688,6 +1036,7 @@ void ECP_ECIES_ENCRYPT(int sha,octet *P1,octet *P2,csprng *RNG,octet *W,octet *M
     octet K2= {0,sizeof(k2),k2};
     octet L2= {0,sizeof(l2),l2};
     octet U= {0,sizeof(u),u};
+    hmac_ctx H;
 
     if (ECP_KEY_PAIR_GENERATE(RNG,&U,V)!=0) return;
     if (ECPSVDP_DH(&U,W,&Z)!=0) return;
@@ -708,18 +1057,20 @@ void ECP_ECIES_ENCRYPT(int sha,octet *P1,octet *P2,csprng *RNG,octet *W,octet *M
 
     OCT_jint(&L2,P2->len,8);
 
-    len=C->len;
-    OCT_joctet(C,P2);
-    OCT_joctet(C,&L2);
-    HMAC(sha,C,&K2,tlen,T);
-    C->len=len;
+    /* tag of C|P2|L2 */
+    if (!HMAC_init(&H,sha,&K2)) return;
+    HMAC_update(&H,C->val,C->len);
+    HMAC_update(&H,P2->val,P2->len);
+    HMAC_update(&H,L2.val,L2.len);
+    HMAC_final(&H,tlen,T);
+    HMAC_end(&H);
 }
 
 /* IEEE1363 ECIES decryption. Decryption of ciphertext V,C,T using private key U outputs plaintext M */
 int ECP_ECIES_DECRYPT(int sha,octet *P1,octet *P2,octet *V,octet *C,octet *T,octet *U,octet *M)
 {
 
-    int i,len;
+    int i;
     char z[EFS],vz[3*EFS+1],k[2*EAS],k1[EAS],k2[EAS],l2[8],tag[32];
     octet Z= {0,sizeof(z),z};
     octet VZ= {0,sizeof(vz),vz};
@@ -728,6 +1079,7 @@ int ECP_ECIES_DECRYPT(int sha,octet *P1,octet *P2,octet *V,octet *C,octet *T,oct
     octet K2= {0,sizeof(k2),k2};
     octet L2= {0,sizeof(l2),l2};
     octet TAG= {0,sizeof(tag),tag};
+    hmac_ctx H;
 
     if (ECPSVDP_DH(U,V,&Z)!=0) return 0;
 
@@ -747,11 +1099,12 @@ int ECP_ECIES_DECRYPT(int sha,octet *P1,octet *P2,octet *V,octet *C,octet *T,oct
 
     OCT_jint(&L2,P2->len,8);
 
-    len=C->len;
-    OCT_joctet(C,P2);
-    OCT_joctet(C,&L2);
-    HMAC(sha,C,&K2,T->len,&TAG);
-    C->len=len;
+    if (!HMAC_init(&H,sha,&K2)) return 0;
+    HMAC_update(&H,C->val,C->len);
+    HMAC_update(&H,P2->val,P2->len);
+    HMAC_update(&H,L2.val,L2.len);
+    HMAC_final(&H,T->len,&TAG);
+    HMAC_end(&H);
 
     if (!OCT_comp(T,&TAG)) return 0;
 
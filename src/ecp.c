@@ -32,6 +32,10 @@
 
 #include "amcl.h"
 
+#ifdef USE_THREADS
+#include <pthread.h>
+#endif
+
 /* Tests for ECP point equal to infinity */
 int ECP_isinf(ECP *P)
 {
@@ -442,6 +446,60 @@ void ECP_affine(ECP *P)
     BIG_copy(P->z,one);
 }
 
+/* Converts n points to affine coordinates, with one inversion. Requires work vector of n BIGs */
+void ECP_affine_batch(int n,ECP P[],BIG work[])
+{
+    int i;
+    BIG t,s,one;
+    if (n<=0) return;
+    FP_one(one);
+
+    /* work[i]=z[0]..z[i-1], with 1 in place of the z of any point at infinity */
+    BIG_copy(t,one);
+    for (i=0; i<n; i++)
+    {
+        BIG_copy(work[i],t);
+        BIG_copy(s,P[i].z);
+#if CURVETYPE!=EDWARDS
+        BIG_cmove(s,one,P[i].inf);
+#endif
+        FP_mul(t,t,s);
+    }
+    FP_inv(t,t);
+
+    /* t=1/(z[0]..z[i]) going down, so work[i].t=1/z[i] */
+    for (i=n-1; i>=0; i--)
+    {
+        BIG_copy(s,P[i].z);
+#if CURVETYPE!=EDWARDS
+        BIG_cmove(s,one,P[i].inf);
+#endif
+        FP_mul(work[i],work[i],t);
+        FP_mul(t,t,s);
+#if CURVETYPE!=EDWARDS
+        if (P[i].inf) continue;
+#endif
+
+#if CURVETYPE==WEIERSTRASS
+        FP_sqr(s,work[i]);
+        FP_mul(P[i].x,P[i].x,s);
+        FP_mul(s,s,work[i]);
+        FP_mul(P[i].y,P[i].y,s);
+        FP_reduce(P[i].y);
+#endif
+#if CURVETYPE==EDWARDS
+        FP_mul(P[i].x,P[i].x,work[i]);
+        FP_mul(P[i].y,P[i].y,work[i]);
+        FP_reduce(P[i].y);
+#endif
+#if CURVETYPE==MONTGOMERY
+        FP_mul(P[i].x,P[i].x,work[i]);
+#endif
+        FP_reduce(P[i].x);
+        BIG_copy(P[i].z,one);
+    }
+}
+
 /* SU=120, Formats and outputs an ECP point to the console, in projective coordinates */
 void ECP_outputxyz(ECP *P)
 {
@@ -823,50 +881,6 @@ void  ECP_sub(ECP *P,ECP *Q)
 #endif
 
 
-#if CURVETYPE==WEIERSTRASS
-
-/* normalises array of points. Assumes P[0] is normalised already */
-static void ECP_multiaffine(int m,ECP P[],BIG work[])
-{
-    int i;
-    BIG t1,t2;
-
-    FP_one(work[0]);
-    BIG_copy(work[1],P[0].z);
-    for (i=2; i<m; i++)
-        FP_mul(work[i],work[i-1],P[i-1].z);
-
-    FP_mul(t1,work[m-1],P[m-1].z);
-    FP_inv(t1,t1);
-
-    BIG_copy(t2,P[m-1].z);
-    FP_mul(work[m-1],work[m-1],t1);
-
-    for (i=m-2;; i--)
-    {
-        if (i==0)
-        {
-            FP_mul(work[0],t1,t2);
-            break;
-        }
-        FP_mul(work[i],work[i],t2);
-        FP_mul(work[i],work[i],t1);
-        FP_mul(t2,P[i].z,t2);
-    }
-    /* now work[] contains inverses of all Z coordinates */
-
-    for (i=0; i<m; i++)
-    {
-        FP_one(P[i].z);
-        FP_sqr(t1,work[i]);
-        FP_mul(P[i].x,P[i].x,t1);
-        FP_mul(t1,work[i],t1);
-        FP_mul(P[i].y,P[i].y,t1);
-    }
-}
-
-#endif
-
 #if CURVETYPE!=MONTGOMERY
 /* Multiplies an ECP instance P by a small integer, side-channel resistant */
 void ECP_pinmul(ECP *P,int e,int bts)
@@ -963,7 +977,7 @@ void ECP_mul(ECP *P,BIG e)
 
     /* convert the table to affine */
 #if CURVETYPE==WEIERSTRASS
-    ECP_multiaffine(8,W,work);
+    ECP_affine_batch(8,W,work);
 #endif
 
     /* make exponent odd - add 2P if even, P if odd */
@@ -1048,7 +1062,7 @@ void ECP_mul2(ECP *P,ECP *Q,BIG e,BIG f)
     ECP_add(&W[7],&S);
 
 #if CURVETYPE==WEIERSTRASS
-    ECP_multiaffine(8,W,work);
+    ECP_affine_batch(8,W,work);
 #endif
 
     /* if multiplier is odd, add 2, else add 1 to multiplier, and add 2P or P to correction */
@@ -1106,6 +1120,532 @@ void ECP_mul2(ECP *P,ECP *Q,BIG e,BIG f)
     ECP_affine(P);
 }
 
+/* Fixed-base comb for the curve generator G. Exponent is recoded into ECP_GEN_DIGITS signed 4-bit digits.
+   Row i of the table holds the odd multiples 1,3,..,15 of 16^(ECP_GEN_SPACING*i).G, so digit k=i*ECP_GEN_SPACING+j
+   is looked up in row i and shifted into place by the j blocks of 4 doublings still to come */
+
+#define ECP_GEN_ROWS ((ECP_GEN_DIGITS+ECP_GEN_SPACING-1)/ECP_GEN_SPACING)
+
+static ECP gen_table[ECP_GEN_ROWS][8];
+static ECP gen_two;  /* 2G, for the correction */
+static ECP gen_wnaf[1<<(ECP_WNAF_GEN-2)];  /* odd multiples of G for variable time wNAF */
+
+/* Build generator table. Slow, but done only once */
+static void ECP_gen_build(void)
+{
+    int i,j;
+    BIG gx,gy;
+    ECP B,D;
+    BIG work[1<<(ECP_WNAF_GEN-2)];
+
+    BIG_rcopy(gx,CURVE_Gx);
+    BIG_rcopy(gy,CURVE_Gy);
+    ECP_set(&B,gx,gy);
+
+    ECP_copy(&gen_two,&B);
+    ECP_dbl(&gen_two);
+    ECP_affine(&gen_two);
+
+    for (i=0; i<ECP_GEN_ROWS; i++)
+    {
+        ECP_copy(&D,&B);
+        ECP_dbl(&D);
+        ECP_copy(&gen_table[i][0],&B);
+        for (j=1; j<8; j++)
+        {
+            ECP_copy(&gen_table[i][j],&gen_table[i][j-1]);
+            ECP_add(&gen_table[i][j],&D);
+        }
+        ECP_affine_batch(8,gen_table[i],work);
+        for (j=0; j<4*ECP_GEN_SPACING; j++) ECP_dbl(&B);
+        ECP_affine(&B);
+    }
+
+    ECP_copy(&gen_wnaf[0],&gen_table[0][0]);
+    for (j=1; j<(1<<(ECP_WNAF_GEN-2)); j++)
+    {
+        ECP_copy(&gen_wnaf[j],&gen_wnaf[j-1]);
+        ECP_add(&gen_wnaf[j],&gen_two);
+    }
+    ECP_affine_batch(1<<(ECP_WNAF_GEN-2),gen_wnaf,work);
+}
+
+#ifdef USE_THREADS
+static pthread_once_t gen_once=PTHREAD_ONCE_INIT;
+#else
+static int gen_done=0;
+#endif
+
+/* Build generator tables on first use */
+static void ECP_gen_init(void)
+{
+#ifdef USE_THREADS
+    pthread_once(&gen_once,ECP_gen_build);
+#else
+    if (!gen_done)
+    {
+        ECP_gen_build();
+        gen_done=1;
+    }
+#endif
+}
+
+#endif
+
+/* Multiplies the curve generator by a BIG, P=e*G, side-channel resistant */
+void ECP_mul_gen(ECP *P,BIG e)
+{
+#if CURVETYPE==MONTGOMERY
+    BIG gx;
+    BIG_rcopy(gx,CURVE_Gx);
+    ECP_set(P,gx);
+    ECP_mul(P,e);
+#else
+    int i,j,k,s,ns;
+    BIG mt,t;
+    ECP Q,C;
+    sign8 w[ECP_GEN_DIGITS];
+
+    if (BIG_iszilch(e))
+    {
+        ECP_inf(P);
+        return;
+    }
+    if (BIG_nbits(e)>4*(ECP_GEN_DIGITS-2)-1)
+    {
+        /* too big for the table */
+        BIG_rcopy(mt,CURVE_Gx);
+        BIG_rcopy(t,CURVE_Gy);
+        ECP_set(P,mt,t);
+        ECP_mul(P,e);
+        return;
+    }
+
+    ECP_gen_init();
+
+    /* make exponent odd - add 2G if even, G if odd */
+    BIG_copy(t,e);
+    s=BIG_parity(t);
+    BIG_inc(t,1);
+    BIG_norm(t);
+    ns=BIG_parity(t);
+    BIG_copy(mt,t);
+    BIG_inc(mt,1);
+    BIG_norm(mt);
+    BIG_cmove(t,mt,s);
+    ECP_copy(&C,&gen_two);
+    ECP_cmove(&C,&gen_table[0][0],ns);
+
+    /* convert exponent to signed 4-bit window, always the same number of digits */
+    for (i=0; i<ECP_GEN_DIGITS-1; i++)
+    {
+        w[i]=BIG_lastbits(t,5)-16;
+        BIG_dec(t,w[i]);
+        BIG_norm(t);
+        BIG_fshr(t,4);
+    }
+    w[ECP_GEN_DIGITS-1]=BIG_lastbits(t,5);
+
+    ECP_inf(P);
+    for (j=ECP_GEN_SPACING-1; j>=0; j--)
+    {
+        if (j<ECP_GEN_SPACING-1)
+        {
+            ECP_dbl(P);
+            ECP_dbl(P);
+            ECP_dbl(P);
+            ECP_dbl(P);
+        }
+        for (i=0; i<ECP_GEN_ROWS; i++)
+        {
+            k=i*ECP_GEN_SPACING+j;
+            if (k>=ECP_GEN_DIGITS) continue;
+            ECP_select(&Q,gen_table[i],w[k]);
+            ECP_add(P,&Q);
+        }
+    }
+    ECP_sub(P,&C); /* apply correction */
+    ECP_affine(P);
+#endif
+}
+
+#if CURVETYPE!=MONTGOMERY
+
+#define ECP_TABLE_MAX (ECP_WNAF_SIZE>8?ECP_WNAF_SIZE:8)  /* largest table, for wNAF or signed 4-bit windows */
+
+/* W[i]=(2i+1)P for i<n<=ECP_TABLE_MAX, P must be affine */
+static void ECP_wnaf_table(ECP W[],ECP *P,int n)
+{
+    int i;
+    ECP D;
+    BIG work[ECP_TABLE_MAX];
+    ECP_copy(&D,P);
+    ECP_dbl(&D);
+    ECP_copy(&W[0],P);
+    for (i=1; i<n; i++)
+    {
+        ECP_copy(&W[i],&W[i-1]);
+        ECP_add(&W[i],&D);
+    }
+    ECP_affine_batch(n,W,work);
+}
+
+/* P+=d*W, d odd. Table entry is copied, so that W can be shared */
+static void ECP_wnaf_add(ECP *P,ECP W[],int d)
+{
+    ECP T;
+    if (d>0) ECP_copy(&T,&W[(d-1)/2]);
+    else
+    {
+        ECP_copy(&T,&W[(-d-1)/2]);
+        ECP_neg(&T);
+    }
+    ECP_add(P,&T);
+}
+
+/* Calculates double multiplication P=e*P+f*Q, or P=e*P+f*G if Q is NULL. NOT side-channel resistant */
+void ECP_mul2_vartime(ECP *P,ECP *Q,BIG e,BIG f)
+{
+    int i,ne,nf;
+    sign8 we[NLEN*BASEBITS+1],wf[NLEN*BASEBITS+1];
+    ECP WP[ECP_WNAF_SIZE],WQ[ECP_WNAF_SIZE],*TQ;
+
+    ne=0;
+    if (!ECP_isinf(P))
+    {
+        ECP_affine(P);
+        ne=BIG_wnaf(we,e,ECP_WNAF_VAR);
+        if (ne>0) ECP_wnaf_table(WP,P,ECP_WNAF_SIZE);
+    }
+    if (Q==NULL)
+    {
+        ECP_gen_init();
+        TQ=gen_wnaf;
+        nf=BIG_wnaf(wf,f,ECP_WNAF_GEN);
+    }
+    else
+    {
+        nf=0;
+        TQ=WQ;
+        if (!ECP_isinf(Q))
+        {
+            ECP_affine(Q);
+            nf=BIG_wnaf(wf,f,ECP_WNAF_VAR);
+            if (nf>0) ECP_wnaf_table(WQ,Q,ECP_WNAF_SIZE);
+        }
+    }
+
+    ECP_inf(P);
+    for (i=(ne>nf?ne:nf)-1; i>=0; i--)
+    {
+        ECP_dbl(P);
+        if (i<ne && we[i]!=0) ECP_wnaf_add(P,WP,we[i]);
+        if (i<nf && wf[i]!=0) ECP_wnaf_add(P,TQ,wf[i]);
+    }
+    ECP_affine(P);
+}
+
+/* SU= 21216, Straus method, P=e[0]*X[0]+..+e[n-1]*X[n-1]. Result is not affine */
+static void ECP_muln_straus(ECP *P,int n,ECP X[],BIG e[])
+{
+    int i,j,k,m,nb,len[ECP_MULN_MAX];
+    sign8 w[ECP_MULN_MAX][NLEN*BASEBITS+1];
+    ECP W[ECP_MULN_MAX][ECP_WNAF_SIZE],S;
+
+    ECP_inf(P);
+    for (i=0; i<n; i+=ECP_MULN_MAX)
+    {
+        m=n-i;
+        if (m>ECP_MULN_MAX) m=ECP_MULN_MAX;
+
+        nb=0;
+        for (j=0; j<m; j++)
+        {
+            len[j]=0;
+            if (ECP_isinf(&X[i+j])) continue;
+            ECP_affine(&X[i+j]);
+            len[j]=BIG_wnaf(w[j],e[i+j],ECP_WNAF_VAR);
+            if (len[j]>0) ECP_wnaf_table(W[j],&X[i+j],ECP_WNAF_SIZE);
+            if (len[j]>nb) nb=len[j];
+        }
+
+        /* doublings are shared by all points in this group */
+        ECP_inf(&S);
+        for (k=nb-1; k>=0; k--)
+        {
+            ECP_dbl(&S);
+            for (j=0; j<m; j++)
+                if (k<len[j] && w[j][k]!=0) ECP_wnaf_add(&S,W[j],w[j][k]);
+        }
+        ECP_add(P,&S);
+    }
+}
+
+/* Sum each bucket A[start[b]]..A[start[b]+len[b]-1] of affine points into A[start[b]].
+   Points are added in pairs, and each round of pairs shares one inversion */
+static void ECP_bucket_sums(int nb,int start[],int len[],ECP A[])
+{
+#if CURVETYPE==WEIERSTRASS
+    int b,j,k,s,i1,np,more,pi[ECP_PIPPENGER_MAX/2];
+    BIG den[ECP_PIPPENGER_MAX/2],pre[ECP_PIPPENGER_MAX/2],inv,l,t;
+
+    for (;;)
+    {
+        more=0;
+        np=0;
+        for (b=0; b<nb; b++)
+        {
+            s=start[b];
+            if (len[b]>1) more=1;
+            for (j=0; j<len[b]/2; j++)
+            {
+                i1=s+2*j;
+                if (ECP_isinf(&A[i1+1])) continue;
+                if (ECP_isinf(&A[i1]))
+                {
+                    ECP_copy(&A[i1],&A[i1+1]);
+                    continue;
+                }
+                if (BIG_comp(A[i1].x,A[i1+1].x)==0)
+                {
+                    /* doubling or inverse, rare */
+                    ECP_add(&A[i1],&A[i1+1]);
+                    ECP_affine(&A[i1]);
+                    if (!ECP_isinf(&A[i1])) FP_reduce(A[i1].x);
+                    continue;
+                }
+                FP_sub(den[np],A[i1+1].x,A[i1].x);
+                BIG_norm(den[np]);
+                pi[np++]=i1;
+            }
+        }
+        if (!more) break;
+
+        if (np>0)
+        {
+            /* den[k]=1/den[k] */
+            BIG_copy(pre[0],den[0]);
+            for (k=1; k<np; k++)
+                FP_mul(pre[k],pre[k-1],den[k]);
+            FP_inv(inv,pre[np-1]);
+            for (k=np-1; k>0; k--)
+            {
+                FP_mul(t,inv,pre[k-1]);
+                FP_mul(inv,inv,den[k]);
+                BIG_copy(den[k],t);
+            }
+            BIG_copy(den[0],inv);
+
+            for (k=0; k<np; k++)
+            {
+                i1=pi[k];
+                FP_sub(t,A[i1+1].y,A[i1].y);
+                BIG_norm(t);
+                FP_mul(l,t,den[k]);
+
+                FP_sqr(t,l);
+                FP_sub(t,t,A[i1].x);
+                BIG_norm(t);
+                FP_sub(t,t,A[i1+1].x);
+                BIG_norm(t);
+                FP_reduce(t);
+
+                FP_sub(A[i1+1].x,A[i1].x,t);
+                BIG_norm(A[i1+1].x);
+                BIG_copy(A[i1].x,t);
+                FP_mul(t,l,A[i1+1].x);
+                FP_sub(t,t,A[i1].y);
+                BIG_norm(t);
+                FP_reduce(t);
+                BIG_copy(A[i1].y,t);
+            }
+        }
+
+        /* move sums down */
+        for (b=0; b<nb; b++)
+        {
+            s=start[b];
+            for (j=1; j<len[b]/2; j++)
+                ECP_copy(&A[s+j],&A[s+2*j]);
+            if (len[b]%2==1 && len[b]>1)
+                ECP_copy(&A[s+len[b]/2],&A[s+len[b]-1]);
+            len[b]=(len[b]+1)/2;
+        }
+    }
+#else
+    int b,j;
+    for (b=0; b<nb; b++)
+    {
+        for (j=1; j<len[b]; j++)
+            ECP_add(&A[start[b]],&A[start[b]+j]);
+        if (len[b]>1) len[b]=1;
+    }
+#endif
+}
+
+/* SU= 29968, Pippenger bucket method, P=e[0]*X[0]+..+e[m-1]*X[m-1], m<=ECP_PIPPENGER_MAX. Result is not affine */
+static void ECP_muln_pippenger(ECP *P,int m,ECP X[],BIG e[])
+{
+    int i,j,k,b,c,nb,nw,v;
+    int len[ECP_PIPPENGER_BUCKETS],start[ECP_PIPPENGER_BUCKETS],pos[ECP_PIPPENGER_BUCKETS];
+    sign8 d[ECP_PIPPENGER_MAX][ECP_PIPPENGER_DIGITS];
+    ECP A[ECP_PIPPENGER_MAX],R,S;
+
+    c=ECP_PIPPENGER_WINDOW;
+    nb=ECP_PIPPENGER_BUCKETS;
+
+    nw=0;
+    for (i=0; i<m; i++)
+    {
+        k=0;
+        if (!ECP_isinf(&X[i]))
+        {
+            ECP_affine(&X[i]);
+            k=BIG_recode(d[i],e[i],c);
+        }
+        for (j=k; j<ECP_PIPPENGER_DIGITS; j++) d[i][j]=0;
+        if (k>nw) nw=k;
+    }
+
+    ECP_inf(P);
+    for (k=nw-1; k>=0; k--)
+    {
+        for (j=0; j<c; j++) ECP_dbl(P);
+
+        /* sort points into buckets by the absolute value of their digit */
+        for (b=0; b<nb; b++) len[b]=0;
+        for (i=0; i<m; i++)
+        {
+            v=d[i][k];
+            if (v<0) v=-v;
+            if (v) len[v-1]++;
+        }
+        pos[0]=start[0]=0;
+        for (b=1; b<nb; b++) pos[b]=start[b]=start[b-1]+len[b-1];
+        for (i=0; i<m; i++)
+        {
+            v=d[i][k];
+            if (v==0) continue;
+            b=(v<0?-v:v)-1;
+            ECP_copy(&A[pos[b]],&X[i]);
+            if (v<0) ECP_neg(&A[pos[b]]);
+            FP_reduce(A[pos[b]].x);
+            FP_reduce(A[pos[b]].y);
+            pos[b]++;
+        }
+
+        ECP_bucket_sums(nb,start,len,A);
+
+        /* S=sum (b+1).bucket[b] */
+        ECP_inf(&R);
+        ECP_inf(&S);
+        for (b=nb-1; b>=0; b--)
+        {
+            if (len[b]) ECP_add(&R,&A[start[b]]);
+            ECP_add(&S,&R);
+        }
+        ECP_add(P,&S);
+    }
+}
+
+/* Calculates multi-multiplication P=e[0]*X[0]+..+e[n-1]*X[n-1]. NOT side-channel resistant */
+void ECP_muln(ECP *P,int n,ECP X[],BIG e[])
+{
+    int i,m;
+    ECP S;
+
+    ECP_inf(P);
+    for (i=0; i<n; i+=ECP_PIPPENGER_MAX)
+    {
+        m=n-i;
+        if (m>ECP_PIPPENGER_MAX) m=ECP_PIPPENGER_MAX;
+        if (m<ECP_PIPPENGER_MIN) ECP_muln_straus(&S,m,&X[i],&e[i]);
+        else ECP_muln_pippenger(&S,m,&X[i],&e[i]);
+        ECP_add(P,&S);
+    }
+    ECP_affine(P);
+}
+
+/* SU= 18176, Calculates multi-multiplication P=e[0]*X[0]+..+e[n-1]*X[n-1], side-channel resistant */
+void ECP_muln_ct(ECP *P,int n,ECP X[],BIG e[])
+{
+    int i,j,k,m,s,ns,skip[ECP_MULN_MAX];
+    BIG t,mt;
+    sign8 w[ECP_MULN_MAX][ECP_GEN_DIGITS];
+    ECP W[ECP_MULN_MAX][8],S,Q,C;
+
+    ECP_inf(P);
+    ECP_inf(&C);
+    for (i=0; i<n; i+=ECP_MULN_MAX)
+    {
+        m=n-i;
+        if (m>ECP_MULN_MAX) m=ECP_MULN_MAX;
+
+        for (j=0; j<m; j++)
+        {
+            skip[j]=1;
+            if (ECP_isinf(&X[i+j])) continue;
+            ECP_affine(&X[i+j]);
+            if (BIG_nbits(e[i+j])>4*(ECP_GEN_DIGITS-2)-1)
+            {
+                /* too big for fixed number of digits */
+                ECP_copy(&Q,&X[i+j]);
+                ECP_mul(&Q,e[i+j]);
+                ECP_add(P,&Q);
+                continue;
+            }
+            skip[j]=0;
+            ECP_wnaf_table(W[j],&X[i+j],8);
+
+            /* make exponent odd - add 2X if even, X if odd */
+            BIG_copy(t,e[i+j]);
+            s=BIG_parity(t);
+            BIG_inc(t,1);
+            BIG_norm(t);
+            ns=BIG_parity(t);
+            BIG_copy(mt,t);
+            BIG_inc(mt,1);
+            BIG_norm(mt);
+            BIG_cmove(t,mt,s);
+            ECP_copy(&Q,&X[i+j]);
+            ECP_dbl(&Q);
+            ECP_cmove(&Q,&X[i+j],ns);
+            ECP_add(&C,&Q);
+
+            /* convert exponent to signed 4-bit window, always the same number of digits */
+            for (k=0; k<ECP_GEN_DIGITS-1; k++)
+            {
+                w[j][k]=BIG_lastbits(t,5)-16;
+                BIG_dec(t,w[j][k]);
+                BIG_norm(t);
+                BIG_fshr(t,4);
+            }
+            w[j][ECP_GEN_DIGITS-1]=BIG_lastbits(t,5);
+        }
+
+        ECP_inf(&S);
+        for (k=ECP_GEN_DIGITS-1; k>=0; k--)
+        {
+            if (k<ECP_GEN_DIGITS-1)
+            {
+                ECP_dbl(&S);
+                ECP_dbl(&S);
+                ECP_dbl(&S);
+                ECP_dbl(&S);
+            }
+            for (j=0; j<m; j++)
+            {
+                if (skip[j]) continue;
+                ECP_select(&Q,W[j],w[j][k]);
+                ECP_add(&S,&Q);
+            }
+        }
+        ECP_add(P,&S);
+    }
+    ECP_sub(P,&C); /* apply corrections */
+    ECP_affine(P);
+}
+
 #endif
 
 #ifdef HAS_MAIN
@@ -141,6 +141,44 @@ void ECP2_affine(ECP2 *P)
     FP2_copy(&(P->z),&one);
 }
 
+/* Converts n ECP2 points to affine coordinates, with one inversion. Requires work vector of n FP2s */
+void ECP2_affine_batch(int n,ECP2 P[],FP2 work[])
+{
+    int i;
+    FP2 t,s,one;
+    if (n<=0) return;
+    FP2_one(&one);
+
+    /* work[i]=z[0]..z[i-1], with 1 in place of the z of any point at infinity */
+    FP2_copy(&t,&one);
+    for (i=0; i<n; i++)
+    {
+        FP2_copy(&work[i],&t);
+        FP2_copy(&s,&(P[i].z));
+        FP2_cmove(&s,&one,P[i].inf);
+        FP2_mul(&t,&t,&s);
+    }
+    FP2_inv(&t,&t);
+
+    /* t=1/(z[0]..z[i]) going down, so work[i].t=1/z[i] */
+    for (i=n-1; i>=0; i--)
+    {
+        FP2_copy(&s,&(P[i].z));
+        FP2_cmove(&s,&one,P[i].inf);
+        FP2_mul(&work[i],&work[i],&t);
+        FP2_mul(&t,&t,&s);
+        if (P[i].inf) continue;
+
+        FP2_sqr(&s,&work[i]);
+        FP2_mul(&(P[i].x),&(P[i].x),&s);
+        FP2_mul(&s,&s,&work[i]);
+        FP2_mul(&(P[i].y),&(P[i].y),&s);
+        FP2_reduce(&(P[i].x));
+        FP2_reduce(&(P[i].y));
+        FP2_copy(&(P[i].z),&one);
+    }
+}
+
 /* SU= 16, Extract x and y coordinates of an ECP2 point P */
 int ECP2_get(FP2 *x,FP2 *y,ECP2 *P)
 {
@@ -233,9 +271,9 @@ void ECP2_rhs(FP2 *rhs,FP2 *x)
 
     /* Assuming CURVE_A=0 */
 
-    BIG_rcopy(b,CURVE_B);
+    BIG_rcopy(b,CURVE_B_NRES);
 
-    FP2_from_BIG(&t,b);
+    FP2_from_FP(&t,b);
 
     FP2_div_ip(&t);   /* IMPORTANT - here we use the SEXTIC twist of the curve */
 
@@ -431,47 +469,6 @@ void ECP2_sub(ECP2 *P,ECP2 *Q)
     ECP2_neg(Q);
 }
 
-/* normalises m-array of ECP2 points. Requires work vector of m FP2s */
-/* SU= 200 */
-static void ECP2_multiaffine(int m,ECP2 *P,FP2 *work)
-{
-    int i;
-    FP2 t1,t2;
-
-    FP2_one(&work[0]);
-    FP2_copy(&work[1],&(P[0].z));
-    for (i=2; i<m; i++)
-        FP2_mul(&work[i],&work[i-1],&(P[i-1].z));
-    FP2_mul(&t1,&work[m-1],&(P[m-1].z));
-
-    FP2_inv(&t1,&t1);
-
-    FP2_copy(&t2,&(P[m-1].z));
-    FP2_mul(&work[m-1],&work[m-1],&t1);
-
-    for (i=m-2;; i--)
-    {
-        if (i==0)
-        {
-            FP2_mul(&work[0],&t1,&t2);
-            break;
-        }
-        FP2_mul(&work[i],&work[i],&t2);
-        FP2_mul(&work[i],&work[i],&t1);
-        FP2_mul(&t2,&(P[i].z),&t2);
-    }
-    /* now work[] contains inverses of all Z coordinates */
-
-    for (i=0; i<m; i++)
-    {
-        FP2_one(&(P[i].z));
-        FP2_sqr(&t1,&work[i]);
-        FP2_mul(&(P[i].x),&(P[i].x),&t1);
-        FP2_mul(&t1,&work[i],&t1);
-        FP2_mul(&(P[i].y),&(P[i].y),&t1);
-    }
-}
-
 /* SU= 280, Multiplies an ECP2 instance P by a BIG, side-channel resistant */
 void ECP2_mul(ECP2 *P,BIG e)
 {
@@ -500,7 +497,7 @@ void ECP2_mul(ECP2 *P,BIG e)
 
     /* convert the table to affine */
 
-    ECP2_multiaffine(8,W,work);
+    ECP2_affine_batch(8,W,work);
 
     /* make exponent odd - add 2P if even, P if odd */
     BIG_copy(t,e);
@@ -598,7 +595,7 @@ void ECP2_mul4(ECP2 *P,ECP2 Q[4],BIG u[4])
     ECP2_sub(&W[4],&T);
     ECP2_add(&W[7],&T);
 
-    ECP2_multiaffine(8,W,work);
+    ECP2_affine_batch(8,W,work);
 
     /* if multiplier is even add 1 to multiplier, and add P to correction */
     ECP2_inf(&C);
@@ -644,6 +641,327 @@ void ECP2_mul4(ECP2 *P,ECP2 Q[4],BIG u[4])
     ECP2_affine(P);
 }
 
+#define ECP2_TABLE_MAX (ECP_WNAF_SIZE>8?ECP_WNAF_SIZE:8)  /* largest table, for wNAF or signed 4-bit windows */
+
+/* W[i]=(2i+1)P for i<n<=ECP2_TABLE_MAX, P must be affine */
+static void ECP2_wnaf_table(ECP2 W[],ECP2 *P,int n)
+{
+    int i;
+    ECP2 D;
+    FP2 work[ECP2_TABLE_MAX];
+    ECP2_copy(&D,P);
+    ECP2_dbl(&D);
+    ECP2_copy(&W[0],P);
+    for (i=1; i<n; i++)
+    {
+        ECP2_copy(&W[i],&W[i-1]);
+        ECP2_add(&W[i],&D);
+    }
+    ECP2_affine_batch(n,W,work);
+}
+
+/* P+=d*W, d odd */
+static void ECP2_wnaf_add(ECP2 *P,ECP2 W[],int d)
+{
+    ECP2 T;
+    if (d>0) ECP2_copy(&T,&W[(d-1)/2]);
+    else
+    {
+        ECP2_copy(&T,&W[(-d-1)/2]);
+        ECP2_neg(&T);
+    }
+    ECP2_add(P,&T);
+}
+
+/* SU= 36976, Straus method, P=e[0]*X[0]+..+e[n-1]*X[n-1]. Result is not affine */
+static void ECP2_muln_straus(ECP2 *P,int n,ECP2 X[],BIG e[])
+{
+    int i,j,k,m,nb,len[ECP_MULN_MAX];
+    sign8 w[ECP_MULN_MAX][NLEN*BASEBITS+1];
+    ECP2 W[ECP_MULN_MAX][ECP_WNAF_SIZE],S;
+
+    ECP2_inf(P);
+    for (i=0; i<n; i+=ECP_MULN_MAX)
+    {
+        m=n-i;
+        if (m>ECP_MULN_MAX) m=ECP_MULN_MAX;
+
+        nb=0;
+        for (j=0; j<m; j++)
+        {
+            len[j]=0;
+            if (ECP2_isinf(&X[i+j])) continue;
+            ECP2_affine(&X[i+j]);
+            len[j]=BIG_wnaf(w[j],e[i+j],ECP_WNAF_VAR);
+            if (len[j]>0) ECP2_wnaf_table(W[j],&X[i+j],ECP_WNAF_SIZE);
+            if (len[j]>nb) nb=len[j];
+        }
+
+        /* doublings are shared by all points in this group */
+        ECP2_inf(&S);
+        for (k=nb-1; k>=0; k--)
+        {
+            ECP2_dbl(&S);
+            for (j=0; j<m; j++)
+                if (k<len[j] && w[j][k]!=0) ECP2_wnaf_add(&S,W[j],w[j][k]);
+        }
+        ECP2_add(P,&S);
+    }
+}
+
+/* Sum each bucket A[start[b]]..A[start[b]+len[b]-1] of affine points into A[start[b]].
+   Points are added in pairs, and each round of pairs shares one inversion */
+static void ECP2_bucket_sums(int nb,int start[],int len[],ECP2 A[])
+{
+    int b,j,k,s,i1,np,more,pi[ECP_PIPPENGER_MAX/2];
+    FP2 den[ECP_PIPPENGER_MAX/2],pre[ECP_PIPPENGER_MAX/2],inv,l,t;
+
+    for (;;)
+    {
+        more=0;
+        np=0;
+        for (b=0; b<nb; b++)
+        {
+            s=start[b];
+            if (len[b]>1) more=1;
+            for (j=0; j<len[b]/2; j++)
+            {
+                i1=s+2*j;
+                if (ECP2_isinf(&A[i1+1])) continue;
+                if (ECP2_isinf(&A[i1]))
+                {
+                    ECP2_copy(&A[i1],&A[i1+1]);
+                    continue;
+                }
+                if (FP2_equals(&(A[i1].x),&(A[i1+1].x)))
+                {
+                    /* doubling or inverse, rare */
+                    ECP2_add(&A[i1],&A[i1+1]);
+                    ECP2_affine(&A[i1]);
+                    continue;
+                }
+                FP2_sub(&den[np],&(A[i1+1].x),&(A[i1].x));
+                FP2_norm(&den[np]);
+                pi[np++]=i1;
+            }
+        }
+        if (!more) break;
+
+        if (np>0)
+        {
+            /* den[k]=1/den[k] */
+            FP2_copy(&pre[0],&den[0]);
+            for (k=1; k<np; k++)
+                FP2_mul(&pre[k],&pre[k-1],&den[k]);
+            FP2_inv(&inv,&pre[np-1]);
+            for (k=np-1; k>0; k--)
+            {
+                FP2_mul(&t,&inv,&pre[k-1]);
+                FP2_mul(&inv,&inv,&den[k]);
+                FP2_copy(&den[k],&t);
+            }
+            FP2_copy(&den[0],&inv);
+
+            for (k=0; k<np; k++)
+            {
+                i1=pi[k];
+                FP2_sub(&t,&(A[i1+1].y),&(A[i1].y));
+                FP2_norm(&t);
+                FP2_mul(&l,&t,&den[k]);
+
+                FP2_sqr(&t,&l);
+                FP2_sub(&t,&t,&(A[i1].x));
+                FP2_norm(&t);
+                FP2_sub(&t,&t,&(A[i1+1].x));
+                FP2_norm(&t);
+                FP2_reduce(&t);
+
+                FP2_sub(&(A[i1+1].x),&(A[i1].x),&t);
+                FP2_norm(&(A[i1+1].x));
+                FP2_copy(&(A[i1].x),&t);
+                FP2_mul(&t,&l,&(A[i1+1].x));
+                FP2_sub(&t,&t,&(A[i1].y));
+                FP2_norm(&t);
+                FP2_reduce(&t);
+                FP2_copy(&(A[i1].y),&t);
+            }
+        }
+
+        /* move sums down */
+        for (b=0; b<nb; b++)
+        {
+            s=start[b];
+            for (j=1; j<len[b]/2; j++)
+                ECP2_copy(&A[s+j],&A[s+2*j]);
+            if (len[b]%2==1 && len[b]>1)
+                ECP2_copy(&A[s+len[b]/2],&A[s+len[b]-1]);
+            len[b]=(len[b]+1)/2;
+        }
+    }
+}
+
+/* SU= 50800, Pippenger bucket method, P=e[0]*X[0]+..+e[m-1]*X[m-1], m<=ECP_PIPPENGER_MAX. Result is not affine */
+static void ECP2_muln_pippenger(ECP2 *P,int m,ECP2 X[],BIG e[])
+{
+    int i,j,k,b,c,nb,nw,v;
+    int len[ECP_PIPPENGER_BUCKETS],start[ECP_PIPPENGER_BUCKETS],pos[ECP_PIPPENGER_BUCKETS];
+    sign8 d[ECP_PIPPENGER_MAX][ECP_PIPPENGER_DIGITS];
+    ECP2 A[ECP_PIPPENGER_MAX],R,S;
+
+    c=ECP_PIPPENGER_WINDOW;
+    nb=ECP_PIPPENGER_BUCKETS;
+
+    nw=0;
+    for (i=0; i<m; i++)
+    {
+        k=0;
+        if (!ECP2_isinf(&X[i]))
+        {
+            ECP2_affine(&X[i]);
+            k=BIG_recode(d[i],e[i],c);
+        }
+        for (j=k; j<ECP_PIPPENGER_DIGITS; j++) d[i][j]=0;
+        if (k>nw) nw=k;
+    }
+
+    ECP2_inf(P);
+    for (k=nw-1; k>=0; k--)
+    {
+        for (j=0; j<c; j++) ECP2_dbl(P);
+
+        /* sort points into buckets by the absolute value of their digit */
+        for (b=0; b<nb; b++) len[b]=0;
+        for (i=0; i<m; i++)
+        {
+            v=d[i][k];
+            if (v<0) v=-v;
+            if (v) len[v-1]++;
+        }
+        pos[0]=start[0]=0;
+        for (b=1; b<nb; b++) pos[b]=start[b]=start[b-1]+len[b-1];
+        for (i=0; i<m; i++)
+        {
+            v=d[i][k];
+            if (v==0) continue;
+            b=(v<0?-v:v)-1;
+            ECP2_copy(&A[pos[b]],&X[i]);
+            if (v<0) ECP2_neg(&A[pos[b]]);
+            FP2_reduce(&(A[pos[b]].y));
+            pos[b]++;
+        }
+
+        ECP2_bucket_sums(nb,start,len,A);
+
+        /* S=sum (b+1).bucket[b] */
+        ECP2_inf(&R);
+        ECP2_inf(&S);
+        for (b=nb-1; b>=0; b--)
+        {
+            if (len[b]) ECP2_add(&R,&A[start[b]]);
+            ECP2_add(&S,&R);
+        }
+        ECP2_add(P,&S);
+    }
+}
+
+/* Calculates multi-multiplication P=e[0]*X[0]+..+e[n-1]*X[n-1]. NOT side-channel resistant */
+void ECP2_muln(ECP2 *P,int n,ECP2 X[],BIG e[])
+{
+    int i,m;
+    ECP2 S;
+
+    ECP2_inf(P);
+    for (i=0; i<n; i+=ECP_PIPPENGER_MAX)
+    {
+        m=n-i;
+        if (m>ECP_PIPPENGER_MAX) m=ECP_PIPPENGER_MAX;
+        if (m<ECP_PIPPENGER_MIN) ECP2_muln_straus(&S,m,&X[i],&e[i]);
+        else ECP2_muln_pippenger(&S,m,&X[i],&e[i]);
+        ECP2_add(P,&S);
+    }
+    ECP2_affine(P);
+}
+
+/* SU= 33920, Calculates multi-multiplication P=e[0]*X[0]+..+e[n-1]*X[n-1], side-channel resistant */
+void ECP2_muln_ct(ECP2 *P,int n,ECP2 X[],BIG e[])
+{
+    int i,j,k,m,s,ns,skip[ECP_MULN_MAX];
+    BIG t,mt;
+    sign8 w[ECP_MULN_MAX][ECP_GEN_DIGITS];
+    ECP2 W[ECP_MULN_MAX][8],S,Q,C;
+
+    ECP2_inf(P);
+    ECP2_inf(&C);
+    for (i=0; i<n; i+=ECP_MULN_MAX)
+    {
+        m=n-i;
+        if (m>ECP_MULN_MAX) m=ECP_MULN_MAX;
+
+        for (j=0; j<m; j++)
+        {
+            skip[j]=1;
+            if (ECP2_isinf(&X[i+j])) continue;
+            ECP2_affine(&X[i+j]);
+            if (BIG_nbits(e[i+j])>4*(ECP_GEN_DIGITS-2)-1)
+            {
+                /* too big for fixed number of digits */
+                ECP2_copy(&Q,&X[i+j]);
+                ECP2_mul(&Q,e[i+j]);
+                ECP2_add(P,&Q);
+                continue;
+            }
+            skip[j]=0;
+            ECP2_wnaf_table(W[j],&X[i+j],8);
+
+            /* make exponent odd - add 2X if even, X if odd */
+            BIG_copy(t,e[i+j]);
+            s=BIG_parity(t);
+            BIG_inc(t,1);
+            BIG_norm(t);
+            ns=BIG_parity(t);
+            BIG_copy(mt,t);
+            BIG_inc(mt,1);
+            BIG_norm(mt);
+            BIG_cmove(t,mt,s);
+            ECP2_copy(&Q,&X[i+j]);
+            ECP2_dbl(&Q);
+            ECP2_cmove(&Q,&X[i+j],ns);
+            ECP2_add(&C,&Q);
+
+            /* convert exponent to signed 4-bit window, always the same number of digits */
+            for (k=0; k<ECP_GEN_DIGITS-1; k++)
+            {
+                w[j][k]=BIG_lastbits(t,5)-16;
+                BIG_dec(t,w[j][k]);
+                BIG_norm(t);
+                BIG_fshr(t,4);
+            }
+            w[j][ECP_GEN_DIGITS-1]=BIG_lastbits(t,5);
+        }
+
+        ECP2_inf(&S);
+        for (k=ECP_GEN_DIGITS-1; k>=0; k--)
+        {
+            if (k<ECP_GEN_DIGITS-1)
+            {
+                ECP2_dbl(&S);
+                ECP2_dbl(&S);
+                ECP2_dbl(&S);
+                ECP2_dbl(&S);
+            }
+            for (j=0; j<m; j++)
+            {
+                if (skip[j]) continue;
+                ECP2_select(&Q,W[j],w[j][k]);
+                ECP2_add(&S,&Q);
+            }
+        }
+        ECP2_add(P,&S);
+    }
+    ECP2_sub(P,&C); /* apply corrections */
+    ECP2_affine(P);
+}
+
 /*
 
 int main()
@@ -30,6 +30,14 @@
 
 #include "amcl.h"
 
+#ifdef AMCL_SATURATED
+#include <stddef.h>
+#endif
+
+#if defined(AMCL_SATURATED) || defined(AMCL_IFMA)
+#include <immintrin.h>
+#endif
+
 /* Fast Modular Reduction Methods */
 
 /* r=d mod m */
@@ -159,15 +167,16 @@ void FP_mod(BIG r,DBIG d)
 
 #if MODTYPE == MONTGOMERY_FRIENDLY
 
-/* Converts from BIG integer to n-residue form mod Modulus */
+/* Converts from BIG integer to n-residue form mod Modulus, as a Montgomery multiplication by R^2 mod p */
 void FP_nres(BIG a)
 {
     DBIG d;
-    BIG m;
-    BIG_rcopy(m,Modulus);
-    BIG_dscopy(d,a);
-    BIG_dshl(d,NLEN*BASEBITS);
-    BIG_dmod(a,d,m);
+    BIG r;
+    BIG_rcopy(r,R2modp);
+    BIG_norm(a);
+    BIG_mul(d,a,r);
+    FP_mod(a,d);
+    FP_reduce(a);
 }
 
 /* Converts from n-residue form back to BIG integer form */
@@ -195,15 +204,16 @@ void FP_mod(BIG a,DBIG d)
 
 #if MODTYPE == NOT_SPECIAL
 
-/* SU= 120, Converts from BIG integer to n-residue form mod Modulus */
+/* SU= 120, Converts from BIG integer to n-residue form mod Modulus, as a Montgomery multiplication by R^2 mod p */
 void FP_nres(BIG a)
 {
     DBIG d;
-    BIG m;
-    BIG_rcopy(m,Modulus);
-    BIG_dscopy(d,a);
-    BIG_dshl(d,NLEN*BASEBITS);
-    BIG_dmod(a,d,m);
+    BIG r;
+    BIG_rcopy(r,R2modp);
+    BIG_norm(a);
+    BIG_mul(d,a,r);
+    FP_mod(a,d);
+    FP_reduce(a);
 }
 
 /* SU= 80, Converts from n-residue form back to BIG integer form */
@@ -403,6 +413,424 @@ int tadd=0,radd=0,tneg=0,rneg=0;
 int tdadd=0,rdadd=0,tdneg=0,rdneg=0;
 #endif
 
+#ifdef AMCL_SATURATED
+
+/* Montgomery multiplication in a full 64-bit radix, using MULX and the ADCX/ADOX carry chains. Normalised
+   operands are repacked from BASEBITS-bit digits into SAT_WORDS 64-bit words, which hold any excess.
+   Reduction is by whole words, R'=2^(64*SAT_WORDS), so the operands are packed shifted up by SAT_SHIFT bits
+   between them, and a.b.2^SAT_SHIFT/R'=a.b/R for R=2^(BASEBITS*NLEN). Since the Montgomery quotient is
+   unique the result is the same BIG as FP_mod gives. The 256 and 384-bit fields have hand-scheduled kernels,
+   which keep the accumulator in registers and add the low and high halves of the products in two carry
+   chains at once. See Gueron and Krasnov, "Software Implementation of Modular Exponentiation, Using Advanced
+   Vector Instructions Architectures" and Intel's "New Instructions Supporting Large Integer Arithmetic" */
+
+#define SAT_MUL __attribute__((target("bmi2,adx")))
+#define SAT_INLINE __attribute__((always_inline)) inline
+
+/* One step of a row, lo:hi=m.rdx added to two words of the accumulator */
+#define SAT_MULADD(m,lo,hi) "mulxq " m ",%%r8,%%r9\n\tadcxq %%r8," lo "\n\tadoxq %%r9," hi "\n\t"
+
+/* Operands and result, at fixed offsets for the kernels */
+typedef struct
+{
+    unsign64 x[SAT_WORDS];    /**< first operand */
+    unsign64 y[SAT_WORDS];    /**< second operand */
+    unsign64 p[SAT_WORDS];    /**< modulus */
+    unsign64 n0;              /**< -1/p mod 2^64 */
+    unsign64 t[SAT_WORDS+2];  /**< x.y/R' mod p */
+} sat_args;
+
+/* 1 if the processor supports MULX and ADX */
+static int sat_supported(void)
+{
+    return CPU_has(CPU_BMI2|CPU_ADX);
+}
+
+/* Pack non-negative BIG a, shifted up by sh bits, into 64-bit words w */
+SAT_INLINE static void sat_pack(unsign64 *w,const chunk *a,int sh)
+{
+    int i,k=0,n=sh;
+    unsigned __int128 t=0;
+
+#pragma GCC unroll 16
+    for (i=0; i<NLEN; i++)
+    {
+        t|=(unsigned __int128)(unsign64)a[i]<<n;
+        n+=BASEBITS;
+        if (n>=64)
+        {
+            w[k++]=(unsign64)t;
+            t>>=64;
+            n-=64;
+        }
+    }
+#pragma GCC unroll 16
+    for (; k<SAT_WORDS; k++)
+    {
+        w[k]=(unsign64)t;
+        t>>=64;
+    }
+}
+
+/* Modulus in 64-bit words, and -1/p mod 2^64 */
+static unsign64 sat_p[SAT_WORDS];
+static unsign64 sat_n0;
+static int sat_done=0;
+
+/* SU= 112, Pack the Modulus when the library is loaded, or on first use if that is earlier */
+__attribute__((constructor)) static void sat_init(void)
+{
+    int i;
+    unsign64 w[SAT_WORDS],n0;
+    BIG md;
+
+    BIG_rcopy(md,Modulus);
+    sat_pack(w,md,0);
+
+    /* by a Newton step from MConst=-1/p mod 2^BASEBITS */
+    n0=(unsign64)MConst;
+    n0*=2+w[0]*n0;
+
+    for (i=0; i<SAT_WORDS; i++) __atomic_store_n(&sat_p[i],w[i],__ATOMIC_RELAXED);
+    __atomic_store_n(&sat_n0,n0,__ATOMIC_RELAXED);
+    __atomic_store_n(&sat_done,1,__ATOMIC_RELEASE);
+}
+
+#if SAT_WORDS==5 && SAT_PWORDS==4
+
+/* Each row adds x[i].y to the accumulator t0..t5, then m.p for m=t0.n0, and the accumulator moves down a
+   word by renaming its registers */
+SAT_MUL static void sat_redc(sat_args *v)
+{
+    __asm__ volatile(
+        ".macro SATROW x,t0,t1,t2,t3,t4,t5,t6\n\t"
+        "movq \\x(%%rdi),%%rdx\n\t"
+        "xorl %%eax,%%eax\n\t"
+        "movq %%rax,\\t6\n\t"
+        SAT_MULADD("%c[y]+0(%%rdi)","\\t0","\\t1")
+        SAT_MULADD("%c[y]+8(%%rdi)","\\t1","\\t2")
+        SAT_MULADD("%c[y]+16(%%rdi)","\\t2","\\t3")
+        SAT_MULADD("%c[y]+24(%%rdi)","\\t3","\\t4")
+        SAT_MULADD("%c[y]+32(%%rdi)","\\t4","\\t5")
+        "adcxq %%rax,\\t5\n\tadoxq %%rax,\\t6\n\tadcxq %%rax,\\t6\n\t"
+        "movq \\t0,%%rdx\n\t"
+        "imulq %c[n0](%%rdi),%%rdx\n\t"
+        "xorl %%eax,%%eax\n\t"
+        SAT_MULADD("%c[p]+0(%%rdi)","\\t0","\\t1")
+        SAT_MULADD("%c[p]+8(%%rdi)","\\t1","\\t2")
+        SAT_MULADD("%c[p]+16(%%rdi)","\\t2","\\t3")
+        SAT_MULADD("%c[p]+24(%%rdi)","\\t3","\\t4")
+        "adcxq %%rax,\\t4\n\tadoxq %%rax,\\t5\n\t"
+        "adcxq %%rax,\\t5\n\tadoxq %%rax,\\t6\n\t"
+        "adcxq %%rax,\\t6\n\t"
+        ".endm\n\t"
+        "xorl %%r10d,%%r10d\n\txorl %%r11d,%%r11d\n\txorl %%r12d,%%r12d\n\txorl %%r13d,%%r13d\n\txorl %%r14d,%%r14d\n\txorl %%r15d,%%r15d\n\t"
+        "SATROW %c[x]+0,%%r10,%%r11,%%r12,%%r13,%%r14,%%r15,%%rbx\n\t"
+        "SATROW %c[x]+8,%%r11,%%r12,%%r13,%%r14,%%r15,%%rbx,%%r10\n\t"
+        "SATROW %c[x]+16,%%r12,%%r13,%%r14,%%r15,%%rbx,%%r10,%%r11\n\t"
+        "SATROW %c[x]+24,%%r13,%%r14,%%r15,%%rbx,%%r10,%%r11,%%r12\n\t"
+        "SATROW %c[x]+32,%%r14,%%r15,%%rbx,%%r10,%%r11,%%r12,%%r13\n\t"
+        ".purgem SATROW\n\t"
+        "movq %%r15,%c[t]+0(%%rdi)\n\t"
+        "movq %%rbx,%c[t]+8(%%rdi)\n\t"
+        "movq %%r10,%c[t]+16(%%rdi)\n\t"
+        "movq %%r11,%c[t]+24(%%rdi)\n\t"
+        "movq %%r12,%c[t]+32(%%rdi)\n\t"
+        "movq %%r13,%c[t]+40(%%rdi)\n\t"
+        :
+        : "D"(v),[x] "i"(offsetof(sat_args,x)),[y] "i"(offsetof(sat_args,y)),[p] "i"(offsetof(sat_args,p)),
+          [n0] "i"(offsetof(sat_args,n0)),[t] "i"(offsetof(sat_args,t))
+        : "rax","rdx","r8","r9","r10","r11","r12","r13","r14","r15","rbx","cc","memory");
+}
+
+#elif SAT_WORDS==7 && SAT_PWORDS==6
+
+/* As above, with accumulator t0..t7 */
+SAT_MUL static void sat_redc(sat_args *v)
+{
+    __asm__ volatile(
+        ".macro SATROW x,t0,t1,t2,t3,t4,t5,t6,t7,t8\n\t"
+        "movq \\x(%%rdi),%%rdx\n\t"
+        "xorl %%eax,%%eax\n\t"
+        "movq %%rax,\\t8\n\t"
+        SAT_MULADD("%c[y]+0(%%rdi)","\\t0","\\t1")
+        SAT_MULADD("%c[y]+8(%%rdi)","\\t1","\\t2")
+        SAT_MULADD("%c[y]+16(%%rdi)","\\t2","\\t3")
+        SAT_MULADD("%c[y]+24(%%rdi)","\\t3","\\t4")
+        SAT_MULADD("%c[y]+32(%%rdi)","\\t4","\\t5")
+        SAT_MULADD("%c[y]+40(%%rdi)","\\t5","\\t6")
+        SAT_MULADD("%c[y]+48(%%rdi)","\\t6","\\t7")
+        "adcxq %%rax,\\t7\n\tadoxq %%rax,\\t8\n\tadcxq %%rax,\\t8\n\t"
+        "movq \\t0,%%rdx\n\t"
+        "imulq %c[n0](%%rdi),%%rdx\n\t"
+        "xorl %%eax,%%eax\n\t"
+        SAT_MULADD("%c[p]+0(%%rdi)","\\t0","\\t1")
+        SAT_MULADD("%c[p]+8(%%rdi)","\\t1","\\t2")
+        SAT_MULADD("%c[p]+16(%%rdi)","\\t2","\\t3")
+        SAT_MULADD("%c[p]+24(%%rdi)","\\t3","\\t4")
+        SAT_MULADD("%c[p]+32(%%rdi)","\\t4","\\t5")
+        SAT_MULADD("%c[p]+40(%%rdi)","\\t5","\\t6")
+        "adcxq %%rax,\\t6\n\tadoxq %%rax,\\t7\n\t"
+        "adcxq %%rax,\\t7\n\tadoxq %%rax,\\t8\n\t"
+        "adcxq %%rax,\\t8\n\t"
+        ".endm\n\t"
+        "xorl %%r10d,%%r10d\n\txorl %%r11d,%%r11d\n\txorl %%r12d,%%r12d\n\txorl %%r13d,%%r13d\n\txorl %%r14d,%%r14d\n\txorl %%r15d,%%r15d\n\txorl %%ebx,%%ebx\n\txorl %%ecx,%%ecx\n\t"
+        "SATROW %c[x]+0,%%r10,%%r11,%%r12,%%r13,%%r14,%%r15,%%rbx,%%rcx,%%rsi\n\t"
+        "SATROW %c[x]+8,%%r11,%%r12,%%r13,%%r14,%%r15,%%rbx,%%rcx,%%rsi,%%r10\n\t"
+        "SATROW %c[x]+16,%%r12,%%r13,%%r14,%%r15,%%rbx,%%rcx,%%rsi,%%r10,%%r11\n\t"
+        "SATROW %c[x]+24,%%r13,%%r14,%%r15,%%rbx,%%rcx,%%rsi,%%r10,%%r11,%%r12\n\t"
+        "SATROW %c[x]+32,%%r14,%%r15,%%rbx,%%rcx,%%rsi,%%r10,%%r11,%%r12,%%r13\n\t"
+        "SATROW %c[x]+40,%%r15,%%rbx,%%rcx,%%rsi,%%r10,%%r11,%%r12,%%r13,%%r14\n\t"
+        "SATROW %c[x]+48,%%rbx,%%rcx,%%rsi,%%r10,%%r11,%%r12,%%r13,%%r14,%%r15\n\t"
+        ".purgem SATROW\n\t"
+        "movq %%rcx,%c[t]+0(%%rdi)\n\t"
+        "movq %%rsi,%c[t]+8(%%rdi)\n\t"
+        "movq %%r10,%c[t]+16(%%rdi)\n\t"
+        "movq %%r11,%c[t]+24(%%rdi)\n\t"
+        "movq %%r12,%c[t]+32(%%rdi)\n\t"
+        "movq %%r13,%c[t]+40(%%rdi)\n\t"
+        "movq %%r14,%c[t]+48(%%rdi)\n\t"
+        "movq %%r15,%c[t]+56(%%rdi)\n\t"
+        :
+        : "D"(v),[x] "i"(offsetof(sat_args,x)),[y] "i"(offsetof(sat_args,y)),[p] "i"(offsetof(sat_args,p)),
+          [n0] "i"(offsetof(sat_args,n0)),[t] "i"(offsetof(sat_args,t))
+        : "rax","rdx","r8","r9","r10","r11","r12","r13","r14","r15","rbx","rcx","rsi","cc","memory");
+}
+
+#else
+
+/* SU= 64, coarsely integrated operand scanning */
+SAT_MUL static void sat_redc(sat_args *v)
+{
+    int i,j;
+    unsign64 m,*t=v->t;
+    unsigned __int128 s;
+
+#pragma GCC unroll 16
+    for (j=0; j<SAT_WORDS+2; j++) t[j]=0;
+
+#pragma GCC unroll 16
+    for (i=0; i<SAT_WORDS; i++)
+    {
+        s=0;
+#pragma GCC unroll 16
+        for (j=0; j<SAT_WORDS; j++)
+        {
+            s+=(unsigned __int128)v->x[i]*v->y[j]+t[j];
+            t[j]=(unsign64)s;
+            s>>=64;
+        }
+        s+=t[SAT_WORDS];
+        t[SAT_WORDS]=(unsign64)s;
+        t[SAT_WORDS+1]=(unsign64)(s>>64);
+
+        m=t[0]*v->n0;
+        s=(unsigned __int128)m*v->p[0]+t[0];
+        s>>=64;
+#pragma GCC unroll 16
+        for (j=1; j<SAT_PWORDS; j++)
+        {
+            s+=(unsigned __int128)m*v->p[j]+t[j];
+            t[j-1]=(unsign64)s;
+            s>>=64;
+        }
+#pragma GCC unroll 16
+        for (j=SAT_PWORDS; j<=SAT_WORDS; j++)
+        {
+            s+=t[j];
+            t[j-1]=(unsign64)s;
+            s>>=64;
+        }
+        t[SAT_WORDS]=t[SAT_WORDS+1]+(unsign64)s;
+    }
+}
+
+#endif
+
+/* SU= 256, r=a.b/R mod Modulus, a and b normalised and non-negative */
+SAT_MUL static void sat_mul(BIG r,BIG a,BIG b)
+{
+    int i,o;
+    unsign64 w;
+    sat_args v;
+
+    if (!__atomic_load_n(&sat_done,__ATOMIC_ACQUIRE)) sat_init();
+#pragma GCC unroll 16
+    for (i=0; i<SAT_WORDS; i++) v.p[i]=__atomic_load_n(&sat_p[i],__ATOMIC_RELAXED);
+    v.n0=__atomic_load_n(&sat_n0,__ATOMIC_RELAXED);
+    sat_pack(v.x,a,SAT_SHIFTA);
+    sat_pack(v.y,b,SAT_SHIFTB);
+
+    sat_redc(&v);
+
+    /* unpack t */
+#pragma GCC unroll 16
+    for (i=0; i<NLEN; i++)
+    {
+        o=i*BASEBITS;
+        w=v.t[o/64]>>(o%64);
+        if (o%64!=0) w|=v.t[o/64+1]<<(64-o%64);
+        if (i<NLEN-1) r[i]=(chunk)(w&BMASK);
+        else r[i]=(chunk)(w&0x7fffffffffffffff);
+    }
+}
+
+#endif
+
+#ifdef AMCL_IFMA
+
+/* Eight Montgomery multiplications at once with AVX-512 IFMA. Digit i of the eight operands is gathered
+   into the 64-bit lanes of a vector, and the operands are repacked from BASEBITS-bit digits into IFMA_LIMBS
+   52-bit digits by shifts of whole vectors. The low and high halves of the digit products are accumulated
+   without carries, a digit apart, and the accumulator moves down a digit as each digit of the Montgomery
+   quotient clears its bottom digit. The digits have 12 bits to spare, enough for all the rows. As for the
+   64-bit radix, R'=2^(52*IFMA_LIMBS) and the second operand is shifted up by IFMA_SHIFT, so the results are
+   the same BIGs as FP_mul gives. See Gueron and Krasnov, "Accelerating Big Integer Arithmetic Using Intel
+   IFMA Extensions" */
+
+#define FP_IFMA __attribute__((target("avx512f,avx512ifma")))
+#define IFMA_INLINE __attribute__((target("avx512f,avx512ifma"),always_inline)) inline
+#define IFMA_MASK (((unsign64)1<<52)-1)
+
+/* 1 if the processor supports AVX-512 IFMA */
+static int ifma_supported(void)
+{
+    return CPU_has(CPU_AVX512IFMA);
+}
+
+/* 52-bit digits D of the numbers with BASEBITS-bit digits A, all less than 2^BASEBITS, shifted up by sh bits */
+IFMA_INLINE static void ifma_pack(__m512i *D,const __m512i *A,int sh)
+{
+    int i,k,o;
+    __m512i d;
+    const __m512i mask=_mm512_set1_epi64(IFMA_MASK);
+
+#pragma GCC unroll 16
+    for (k=0; k<IFMA_LIMBS; k++)
+    {
+        d=_mm512_setzero_si512();
+#pragma GCC unroll 16
+        for (i=0; i<NLEN; i++)
+        {
+            o=BASEBITS*i+sh-52*k;
+            if (o>=52 || o+BASEBITS<=0) continue;
+            if (o>=0) d=_mm512_or_si512(d,_mm512_slli_epi64(A[i],o));
+            else d=_mm512_or_si512(d,_mm512_srli_epi64(A[i],-o));
+        }
+        D[k]=_mm512_and_si512(d,mask);
+    }
+}
+
+/* BASEBITS-bit digits A of the numbers with normalised 52-bit digits D */
+IFMA_INLINE static void ifma_unpack(__m512i *A,const __m512i *D)
+{
+    int i,k,o;
+    __m512i d;
+    const __m512i mask=_mm512_set1_epi64(BMASK);
+
+#pragma GCC unroll 16
+    for (i=0; i<NLEN; i++)
+    {
+        d=_mm512_setzero_si512();
+#pragma GCC unroll 16
+        for (k=0; k<IFMA_LIMBS; k++)
+        {
+            o=52*k-BASEBITS*i;
+            if (o>=BASEBITS || o+52<=0) continue;
+            if (o>=0) d=_mm512_or_si512(d,_mm512_slli_epi64(D[k],o));
+            else d=_mm512_or_si512(d,_mm512_srli_epi64(D[k],-o));
+        }
+        A[i]=_mm512_and_si512(d,mask);
+    }
+}
+
+/* SU= 64*(3*IFMA_LIMBS+2*NLEN), r[i]=a[i].b[i]/R mod Modulus for the lanes set, each operand less than
+   2^(BASEBITS*NLEN) and their product less than 2^MBITS.R */
+FP_IFMA static void ifma_mul(BIG r[8],BIG a[8],BIG b[8],__mmask8 lanes)
+{
+    int i,j;
+    __m512i A[NLEN],B[NLEN],X[IFMA_LIMBS],Y[IFMA_LIMBS],P[IFMA_LIMBS],t[IFMA_LIMBS],x,m,c;
+    const __m512i zero=_mm512_setzero_si512();
+    const __m512i mask=_mm512_set1_epi64(IFMA_MASK);
+    const __m512i n0=_mm512_set1_epi64((unsign64)MConst&IFMA_MASK);
+    const __m512i idx=_mm512_set_epi64(7*NLEN,6*NLEN,5*NLEN,4*NLEN,3*NLEN,2*NLEN,NLEN,0);
+
+#pragma GCC unroll 16
+    for (i=0; i<NLEN; i++) A[i]=_mm512_set1_epi64(Modulus[i]);
+    ifma_pack(P,A,0);
+#pragma GCC unroll 16
+    for (i=0; i<NLEN; i++)
+    {
+        A[i]=_mm512_mask_i64gather_epi64(zero,lanes,idx,(const void *)&a[0][i],8);
+        B[i]=_mm512_mask_i64gather_epi64(zero,lanes,idx,(const void *)&b[0][i],8);
+    }
+    ifma_pack(X,A,0);
+    ifma_pack(Y,B,IFMA_SHIFT);
+
+#pragma GCC unroll 16
+    for (j=0; j<IFMA_LIMBS; j++) t[j]=zero;
+
+#pragma GCC unroll 16
+    for (i=0; i<IFMA_LIMBS; i++)
+    {
+        x=X[i];
+#pragma GCC unroll 16
+        for (j=0; j<IFMA_LIMBS; j++) t[j]=_mm512_madd52lo_epu64(t[j],x,Y[j]);
+        m=_mm512_madd52lo_epu64(zero,t[0],n0);
+#pragma GCC unroll 16
+        for (j=0; j<IFMA_LIMBS; j++) t[j]=_mm512_madd52lo_epu64(t[j],m,P[j]);
+
+        /* bottom digit is now zero mod 2^52, move down a digit */
+        c=_mm512_srli_epi64(t[0],52);
+#pragma GCC unroll 16
+        for (j=0; j<IFMA_LIMBS-1; j++) t[j]=t[j+1];
+        t[IFMA_LIMBS-1]=zero;
+        t[0]=_mm512_add_epi64(t[0],c);
+
+#pragma GCC unroll 16
+        for (j=0; j<IFMA_LIMBS; j++)
+        {
+            t[j]=_mm512_madd52hi_epu64(t[j],x,Y[j]);
+            t[j]=_mm512_madd52hi_epu64(t[j],m,P[j]);
+        }
+    }
+
+#pragma GCC unroll 16
+    for (j=0; j<IFMA_LIMBS-1; j++)
+    {
+        t[j+1]=_mm512_add_epi64(t[j+1],_mm512_srli_epi64(t[j],52));
+        t[j]=_mm512_and_si512(t[j],mask);
+    }
+    ifma_unpack(A,t);
+#pragma GCC unroll 16
+    for (i=0; i<NLEN; i++) _mm512_mask_i64scatter_epi64((void *)&r[0][i],lanes,idx,A[i],8);
+}
+
+/* r[i]=a[i].b[i] for eight lanes, or a[i]^2 if sqr. Inputs are reduced or normalised as by FP_mul or FP_sqr.
+   Lanes that are still too large, or negative, are done by FP_mul */
+static void ifma_mul_x8(BIG r[8],BIG a[8],BIG b[8],int sqr)
+{
+    int i;
+    chunk ea,eb;
+    __mmask8 lanes=0;
+
+    for (i=0; i<8; i++)
+    {
+        ea=EXCESS(a[i]);
+        eb=sqr?ea:EXCESS(b[i]);
+        if ((ea+1)>=(FEXCESS-1)/(eb+1)) FP_reduce(a[i]);
+        else BIG_norm(a[i]);
+        if (!sqr) BIG_norm(b[i]);
+        if (a[i][NLEN-1]>=0 && b[i][NLEN-1]>=0 && (EXCESS(a[i])+1)<(FEXCESS-1)/(EXCESS(b[i])+1)) lanes|=1<<i;
+    }
+
+    ifma_mul(r,a,b,lanes);
+    for (i=0; i<8; i++)
+        if (!(lanes&(1<<i))) FP_mul(r[i],a[i],b[i]);
+}
+
+#endif
+
 /* SU= 88, Fast Modular multiplication of two BIGs in n-residue form, mod Modulus */
 void FP_mul(BIG r,BIG a,BIG b)
 {
@@ -432,6 +860,13 @@ void FP_mul(BIG r,BIG a,BIG b)
 #endif
 
     BIG_norm(b);
+#ifdef AMCL_SATURATED
+    if (a[NLEN-1]>=0 && b[NLEN-1]>=0 && sat_supported())
+    {
+        sat_mul(r,a,b);
+        return;
+    }
+#endif
     BIG_mul(d,a,b);
     FP_mod(r,d);
 }
@@ -496,10 +931,45 @@ void FP_sqr(BIG r,BIG a)
     }
 #endif
 
+#ifdef AMCL_SATURATED
+    if (a[NLEN-1]>=0 && sat_supported())
+    {
+        sat_mul(r,a,a);
+        return;
+    }
+#endif
     BIG_sqr(d,a);
     FP_mod(r,d);
 }
 
+/* Eight independent modular multiplications */
+void FP_mul_x8(BIG r[8],BIG a[8],BIG b[8])
+{
+    int i;
+#ifdef AMCL_IFMA
+    if (ifma_supported())
+    {
+        ifma_mul_x8(r,a,b,0);
+        return;
+    }
+#endif
+    for (i=0; i<8; i++) FP_mul(r[i],a[i],b[i]);
+}
+
+/* Eight independent modular squarings */
+void FP_sqr_x8(BIG r[8],BIG a[8])
+{
+    int i;
+#ifdef AMCL_IFMA
+    if (ifma_supported())
+    {
+        ifma_mul_x8(r,a,a,1);
+        return;
+    }
+#endif
+    for (i=0; i<8; i++) FP_sqr(r[i],a[i]);
+}
+
 /* SU= 16, Modular addition of two BIGs in n-residue form, mod Modulus */
 void FP_add(BIG r,BIG a,BIG b)
 {
@@ -527,6 +997,20 @@ void FP_sub(BIG r,BIG a,BIG b)
     FP_add(r,a,n);
 }
 
+/* Eight independent modular additions */
+void FP_add_x8(BIG r[8],BIG a[8],BIG b[8])
+{
+    int i;
+    for (i=0; i<8; i++) FP_add(r[i],a[i],b[i]);
+}
+
+/* Eight independent modular subtractions */
+void FP_sub_x8(BIG r[8],BIG a[8],BIG b[8])
+{
+    int i;
+    for (i=0; i<8; i++) FP_sub(r[i],a[i],b[i]);
+}
+
 /* SU= 48, Reduces possibly unreduced BIG mod Modulus */
 void FP_reduce(BIG a)
 {
@@ -589,18 +1073,70 @@ void FP_inv(BIG w,BIG x)
     BIG m;
     BIG_rcopy(m,Modulus);
     BIG_copy(w,x);
-    FP_redc(w);
 
+    /* 1/(x.R)=(1/x)/R, so two conversions give (1/x).R */
     BIG_invmodp(w,w,m);
+#if MODTYPE == NOT_SPECIAL || MODTYPE == MONTGOMERY_FRIENDLY
     FP_nres(w);
+    FP_nres(w);
+#endif
+}
+
+/* 1 if x=0 mod Modulus, else 0, in constant time. x is reduced */
+static int FP_ctzilch(BIG x)
+{
+    int i;
+    chunk d=0;
+    BIG m;
+    BIG_rcopy(m,Modulus);
+    BIG_mod_ct(x,m);
+    for (i=0; i<NLEN; i++) d|=x[i];
+    return 1-(int)(((d|-d)>>(CHUNK-1))&1);
+}
+
+/* Modular inverses of n BIGs in n-residue form, with one inversion by Montgomery's trick, in constant time for a
+   given n */
+void FP_inv_batch(int n,BIG w[],BIG x[])
+{
+    int i,z;
+    BIG t,s,one,zero;
+    if (n<=0) return;
+    FP_one(one);
+    BIG_zero(zero);
+
+    /* w[i]=x[0]..x[i-1], with 1 in place of any zero */
+    BIG_copy(t,one);
+    for (i=0; i<n; i++)
+    {
+        BIG_copy(w[i],t);
+        BIG_copy(s,x[i]);
+        BIG_cmove(s,one,FP_ctzilch(s));
+        FP_mul(t,t,s);
+    }
+    FP_inv(t,t);
+
+    /* t=1/(x[0]..x[i]) going down, so w[i].t=1/x[i] */
+    for (i=n-1; i>=0; i--)
+    {
+        BIG_copy(s,x[i]);
+        z=FP_ctzilch(s);
+        BIG_cmove(s,one,z);
+        FP_mul(w[i],w[i],t);
+        FP_mul(t,t,s);
+        BIG_cmove(w[i],zero,z);
+    }
 }
 
 /* SU=8 */
 /* set n=1 */
 void FP_one(BIG n)
 {
+#if MODTYPE == NOT_SPECIAL || MODTYPE == MONTGOMERY_FRIENDLY
+    BIG_rcopy(n,Rmodp);
+#else
     BIG_one(n);
     FP_nres(n);
+#endif
 }
 
 /* SU= 136, Fast Modular exponentiation of a BIG in n-residue form, to the power of a BIG, mod Modulus */
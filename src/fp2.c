@@ -261,6 +261,51 @@ void FP2_inv(FP2 *w,FP2 *x)
 //	FP2_norm(w);
 }
 
+/* 1 if x=0, else 0, in constant time. x is reduced */
+static int FP2_ctzilch(FP2 *x)
+{
+    int i;
+    chunk d=0;
+    BIG m;
+    BIG_rcopy(m,Modulus);
+    BIG_mod_ct(x->a,m);
+    BIG_mod_ct(x->b,m);
+    for (i=0; i<NLEN; i++) d|=x->a[i]|x->b[i];
+    return 1-(int)(((d|-d)>>(CHUNK-1))&1);
+}
+
+/* Inverting n FP2s, with one inversion by Montgomery's trick, in constant time for a given n */
+void FP2_inv_batch(int n,FP2 w[],FP2 x[])
+{
+    int i,z;
+    FP2 t,s,one,zero;
+    if (n<=0) return;
+    FP2_one(&one);
+    FP2_zero(&zero);
+
+    /* w[i]=x[0]..x[i-1], with 1 in place of any zero */
+    FP2_copy(&t,&one);
+    for (i=0; i<n; i++)
+    {
+        FP2_copy(&w[i],&t);
+        FP2_copy(&s,&x[i]);
+        FP2_cmove(&s,&one,FP2_ctzilch(&s));
+        FP2_mul(&t,&t,&s);
+    }
+    FP2_inv(&t,&t);
+
+    /* t=1/(x[0]..x[i]) going down, so w[i].t=1/x[i] */
+    for (i=n-1; i>=0; i--)
+    {
+        FP2_copy(&s,&x[i]);
+        z=FP2_ctzilch(&s);
+        FP2_cmove(&s,&one,z);
+        FP2_mul(&w[i],&w[i],&t);
+        FP2_mul(&t,&t,&s);
+        FP2_cmove(&w[i],&zero,z);
+    }
+}
+
 /* SU= 16, Divide an FP2 by 2 */
 void FP2_div2(FP2 *w,FP2 *x)
 {
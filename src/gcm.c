@@ -54,6 +54,13 @@
 #define NB 4
 #define MR_TOBYTE(x) ((uchar)((x)))
 
+#define GCM_CHUNK 8 /* blocks of ciphertext hashed together */
+
+#ifdef AMCL_X86_64
+#include <wmmintrin.h>
+#include <tmmintrin.h>
+#endif
+
 /* pack bytes into a 32-bit Word */
 static unsign32 pack(const uchar *b)
 {
@@ -69,51 +76,411 @@ static void unpack(unsign32 a,uchar *b)
     b[0]=MR_TOBYTE(a>>24);
 }
 
-/* precompute small 2k bytes gf2m table of x^n.H */
-static void precompute(gcm *g,uchar *H)
+/* add len bytes to 64-bit length counter */
+static void addlen(unsign32 *L,size_t len)
 {
-    int i,j;
-    unsign32 *last,*next,b;
+    unsign64 t=(((unsign64)L[0]<<32)|L[1])+(unsign64)len;
+    L[0]=(unsign32)(t>>32);
+    L[1]=(unsign32)t;
+}
+
+/* key in use */
+static const gcm_key *GCM_key(const gcm *g)
+{
+    if (g->K==NULL) return &(g->key);
+    return g->K;
+}
+
+/* table of key in use, or NULL */
+static const unsign64 *GCM_table(const gcm *g)
+{
+    return GCM_key(g)->table;
+}
+
+/* Portable GHASH. Field elements are held as two 64-bit words, with the most significant bit of
+   the first word the coefficient of x^0, so multiplication by x is a right shift.
+
+   Without a table X.H is accumulated a bit at a time, using masks so that it takes the same time for
+   all data.
+
+   Otherwise Shoup's method is used, with table[i]=i.H for all 4-bit or 8-bit digits i. The product
+   is accumulated a digit at a time from the end of X, multiplying by x^4 or x^8 in between, and folding
+   the bits shifted off the end back in with REM. Table lookups depend on secret data, so the tables
+   are only used when selected by the caller */
+
+/* REM8[r]<<48 is the reduction of r.x^128 */
+static const unsign32 REM8[256]=
+{
+    0x0000,0x01C2,0x0384,0x0246,0x0708,0x06CA,0x048C,0x054E,
+    0x0E10,0x0FD2,0x0D94,0x0C56,0x0918,0x08DA,0x0A9C,0x0B5E,
+    0x1C20,0x1DE2,0x1FA4,0x1E66,0x1B28,0x1AEA,0x18AC,0x196E,
+    0x1230,0x13F2,0x11B4,0x1076,0x1538,0x14FA,0x16BC,0x177E,
+    0x3840,0x3982,0x3BC4,0x3A06,0x3F48,0x3E8A,0x3CCC,0x3D0E,
+    0x3650,0x3792,0x35D4,0x3416,0x3158,0x309A,0x32DC,0x331E,
+    0x2460,0x25A2,0x27E4,0x2626,0x2368,0x22AA,0x20EC,0x212E,
+    0x2A70,0x2BB2,0x29F4,0x2836,0x2D78,0x2CBA,0x2EFC,0x2F3E,
+    0x7080,0x7142,0x7304,0x72C6,0x7788,0x764A,0x740C,0x75CE,
+    0x7E90,0x7F52,0x7D14,0x7CD6,0x7998,0x785A,0x7A1C,0x7BDE,
+    0x6CA0,0x6D62,0x6F24,0x6EE6,0x6BA8,0x6A6A,0x682C,0x69EE,
+    0x62B0,0x6372,0x6134,0x60F6,0x65B8,0x647A,0x663C,0x67FE,
+    0x48C0,0x4902,0x4B44,0x4A86,0x4FC8,0x4E0A,0x4C4C,0x4D8E,
+    0x46D0,0x4712,0x4554,0x4496,0x41D8,0x401A,0x425C,0x439E,
+    0x54E0,0x5522,0x5764,0x56A6,0x53E8,0x522A,0x506C,0x51AE,
+    0x5AF0,0x5B32,0x5974,0x58B6,0x5DF8,0x5C3A,0x5E7C,0x5FBE,
+    0xE100,0xE0C2,0xE284,0xE346,0xE608,0xE7CA,0xE58C,0xE44E,
+    0xEF10,0xEED2,0xEC94,0xED56,0xE818,0xE9DA,0xEB9C,0xEA5E,
+    0xFD20,0xFCE2,0xFEA4,0xFF66,0xFA28,0xFBEA,0xF9AC,0xF86E,
+    0xF330,0xF2F2,0xF0B4,0xF176,0xF438,0xF5FA,0xF7BC,0xF67E,
+    0xD940,0xD882,0xDAC4,0xDB06,0xDE48,0xDF8A,0xDDCC,0xDC0E,
+    0xD750,0xD692,0xD4D4,0xD516,0xD058,0xD19A,0xD3DC,0xD21E,
+    0xC560,0xC4A2,0xC6E4,0xC726,0xC268,0xC3AA,0xC1EC,0xC02E,
+    0xCB70,0xCAB2,0xC8F4,0xC936,0xCC78,0xCDBA,0xCFFC,0xCE3E,
+    0x9180,0x9042,0x9204,0x93C6,0x9688,0x974A,0x950C,0x94CE,
+    0x9F90,0x9E52,0x9C14,0x9DD6,0x9898,0x995A,0x9B1C,0x9ADE,
+    0x8DA0,0x8C62,0x8E24,0x8FE6,0x8AA8,0x8B6A,0x892C,0x88EE,
+    0x83B0,0x8272,0x8034,0x81F6,0x84B8,0x857A,0x873C,0x86FE,
+    0xA9C0,0xA802,0xAA44,0xAB86,0xAEC8,0xAF0A,0xAD4C,0xAC8E,
+    0xA7D0,0xA612,0xA454,0xA596,0xA0D8,0xA11A,0xA35C,0xA29E,
+    0xB5E0,0xB422,0xB664,0xB7A6,0xB2E8,0xB32A,0xB16C,0xB0AE,
+    0xBBF0,0xBA32,0xB874,0xB9B6,0xBCF8,0xBD3A,0xBF7C,0xBEBE
+};
+
+static const unsign32 REM4[16]=
+{
+    0x0000,0x1C20,0x3840,0x2460,0x7080,0x6CA0,0x48C0,0x54E0,
+    0xE100,0xFD20,0xD940,0xC560,0x9180,0x8DA0,0xA9C0,0xB5E0
+};
+
+/* load X as two words */
+static void gf2load(const uchar *X,unsign64 *zh,unsign64 *zl)
+{
+    *zh=((unsign64)pack(&X[0])<<32)|pack(&X[4]);
+    *zl=((unsign64)pack(&X[8])<<32)|pack(&X[12]);
+}
+
+/* store two words in X */
+static void gf2store(uchar *X,unsign64 zh,unsign64 zl)
+{
+    unpack((unsign32)(zh>>32),&X[0]);
+    unpack((unsign32)zh,&X[4]);
+    unpack((unsign32)(zl>>32),&X[8]);
+    unpack((unsign32)zl,&X[12]);
+}
+
+/* T[i]=i.H for all digits i of 2^bits */
+static void precompute_table(const gcm_key *K,unsign64 *T,int bits)
+{
+    int i,j,k;
+    unsign64 *last,*next;
+
+    k=1<<(bits-1);
+    T[0]=T[1]=0;
+    T[2*k]=K->H[0];
+    T[2*k+1]=K->H[1];
+
+    for (i=k>>1; i>0; i>>=1)
+    {
+        /* T[i]=T[2i].x */
+        next=&T[2*i];
+        last=&T[4*i];
+        next[1]=(last[1]>>1)|(last[0]<<63);
+        next[0]=last[0]>>1;
+        if (last[1]&1) next[0]^=(unsign64)0xE1<<56; /* irreducible polynomial */
+    }
+    for (i=2; i<(1<<bits); i<<=1)
+        for (j=1; j<i; j++)
+            for (k=0; k<2; k++) T[2*(i+j)+k]=T[2*i+k]^T[2*j+k];
+}
+
+/* X=(X+B_i).H for n blocks B, without a table */
+static void ghash_bits(const gcm_key *K,uchar *X,const uchar *B,int n)
+{
+    int i;
+    unsign64 xh,xl,zh,zl,vh,vl,m;
+
+    gf2load(X,&xh,&xl);
+    for (; n>0; n--,B+=16)
+    {
+        gf2load(B,&zh,&zl);
+        xh^=zh;
+        xl^=zl;
+        zh=zl=0;
+        vh=K->H[0];
+        vl=K->H[1];
+        for (i=0; i<128; i++)
+        {
+            m=(unsign64)0-(((i<64?xh:xl)>>(63-(i&63)))&1);
+            zh^=vh&m;
+            zl^=vl&m;
+            m=(unsign64)0-(vl&1);
+            vl=(vl>>1)|(vh<<63);
+            vh=(vh>>1)^(((unsign64)0xE1<<56)&m);
+        }
+        xh=zh;
+        xl=zl;
+    }
+    gf2store(X,xh,xl);
+}
+
+/* Z=Z.x^4+T[d] */
+static void shoup4(const unsign64 *T,unsign64 *zh,unsign64 *zl,int d)
+{
+    unsign32 r=(unsign32)(*zl)&0xf;
+    *zl=(*zl>>4)|(*zh<<60);
+    *zh=(*zh>>4)^((unsign64)REM4[r]<<48);
+    *zh^=T[2*d];
+    *zl^=T[2*d+1];
+}
+
+/* Z=Z.x^8+T[d] */
+static void shoup8(const unsign64 *T,unsign64 *zh,unsign64 *zl,int d)
+{
+    unsign32 r=(unsign32)(*zl)&0xff;
+    *zl=(*zl>>8)|(*zh<<56);
+    *zh=(*zh>>8)^((unsign64)REM8[r]<<48);
+    *zh^=T[2*d];
+    *zl^=T[2*d+1];
+}
+
+/* X=(X+B_i).H for n blocks B, with a 4-bit or 8-bit table */
+static void ghash_table(const gcm_key *K,const unsign64 *T,uchar *S,const uchar *B,int n)
+{
+    int i;
+    uchar X[16];
+    unsign64 zh,zl;
+
+    for (i=0; i<16; i++) X[i]=S[i];
+    for (; n>0; n--,B+=16)
+    {
+        for (i=0; i<16; i++) X[i]^=B[i];
+        zh=zl=0;
+        if (K->ghash==GCM_GHASH_TABLE8)
+        {
+            for (i=15; i>=0; i--) shoup8(T,&zh,&zl,X[i]);
+        }
+        else
+        {
+            /* low digit of each byte first */
+            for (i=31; i>=0; i--) shoup4(T,&zh,&zl,(i&1)?(X[i>>1]&0xf):(X[i>>1]>>4));
+        }
+        gf2store(X,zh,zl);
+    }
+    for (i=0; i<16; i++) S[i]=X[i];
+}
+
+#ifdef AMCL_X86_64
+
+/* Carry-less multiply GHASH. Field elements are held byte reversed, so that the bit reflected GCM
+   polynomials can be multiplied with PCLMULQDQ and shifted left one place before reduction.
+   GCM_CHUNK blocks are multiplied by decreasing powers of H and summed before a single reduction.
+   The powers are cached in the table if there is room, otherwise found as needed.
+   See Gueron and Kounavis, "Intel Carry-Less Multiplication Instruction and its Usage for Computing the GCM Mode" */
+
+#define GCM_CLMUL __attribute__((target("pclmul,ssse3")))
+
+/* 1 if the processor supports PCLMULQDQ */
+static int clmul_supported(void)
+{
+    return CPU_has(CPU_PCLMUL);
+}
+
+GCM_CLMUL static __m128i clmul_rev(__m128i x)
+{
+    const __m128i rev=_mm_set_epi8(0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15);
+    return _mm_shuffle_epi8(x,rev);
+}
+
+GCM_CLMUL static __m128i clmul_load(const uchar *b)
+{
+    return clmul_rev(_mm_loadu_si128((const __m128i *)b));
+}
+
+GCM_CLMUL static void clmul_store(uchar *b,__m128i x)
+{
+    _mm_storeu_si128((__m128i *)b,clmul_rev(x));
+}
+
+/* (hi,lo)+=a.b, unreduced 256-bit product */
+GCM_CLMUL static void clmul_acc(__m128i a,__m128i b,__m128i *lo,__m128i *hi)
+{
+    __m128i m;
+    *lo=_mm_xor_si128(*lo,_mm_clmulepi64_si128(a,b,0x00));
+    *hi=_mm_xor_si128(*hi,_mm_clmulepi64_si128(a,b,0x11));
+    m=_mm_xor_si128(_mm_clmulepi64_si128(a,b,0x10),_mm_clmulepi64_si128(a,b,0x01));
+    *lo=_mm_xor_si128(*lo,_mm_slli_si128(m,8));
+    *hi=_mm_xor_si128(*hi,_mm_srli_si128(m,8));
+}
+
+/* reduce (hi,lo).x mod x^128+x^7+x^2+x+1 */
+GCM_CLMUL static __m128i clmul_reduce(__m128i lo,__m128i hi)
+{
+    __m128i t,u,v;
+
+    /* shift left one place */
+    t=_mm_srli_epi32(lo,31);
+    u=_mm_srli_epi32(hi,31);
+    lo=_mm_slli_epi32(lo,1);
+    hi=_mm_slli_epi32(hi,1);
+    v=_mm_srli_si128(t,12);
+    u=_mm_slli_si128(u,4);
+    t=_mm_slli_si128(t,4);
+    lo=_mm_or_si128(lo,t);
+    hi=_mm_or_si128(hi,u);
+    hi=_mm_or_si128(hi,v);
+
+    /* reduce */
+    t=_mm_xor_si128(_mm_slli_epi32(lo,31),_mm_slli_epi32(lo,30));
+    t=_mm_xor_si128(t,_mm_slli_epi32(lo,25));
+    u=_mm_srli_si128(t,4);
+    t=_mm_slli_si128(t,12);
+    lo=_mm_xor_si128(lo,t);
+    v=_mm_xor_si128(_mm_srli_epi32(lo,1),_mm_srli_epi32(lo,2));
+    v=_mm_xor_si128(v,_mm_srli_epi32(lo,7));
+    v=_mm_xor_si128(v,u);
+    lo=_mm_xor_si128(lo,v);
+    return _mm_xor_si128(hi,lo);
+}
 
-    for (i=j=0; i<NB; i++,j+=4) g->table[0][i]=pack((uchar *)&H[j]);
+/* P[i]=H^(i+1) for i<m, from T if cached there */
+GCM_CLMUL static void clmul_powers(const gcm_key *K,const unsign64 *T,__m128i *P,int m)
+{
+    int i;
+    __m128i lo,hi;
 
-    for (i=1; i<128; i++)
+    if (K->size<GCM_CLMUL_SIZE) T=NULL;
+    P[0]=_mm_set_epi64x((long long)K->H[0],(long long)K->H[1]);
+    for (i=1; i<m; i++)
     {
-        next=g->table[i];
-        last=g->table[i-1];
-        b=0;
-        for (j=0; j<NB; j++)
+        if (T!=NULL)
         {
-            next[j]=b|(last[j])>>1;
-            b=last[j]<<31;
+            P[i]=_mm_loadu_si128((const __m128i *)&T[2*i]);
+            continue;
         }
-        if (b) next[0]^=0xE1000000; /* irreducible polynomial */
+        lo=hi=_mm_setzero_si128();
+        clmul_acc(P[i-1],P[0],&lo,&hi);
+        P[i]=clmul_reduce(lo,hi);
+    }
+}
+
+/* cache powers of H in T */
+GCM_CLMUL static void precompute_clmul(const gcm_key *K,unsign64 *T)
+{
+    int i;
+    __m128i P[GCM_CLMUL_SIZE];
+
+    clmul_powers(K,NULL,P,GCM_CLMUL_SIZE);
+    for (i=0; i<GCM_CLMUL_SIZE; i++) _mm_storeu_si128((__m128i *)&T[2*i],P[i]);
+}
+
+/* X=(X+B_i).H for n blocks B */
+GCM_CLMUL static void ghash_clmul(const gcm_key *K,const unsign64 *T,uchar *X,const uchar *B,int n)
+{
+    int i;
+    __m128i P[GCM_CHUNK],x,lo,hi;
+
+    clmul_powers(K,T,P,(n>=GCM_CHUNK)?GCM_CHUNK:1);
+    x=clmul_load(X);
+    for (; n>=GCM_CHUNK; n-=GCM_CHUNK,B+=16*GCM_CHUNK)
+    {
+        lo=hi=_mm_setzero_si128();
+        x=_mm_xor_si128(x,clmul_load(B));
+        clmul_acc(x,P[GCM_CHUNK-1],&lo,&hi);
+        for (i=1; i<GCM_CHUNK; i++)
+            clmul_acc(clmul_load(&B[16*i]),P[GCM_CHUNK-1-i],&lo,&hi);
+        x=clmul_reduce(lo,hi);
+    }
+    for (; n>0; n--,B+=16)
+    {
+        lo=hi=_mm_setzero_si128();
+        x=_mm_xor_si128(x,clmul_load(B));
+        clmul_acc(x,P[0],&lo,&hi);
+        x=clmul_reduce(lo,hi);
     }
+    clmul_store(X,x);
 }
 
-/* SU= 32, gf2m mul - Z=H*X mod 2^128 */
-static void gf2mul(gcm *g)
+/* Counter mode encryption of n whole blocks fused with GHASH of the ciphertext, using AES-NI.
+   The counter is held byte reversed, so that its last 32 bits can be incremented with PADDD */
+
+#define GCM_FUSED __attribute__((target("aes,pclmul,ssse3")))
+
+/* 1 if the processor supports AES-NI as well as PCLMULQDQ */
+static int fused_supported(void)
 {
-    int i,j,m,k;
-    unsign32 P[4];
-    unsign32 b;
+    return CPU_has(CPU_AES);
+}
 
-    P[0]=P[1]=P[2]=P[3]=0;
-    j=8;
-    m=0;
-    for (i=0; i<128; i++)
+GCM_FUSED static void gcm_fused(gcm *g,uchar *out,const uchar *in,size_t n,int mode)
+{
+    const gcm_key *key=GCM_key(g);
+    int i,j,nr=key->e.Nr;
+    __m128i K[15],H[GCM_CHUNK],C[GCM_CHUNK],ctr,one,x,y,lo,hi;
+
+    for (i=0; i<=nr; i++) K[i]=_mm_loadu_si128((const __m128i *)&key->e.fkey[NB*i]);
+    clmul_powers(key,GCM_table(g),C,GCM_CHUNK);
+    for (i=0; i<GCM_CHUNK; i++) H[i]=C[GCM_CHUNK-1-i];
+    ctr=clmul_load(g->ctr);
+    one=_mm_set_epi32(0,0,0,1);
+    x=clmul_load(g->stateX);
+
+    for (; n>=GCM_CHUNK; n-=GCM_CHUNK,in+=16*GCM_CHUNK,out+=16*GCM_CHUNK)
     {
-        b=(unsign32)(g->stateX[m]>>(--j))&1;
-        b=~b+1;
-        for (k=0; k<NB; k++) P[k]^=(g->table[i][k]&b);
-        if (j==0)
+        for (j=0; j<GCM_CHUNK; j++)
+        {
+            ctr=_mm_add_epi32(ctr,one);
+            C[j]=_mm_xor_si128(clmul_rev(ctr),K[0]);
+        }
+        for (i=1; i<nr; i++)
+            for (j=0; j<GCM_CHUNK; j++) C[j]=_mm_aesenc_si128(C[j],K[i]);
+
+        lo=hi=_mm_setzero_si128();
+        for (j=0; j<GCM_CHUNK; j++)
         {
-            j=8;
-            m++;
-            if (m==16) break;
+            y=_mm_loadu_si128((const __m128i *)&in[16*j]);
+            C[j]=_mm_xor_si128(_mm_aesenclast_si128(C[j],K[nr]),y);
+            if (mode==GCM_ENCRYPTING) y=C[j];
+            y=clmul_rev(y);
+            if (j==0) y=_mm_xor_si128(y,x);
+            clmul_acc(y,H[j],&lo,&hi);
+            _mm_storeu_si128((__m128i *)&out[16*j],C[j]);
         }
+        x=clmul_reduce(lo,hi);
     }
-    for (i=j=0; i<NB; i++,j+=4) unpack(P[i],(uchar *)&g->stateX[j]);
+    clmul_store(g->stateX,x);
+    clmul_store(g->ctr,ctr);
+}
+
+#endif
+
+/* Hash n whole blocks into the state */
+static void ghash(gcm *g,const uchar *B,int n)
+{
+    const gcm_key *K=GCM_key(g);
+    switch (K->ghash)
+    {
+#ifdef AMCL_X86_64
+    case GCM_GHASH_CLMUL:
+        ghash_clmul(K,GCM_table(g),g->stateX,B,n);
+        return;
+#endif
+    case GCM_GHASH_TABLE4:
+    case GCM_GHASH_TABLE8:
+        ghash_table(K,GCM_table(g),g->stateX,B,n);
+        return;
+    default:
+        ghash_bits(K,g->stateX,B,n);
+        return;
+    }
+}
+
+/* Hash a final partial block, padded with zeros */
+static void ghash_partial(gcm *g,const uchar *b,int len)
+{
+    int i;
+    uchar B[16];
+    for (i=0; i<16; i++) B[i]=0;
+    for (i=0; i<len; i++) B[i]=b[i];
+    ghash(g,B,1);
 }
 
 /* SU= 32, Finish off GHASH */
@@ -130,52 +497,111 @@ static void GCM_wrap(gcm *g)
     F[3]=g->lenC[1]<<3;
     for (i=j=0; i<NB; i++,j+=4) unpack(F[i],(uchar *)&L[j]);
 
-    for (i=0; i<16; i++) g->stateX[i]^=L[i];
-    gf2mul(g);
+    ghash(g,L,1);
 }
 
 static int GCM_ghash(gcm *g,char *plain,int len)
 {
-    int i,j=0;
+    int n=len/16;
     if (g->status==GCM_ACCEPTING_HEADER) g->status=GCM_ACCEPTING_CIPHER;
     if (g->status!=GCM_ACCEPTING_CIPHER) return 0;
 
-    while (j<len)
+    ghash(g,(uchar *)plain,n);
+    if (len%16!=0)
     {
-        for (i=0; i<16 && j<len; i++)
-        {
-            g->stateX[i]^=plain[j++];
-            g->lenC[1]++;
-            if (g->lenC[1]==0) g->lenC[0]++;
-        }
-        gf2mul(g);
+        ghash_partial(g,(uchar *)&plain[16*n],len%16);
+        g->status=GCM_NOT_ACCEPTING_MORE;
     }
-    if (len%16!=0) g->status=GCM_NOT_ACCEPTING_MORE;
+    addlen(g->lenC,len);
     return 1;
 }
 
-/* SU= 48, Initialise an instance of AES-GCM mode */
-void GCM_init(gcm* g,int nk,char *key,int niv,char *iv)
+/* Select GHASH backend, with table T of size entries */
+static int GCM_key_ghash(gcm_key *K,unsign64 *T,int size,int b)
 {
-    /* iv size niv is usually 12 bytes (96 bits). AES key size nk can be 16,24 or 32 bytes */
-    int i;
-    uchar H[16];
-    for (i=0; i<16; i++)
+    switch (b)
     {
-        H[i]=0;
-        g->stateX[i]=0;
+    case GCM_GHASH_BITS:
+        break;
+    case GCM_GHASH_TABLE4:
+        if (size<GCM_TABLE4_SIZE) return 0;
+        precompute_table(K,T,4);
+        break;
+    case GCM_GHASH_TABLE8:
+        if (size<GCM_TABLE8_SIZE) return 0;
+        precompute_table(K,T,8);
+        break;
+#ifdef AMCL_X86_64
+    case GCM_GHASH_CLMUL:
+        if (!clmul_supported()) return 0;
+        if (size>=GCM_CLMUL_SIZE) precompute_clmul(K,T);
+        break;
+#endif
+    default:
+        return 0;
     }
+    K->ghash=b;
+    return 1;
+}
+
+/* Select GHASH backend */
+int GCM_key_set_ghash(gcm_key *K,int b)
+{
+    return GCM_key_ghash(K,K->table,K->size,b);
+}
+
+/* SU= 40, Set up key schedule and GHASH table */
+int GCM_key_init(gcm_key *K,int nk,char *key,unsign64 *T,int size)
+{
+    /* AES key size nk can be 16,24 or 32 bytes */
+    uchar H[16];
+    int i;
 
-    AES_init(&(g->a),ECB,nk,key,iv);
-    AES_ecb_encrypt(&(g->a),H);     /* E(K,0) */
-    precompute(g,H);
+    if (!AES_enc_init(&(K->e),nk,key)) return 0;
+    for (i=0; i<16; i++) H[i]=0;
+    AES_enc_blocks(&(K->e),H,1);     /* E(K,0) */
+    gf2load(H,&(K->H[0]),&(K->H[1]));
+
+    if (T==NULL) size=0;
+    K->table=T;
+    K->size=size;
+    /* constant time by default. The Shoup tables leak through the cache, so must be selected */
+    if (!GCM_key_set_ghash(K,GCM_GHASH_CLMUL))
+        GCM_key_set_ghash(K,GCM_GHASH_BITS);
+    return 1;
+}
+
+/* Clean up key */
+void GCM_key_end(gcm_key *K)
+{
+    int i;
+    for (i=0; i<2*K->size; i++) K->table[i]=0;
+    K->H[0]=K->H[1]=0;
+    AES_enc_end(&(K->e));
+}
+
+/* Select GHASH backend of own key */
+int GCM_set_ghash(gcm *g,int b)
+{
+    if (g->K!=NULL) return 0;
+    return GCM_key_set_ghash(&(g->key),b);
+}
+
+/* SU= 48, Start a message */
+void GCM_start(gcm *g,const gcm_key *K,int niv,char *iv)
+{
+    /* iv size niv is usually 12 bytes (96 bits) */
+    int i;
+    g->K=K;
+    if (K==&(g->key)) g->K=NULL;
+    for (i=0; i<16; i++) g->stateX[i]=g->ctr[i]=0;
 
     g->lenA[0]=g->lenC[0]=g->lenA[1]=g->lenC[1]=0;
     if (niv==12)
     {
-        for (i=0; i<12; i++) g->a.f[i]=iv[i];
-        unpack((unsign32)1,(uchar *)&(g->a.f[12]));  /* initialise IV */
-        for (i=0; i<16; i++) g->Y_0[i]=g->a.f[i];
+        for (i=0; i<12; i++) g->ctr[i]=iv[i];
+        unpack((unsign32)1,&(g->ctr[12]));  /* initialise IV */
+        for (i=0; i<16; i++) g->Y_0[i]=g->ctr[i];
     }
     else
     {
@@ -184,8 +610,8 @@ void GCM_init(gcm* g,int nk,char *key,int niv,char *iv)
         GCM_wrap(g);
         for (i=0; i<16; i++)
         {
-            g->a.f[i]=g->stateX[i];
-            g->Y_0[i]=g->a.f[i];
+            g->ctr[i]=g->stateX[i];
+            g->Y_0[i]=g->ctr[i];
             g->stateX[i]=0;
         }
         g->lenA[0]=g->lenC[0]=g->lenA[1]=g->lenC[1]=0;
@@ -193,90 +619,122 @@ void GCM_init(gcm* g,int nk,char *key,int niv,char *iv)
     g->status=GCM_ACCEPTING_HEADER;
 }
 
+/* Initialise an instance of AES-GCM mode */
+void GCM_init(gcm* g,int nk,char *key,int niv,char *iv)
+{
+    /* iv size niv is usually 12 bytes (96 bits). AES key size nk can be 16,24 or 32 bytes */
+    GCM_key_init(&(g->key),nk,key,NULL,0);
+    GCM_start(g,&(g->key),niv,iv);
+}
+
 /* SU= 24, Add header (material to be authenticated but not encrypted) */
 int GCM_add_header(gcm* g,char *header,int len)
 {
     /* Add some header. Won't be encrypted, but will be authenticated. len is length of header */
-    int i,j=0;
+    int n=len/16;
     if (g->status!=GCM_ACCEPTING_HEADER) return 0;
 
-    while (j<len)
+    ghash(g,(uchar *)header,n);
+    if (len%16!=0)
     {
-        for (i=0; i<16 && j<len; i++)
-        {
-            g->stateX[i]^=header[j++];
-            g->lenA[1]++;
-            if (g->lenA[1]==0) g->lenA[0]++;
-        }
-        gf2mul(g);
+        ghash_partial(g,(uchar *)&header[16*n],len%16);
+        g->status=GCM_ACCEPTING_CIPHER;
     }
-    if (len%16!=0) g->status=GCM_ACCEPTING_CIPHER;
+    addlen(g->lenA,len);
     return 1;
 }
 
-/* SU= 48, Add plaintext and extract ciphertext */
-int GCM_add_plain(gcm *g,char *cipher,char *plain,int len)
+/* Counter mode key stream for the next len<=16*GCM_CHUNK bytes */
+static void GCM_keystream(gcm *g,uchar *B,int len)
 {
-    /* Add plaintext to extract ciphertext, len is length of plaintext.  */
-    int i,j=0;
+    int i,m;
     unsign32 counter;
-    uchar B[16];
-    if (g->status==GCM_ACCEPTING_HEADER) g->status=GCM_ACCEPTING_CIPHER;
-    if (g->status!=GCM_ACCEPTING_CIPHER) return 0;
 
-    while (j<len)
+    for (m=0; 16*m<len; m++)
     {
-        counter=pack((uchar *)&(g->a.f[12]));
+        counter=pack(&(g->ctr[12]));
         counter++;
-        unpack(counter,(uchar *)&(g->a.f[12]));  /* increment counter */
-        for (i=0; i<16; i++) B[i]=g->a.f[i];
-        AES_ecb_encrypt(&(g->a),B);        /* encrypt it  */
+        unpack(counter,&(g->ctr[12]));  /* increment counter */
+        for (i=0; i<16; i++) B[16*m+i]=g->ctr[i];
+    }
+    AES_enc_blocks(&(GCM_key(g)->e),B,m);        /* encrypt them  */
+}
+
+/* Encrypt or decrypt len bytes, hashing the ciphertext */
+static void GCM_crypt(gcm *g,char *out,const char *in,size_t len,int mode)
+{
+    size_t i,j,k;
+    uchar B[16*GCM_CHUNK];
+
+#ifdef AMCL_X86_64
+    if (GCM_key(g)->ghash==GCM_GHASH_CLMUL && fused_supported())
+    {
+        k=len-len%(16*GCM_CHUNK);
+        gcm_fused(g,(uchar *)out,(const uchar *)in,k/16,mode);
+        out+=k;
+        in+=k;
+        len-=k;
+    }
+#endif
+    for (j=0; j<len; j+=k)
+    {
+        k=len-j;
+        if (k>16*GCM_CHUNK) k=16*GCM_CHUNK;
+
+        /* hash ciphertext before it is overwritten */
+        if (mode==GCM_DECRYPTING)
+        {
+            ghash(g,(const uchar *)&in[j],(int)(k/16));
+            if (k%16!=0) ghash_partial(g,(const uchar *)&in[j+k-k%16],(int)(k%16));
+        }
 
-        for (i=0; i<16 && j<len; i++)
+        GCM_keystream(g,B,(int)k);
+        for (i=0; i<k; i++) out[j+i]=in[j+i]^B[i];
+
+        if (mode==GCM_ENCRYPTING)
         {
-            cipher[j]=plain[j]^B[i];
-            g->stateX[i]^=cipher[j++];
-            g->lenC[1]++;
-            if (g->lenC[1]==0) g->lenC[0]++;
+            ghash(g,(const uchar *)&out[j],(int)(k/16));
+            if (k%16!=0) ghash_partial(g,(const uchar *)&out[j+k-k%16],(int)(k%16));
         }
-        gf2mul(g);
     }
+}
+
+/* SU= 176, Encrypt plaintext and hash ciphertext */
+int GCM_encrypt(gcm *g,char *cipher,const char *plain,size_t len)
+{
+    if (g->status==GCM_ACCEPTING_HEADER) g->status=GCM_ACCEPTING_CIPHER;
+    if (g->status!=GCM_ACCEPTING_CIPHER) return 0;
+
+    GCM_crypt(g,cipher,plain,len,GCM_ENCRYPTING);
+    addlen(g->lenC,len);
     if (len%16!=0) g->status=GCM_NOT_ACCEPTING_MORE;
     return 1;
 }
 
-/* SU= 48, Add ciphertext and extract plaintext */
-int GCM_add_cipher(gcm *g,char *plain,char *cipher,int len)
+/* SU= 176, Hash ciphertext and decrypt it */
+int GCM_decrypt(gcm *g,char *plain,const char *cipher,size_t len)
 {
-    int i,j=0;
-    unsign32 counter;
-    char oc;
-    uchar B[16];
     if (g->status==GCM_ACCEPTING_HEADER) g->status=GCM_ACCEPTING_CIPHER;
     if (g->status!=GCM_ACCEPTING_CIPHER) return 0;
 
-    while (j<len)
-    {
-        counter=pack((uchar *)&(g->a.f[12]));
-        counter++;
-        unpack(counter,(uchar *)&(g->a.f[12]));  /* increment counter */
-        for (i=0; i<16; i++) B[i]=g->a.f[i];
-        AES_ecb_encrypt(&(g->a),B);        /* encrypt it  */
-        for (i=0; i<16 && j<len; i++)
-        {
-            oc=cipher[j];
-            plain[j]=cipher[j]^B[i];
-            g->stateX[i]^=oc;
-            j++;
-            g->lenC[1]++;
-            if (g->lenC[1]==0) g->lenC[0]++;
-        }
-        gf2mul(g);
-    }
+    GCM_crypt(g,plain,cipher,len,GCM_DECRYPTING);
+    addlen(g->lenC,len);
     if (len%16!=0) g->status=GCM_NOT_ACCEPTING_MORE;
     return 1;
 }
 
+/* Add plaintext and extract ciphertext */
+int GCM_add_plain(gcm *g,char *cipher,char *plain,int len)
+{
+    return GCM_encrypt(g,cipher,plain,(size_t)len);
+}
+
+/* Add ciphertext and extract plaintext */
+int GCM_add_cipher(gcm *g,char *plain,char *cipher,int len)
+{
+    return GCM_decrypt(g,plain,cipher,(size_t)len);
+}
+
 /* SU= 16, Finish off GHASH and extract authentication tag (HMAC) */
 void GCM_finish(gcm *g,char *tag)
 {
@@ -286,7 +744,7 @@ void GCM_finish(gcm *g,char *tag)
     /* extract tag */
     if (tag!=NULL)
     {
-        AES_ecb_encrypt(&(g->a),g->Y_0);        /* E(K,Y0) */
+        AES_enc_blocks(&(GCM_key(g)->e),g->Y_0,1);        /* E(K,Y0) */
         for (i=0; i<16; i++) g->Y_0[i]^=g->stateX[i];
         for (i=0; i<16; i++)
         {
@@ -295,7 +753,8 @@ void GCM_finish(gcm *g,char *tag)
         }
     }
     g->status=GCM_FINISHED;
-    AES_end(&(g->a));
+    for (i=0; i<16; i++) g->ctr[i]=0;
+    if (g->K==NULL) GCM_key_end(&(g->key));
 }
 
 
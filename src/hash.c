@@ -37,6 +37,13 @@
 #include "arch.h"
 #include "amcl.h"
 
+#ifdef USE_THREADS
+#include <pthread.h>
+#endif
+
+#ifdef AMCL_X86_64
+#include <immintrin.h>
+#endif
 
 #define H0_256 0x6A09E667L
 #define H1_256 0xBB67AE85L
@@ -81,28 +88,90 @@ static const unsign32 K_256[64]=
 #define theta1_512(x)  (S(64,19,x)^S(64,61,x)^R(6,x))
 
 
-/* SU= 72 */
-static void HASH256_transform(hash256 *sh)
+/* Pack 4 bytes into a 32-bit word, big-endian */
+static unsign32 pack(const uchar *b)
+{
+    return ((unsign32)b[0]<<24)|((unsign32)b[1]<<16)|((unsign32)b[2]<<8)|(unsign32)b[3];
+}
+
+/* SU= 304, compress n 64-byte blocks into state H */
+static void sha256_c(unsign32 *H,const uchar *b,size_t n)
 {
     /* basic transformation step */
+    unsign32 a,bb,c,d,e,f,g,h,t1,t2,w[64];
+    int j;
+    for (; n>0; n--,b+=64)
+    {
+        for (j=0; j<16; j++) w[j]=pack(&b[4*j]);
+        for (j=16; j<64; j++)
+            w[j]=theta1_256(w[j-2])+w[j-7]+theta0_256(w[j-15])+w[j-16];
+
+        a=H[0];
+        bb=H[1];
+        c=H[2];
+        d=H[3];
+        e=H[4];
+        f=H[5];
+        g=H[6];
+        h=H[7];
+
+        for (j=0; j<64; j++)
+        {
+            /* 64 times - mush it up */
+            t1=h+Sig1_256(e)+Ch(e,f,g)+K_256[j]+w[j];
+            t2=Sig0_256(a)+Maj(a,bb,c);
+            h=g;
+            g=f;
+            f=e;
+            e=d+t1;
+            d=c;
+            c=bb;
+            bb=a;
+            a=t1+t2;
+        }
+
+        H[0]+=a;
+        H[1]+=bb;
+        H[2]+=c;
+        H[3]+=d;
+        H[4]+=e;
+        H[5]+=f;
+        H[6]+=g;
+        H[7]+=h;
+    }
+}
+
+#ifdef AMCL_X86_64
+
+/* AVX2 computes the message schedules of two blocks at once, one in each 128-bit lane, four words at
+   a time. The rounds are scalar, using BMI2 rotates */
+
+#define SHA_AVX2 __attribute__((target("avx2,bmi2")))
+
+/* 1 if the processor supports AVX2 and BMI2 */
+static int avx2_supported(void)
+{
+    return CPU_has(CPU_AVX2|CPU_BMI2);
+}
+
+/* SU= 40, 64 rounds with message schedule plus constants WK */
+SHA_AVX2 static void sha256_rounds(unsign32 *H,const unsign32 *WK)
+{
     unsign32 a,b,c,d,e,f,g,h,t1,t2;
     int j;
-    for (j=16; j<64; j++)
-        sh->w[j]=theta1_256(sh->w[j-2])+sh->w[j-7]+theta0_256(sh->w[j-15])+sh->w[j-16];
 
-    a=sh->h[0];
-    b=sh->h[1];
-    c=sh->h[2];
-    d=sh->h[3];
-    e=sh->h[4];
-    f=sh->h[5];
-    g=sh->h[6];
-    h=sh->h[7];
+    a=H[0];
+    b=H[1];
+    c=H[2];
+    d=H[3];
+    e=H[4];
+    f=H[5];
+    g=H[6];
+    h=H[7];
 
     for (j=0; j<64; j++)
     {
-        /* 64 times - mush it up */
-        t1=h+Sig1_256(e)+Ch(e,f,g)+K_256[j]+sh->w[j];
+        t1=h+Sig1_256(e)+Ch(e,f,g)+WK[j];
         t2=Sig0_256(a)+Maj(a,b,c);
         h=g;
         g=f;
@@ -114,14 +183,221 @@ static void HASH256_transform(hash256 *sh)
         a=t1+t2;
     }
 
-    sh->h[0]+=a;
-    sh->h[1]+=b;
-    sh->h[2]+=c;
-    sh->h[3]+=d;
-    sh->h[4]+=e;
-    sh->h[5]+=f;
-    sh->h[6]+=g;
-    sh->h[7]+=h;
+    H[0]+=a;
+    H[1]+=b;
+    H[2]+=c;
+    H[3]+=d;
+    H[4]+=e;
+    H[5]+=f;
+    H[6]+=g;
+    H[7]+=h;
+}
+
+SHA_AVX2 static __m256i ror_avx2(__m256i x,int n)
+{
+    return _mm256_or_si256(_mm256_srli_epi32(x,n),_mm256_slli_epi32(x,32-n));
+}
+
+/* Next four schedule words, from the previous sixteen W[t-16..t-1] in X0..X3 */
+SHA_AVX2 static __m256i schedule_avx2(__m256i X0,__m256i X1,__m256i X2,__m256i X3)
+{
+    __m256i t,u,v;
+
+    /* W[t-16]+theta0(W[t-15])+W[t-7] */
+    u=_mm256_alignr_epi8(X1,X0,4);
+    t=_mm256_xor_si256(ror_avx2(u,7),ror_avx2(u,18));
+    t=_mm256_xor_si256(t,_mm256_srli_epi32(u,3));
+    t=_mm256_add_epi32(_mm256_add_epi32(X0,t),_mm256_alignr_epi8(X3,X2,4));
+
+    /* theta1 of W[t-2],W[t-1] gives W[t],W[t+1] */
+    u=_mm256_shuffle_epi32(X3,0xEE);
+    v=_mm256_xor_si256(ror_avx2(u,17),ror_avx2(u,19));
+    v=_mm256_xor_si256(v,_mm256_srli_epi32(u,10));
+    t=_mm256_add_epi32(t,_mm256_and_si256(v,_mm256_set_epi32(0,0,-1,-1,0,0,-1,-1)));
+
+    /* and those give W[t+2],W[t+3] */
+    u=_mm256_shuffle_epi32(t,0x40);
+    v=_mm256_xor_si256(ror_avx2(u,17),ror_avx2(u,19));
+    v=_mm256_xor_si256(v,_mm256_srli_epi32(u,10));
+    return _mm256_add_epi32(t,_mm256_and_si256(v,_mm256_set_epi32(-1,-1,0,0,-1,-1,0,0)));
+}
+
+/* SU= 600, compress n 64-byte blocks into state H */
+SHA_AVX2 static void sha256_avx2(unsign32 *H,const uchar *b,size_t n)
+{
+    int i,m;
+    unsign32 WK[2][64];
+    __m128i lo,hi;
+    __m256i X[4],t;
+    const __m256i rev=_mm256_set_epi8(12,13,14,15,8,9,10,11,4,5,6,7,0,1,2,3,
+                                      12,13,14,15,8,9,10,11,4,5,6,7,0,1,2,3);
+
+    for (; n>0; n-=m,b+=64*m)
+    {
+        m=(n>=2)?2:1;
+        for (i=0; i<4; i++)
+        {
+            lo=_mm_loadu_si128((const __m128i *)&b[16*i]);
+            hi=(m==2)?_mm_loadu_si128((const __m128i *)&b[64+16*i]):lo;
+            X[i]=_mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(lo),hi,1),rev);
+        }
+        for (i=0; i<16; i++)
+        {
+            if (i>=4) X[i&3]=schedule_avx2(X[i&3],X[(i+1)&3],X[(i+2)&3],X[(i+3)&3]);
+            t=_mm256_add_epi32(X[i&3],_mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)&K_256[4*i])));
+            _mm_storeu_si128((__m128i *)&WK[0][4*i],_mm256_castsi256_si128(t));
+            _mm_storeu_si128((__m128i *)&WK[1][4*i],_mm256_extracti128_si256(t,1));
+        }
+        sha256_rounds(H,WK[0]);
+        if (m==2) sha256_rounds(H,WK[1]);
+    }
+}
+
+/* The SHA extensions do two rounds per SHA256RNDS2 and most of the message schedule with
+   SHA256MSG1/SHA256MSG2. The state is held as ABEF and CDGH.
+   See Gulley et al., "Intel SHA Extensions" */
+
+#define SHA_NI __attribute__((target("sha,sse4.1")))
+
+/* 1 if the processor supports the SHA extensions */
+static int shani_supported(void)
+{
+    return CPU_has(CPU_SHA);
+}
+
+/* SU= 32, compress n 64-byte blocks into state H */
+SHA_NI static void sha256_shani(unsign32 *H,const uchar *b,size_t n)
+{
+    int i;
+    __m128i S0,S1,A0,A1,M[4],k,t;
+    const __m128i rev=_mm_set_epi64x(0x0c0d0e0f08090a0bLL,0x0405060700010203LL);
+
+    t=_mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&H[0]),0xB1);
+    S1=_mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&H[4]),0x1B);
+    S0=_mm_alignr_epi8(t,S1,8);      /* ABEF */
+    S1=_mm_blend_epi16(S1,t,0xF0);   /* CDGH */
+
+    for (; n>0; n--,b+=64)
+    {
+        A0=S0;
+        A1=S1;
+        for (i=0; i<4; i++) M[i]=_mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)&b[16*i]),rev);
+
+        /* four rounds at a time, scheduling ahead */
+        for (i=0; i<16; i++)
+        {
+            k=_mm_add_epi32(M[i&3],_mm_loadu_si128((const __m128i *)&K_256[4*i]));
+            S1=_mm_sha256rnds2_epu32(S1,S0,k);
+            if (i>=3 && i<15)
+            {
+                t=_mm_alignr_epi8(M[i&3],M[(i-1)&3],4);
+                M[(i+1)&3]=_mm_sha256msg2_epu32(_mm_add_epi32(M[(i+1)&3],t),M[i&3]);
+            }
+            k=_mm_shuffle_epi32(k,0x0E);
+            S0=_mm_sha256rnds2_epu32(S0,S1,k);
+            if (i>=1 && i<13) M[(i-1)&3]=_mm_sha256msg1_epu32(M[(i-1)&3],M[i&3]);
+        }
+        S0=_mm_add_epi32(S0,A0);
+        S1=_mm_add_epi32(S1,A1);
+    }
+
+    t=_mm_shuffle_epi32(S0,0x1B);
+    S1=_mm_shuffle_epi32(S1,0xB1);
+    _mm_storeu_si128((__m128i *)&H[0],_mm_blend_epi16(t,S1,0xF0));  /* DCBA */
+    _mm_storeu_si128((__m128i *)&H[4],_mm_alignr_epi8(S1,t,8));     /* HGFE */
+}
+
+#endif
+
+/* SHA-256 compression, chosen on first use */
+static void (*sha256_compress)(unsign32 *,const uchar *,size_t)=sha256_c;
+static int sha256_backend=HASH256_PORTABLE;
+
+/* Select SHA-256 compression function */
+static int sha256_select(int b)
+{
+    switch (b)
+    {
+    case HASH256_PORTABLE:
+        sha256_compress=sha256_c;
+        break;
+#ifdef AMCL_X86_64
+    case HASH256_AVX2:
+        if (!avx2_supported()) return 0;
+        sha256_compress=sha256_avx2;
+        break;
+    case HASH256_SHANI:
+        if (!shani_supported()) return 0;
+        sha256_compress=sha256_shani;
+        break;
+#endif
+    default:
+        return 0;
+    }
+    sha256_backend=b;
+    return 1;
+}
+
+/* Fastest available */
+static void sha256_best(void)
+{
+    if (!sha256_select(HASH256_SHANI)) sha256_select(HASH256_AVX2);
+}
+
+#ifdef USE_THREADS
+static pthread_once_t sha256_once=PTHREAD_ONCE_INIT;
+#else
+static int sha256_done=0;
+#endif
+
+/* Choose SHA-256 compression on first use */
+static void sha256_init(void)
+{
+#ifdef USE_THREADS
+    pthread_once(&sha256_once,sha256_best);
+#else
+    if (!sha256_done)
+    {
+        sha256_best();
+        sha256_done=1;
+    }
+#endif
+}
+
+/* Select SHA-256 compression function */
+int HASH256_set_backend(int b)
+{
+    sha256_init();
+    return sha256_select(b);
+}
+
+/* SHA-256 compression function in use */
+int HASH256_backend(void)
+{
+    sha256_init();
+    return sha256_backend;
+}
+
+/* Compress n blocks */
+static void HASH256_compress(hash256 *sh,const uchar *b,size_t n)
+{
+    sha256_init();
+    (*sha256_compress)(sh->h,b,n);
+}
+
+/* SU= 72, compress block of words in w */
+static void HASH256_transform(hash256 *sh)
+{
+    int i;
+    uchar b[64];
+    for (i=0; i<16; i++)
+    {
+        b[4*i]=(uchar)(sh->w[i]>>24);
+        b[4*i+1]=(uchar)(sh->w[i]>>16);
+        b[4*i+2]=(uchar)(sh->w[i]>>8);
+        b[4*i+3]=(uchar)sh->w[i];
+    }
+    HASH256_compress(sh,b,1);
 }
 
 /* Initialise an instance of SHA256 */
@@ -163,16 +439,50 @@ void HASH256_process(hash256 *sh,int byte)
     if ((sh->length[0]%512)==0) HASH256_transform(sh);
 }
 
+/* Process a number of bytes to the hash, whole blocks at a time */
+void HASH256_update(hash256 *sh,const char *b,size_t len)
+{
+    size_t n;
+    unsign64 bits;
+
+    /* fill a partial block */
+    for (; len>0 && (sh->length[0]%512)!=0; len--) HASH256_process(sh,*b++);
+
+    n=len/64;
+    if (n>0)
+    {
+        HASH256_compress(sh,(const uchar *)b,n);
+        bits=(((unsign64)sh->length[1]<<32)|sh->length[0])+((unsign64)n<<9);
+        sh->length[1]=(unsign32)(bits>>32);
+        sh->length[0]=(unsign32)bits;
+        b+=64*n;
+        len-=64*n;
+    }
+
+    for (; len>0; len--) HASH256_process(sh,*b++);
+}
+
 /* SU= 24, Generate 32-byte hash */
 void HASH256_hash(hash256 *sh,char *digest)
 {
     /* pad message and finish - supply digest */
-    int i;
+    int i,bits;
     unsign32 len0,len1;
     len0=sh->length[0];
     len1=sh->length[1];
     HASH256_process(sh,PAD);
-    while ((sh->length[0]%512)!=448) HASH256_process(sh,ZERO);
+
+    /* zero fill to 448 bits, a word at a time */
+    bits=(int)(sh->length[0]%512);
+    i=bits/32;
+    if (bits%32!=0) sh->w[i++]<<=32-bits%32;
+    if (i>14)
+    {
+        for (; i<16; i++) sh->w[i]=ZERO;
+        HASH256_transform(sh);
+        i=0;
+    }
+    for (; i<14; i++) sh->w[i]=ZERO;
     sh->w[14]=len1;
     sh->w[15]=len0;
     HASH256_transform(sh);
@@ -297,6 +607,12 @@ void HASH384_process(hash384 *sh,int byte)
     HASH512_process(sh,byte);
 }
 
+/* Process a number of bytes to the hash */
+void HASH384_update(hash384 *sh,const char *b,size_t len)
+{
+    HASH512_update(sh,b,len);
+}
+
 /* Generate 48-byte hash */
 void HASH384_hash(hash384 *sh,char *hash)
 {
@@ -344,16 +660,52 @@ void HASH512_process(hash512 *sh,int byte)
     if ((sh->length[0]%1024)==0) HASH512_transform(sh);
 }
 
+/* Process a number of bytes to the hash, whole blocks at a time */
+void HASH512_update(hash512 *sh,const char *b,size_t len)
+{
+    int i,j;
+    unsign64 bits;
+
+    /* fill a partial block */
+    for (; len>0 && (sh->length[0]%1024)!=0; len--) HASH512_process(sh,*b++);
+
+    for (; len>=128; len-=128,b+=128)
+    {
+        for (i=0; i<16; i++)
+        {
+            sh->w[i]=0;
+            for (j=0; j<8; j++) sh->w[i]=(sh->w[i]<<8)|(uchar)b[8*i+j];
+        }
+        bits=sh->length[0]+1024;
+        if (bits<sh->length[0]) sh->length[1]++;
+        sh->length[0]=bits;
+        HASH512_transform(sh);
+    }
+
+    for (; len>0; len--) HASH512_process(sh,*b++);
+}
+
 /* Generate 64-byte hash */
 void HASH512_hash(hash512 *sh,char *hash)
 {
     /* pad message and finish - supply digest */
-    int i;
+    int i,bits;
     unsign64 len0,len1;
     len0=sh->length[0];
     len1=sh->length[1];
     HASH512_process(sh,PAD);
-    while ((sh->length[0]%1024)!=896) HASH512_process(sh,ZERO);
+
+    /* zero fill to 896 bits, a word at a time */
+    bits=(int)(sh->length[0]%1024);
+    i=bits/64;
+    if (bits%64!=0) sh->w[i++]<<=64-bits%64;
+    if (i>14)
+    {
+        for (; i<16; i++) sh->w[i]=ZERO;
+        HASH512_transform(sh);
+        i=0;
+    }
+    for (; i<14; i++) sh->w[i]=ZERO;
     sh->w[14]=len1;
     sh->w[15]=len0;
     HASH512_transform(sh);
@@ -366,6 +718,473 @@ void HASH512_hash(hash512 *sh,char *hash)
 }
 
 
+/* Multi-buffer hashing of independent messages. Each lane of a vector hashes one message, taking
+   the next as soon as it finishes, so messages of different lengths keep the lanes busy. Whole blocks are
+   read from the message, and the final partial block and padding from the lane */
+
+#ifdef AMCL_X86_64
+
+#define SHA256_LANES 8  /* 32-bit words in an AVX2 register */
+#define SHA512_LANES 4  /* 64-bit words in an AVX2 register */
+
+/* Multi-buffer hash lane */
+typedef struct
+{
+    const uchar *p;      /* next whole block of message */
+    size_t full;         /* whole blocks left */
+    uchar tail[256];     /* final partial block and padding */
+    int ntail;           /* blocks in tail */
+    int next;            /* next block of tail */
+    int job;             /* message index, or -1 for idle */
+} hash_lane;
+
+/* Start hashing message m of len bytes in a lane, after pre bytes already hashed, for block size bs */
+static void lane_start(hash_lane *L,int job,const char *m,size_t len,unsign64 pre,int bs)
+{
+    int i,r=(int)(len%bs),lb=bs/8;   /* length field is 8 or 16 bytes */
+    unsign64 bits=(pre+len)<<3;
+
+    L->job=job;
+    L->p=(const uchar *)m;
+    L->full=len/bs;
+    L->next=0;
+    L->ntail=(r+1+lb<=bs)?1:2;
+    for (i=0; i<bs*L->ntail; i++) L->tail[i]=ZERO;
+    for (i=0; i<r; i++) L->tail[i]=(uchar)m[len-r+i];
+    L->tail[r]=PAD;
+    for (i=0; i<8; i++) L->tail[bs*L->ntail-1-i]=(uchar)(bits>>(8*i));
+    if (lb==16) L->tail[bs*L->ntail-9]=(uchar)((pre+len)>>61);
+}
+
+/* Clear lanes and their states, through a volatile pointer so the stores are kept */
+static void lane_wipe(void *p,size_t n)
+{
+    size_t i;
+    volatile uchar *v=(volatile uchar *)p;
+    for (i=0; i<n; i++) v[i]=0;
+}
+
+/* Next block of lane, or NULL when done */
+static const uchar *lane_block(hash_lane *L,int bs)
+{
+    const uchar *b;
+    if (L->full>0)
+    {
+        b=L->p;
+        L->p+=bs;
+        L->full--;
+        return b;
+    }
+    if (L->next<L->ntail) return &L->tail[bs*L->next++];
+    return NULL;
+}
+
+/* Transpose 8 rows of 8 words, so W[i] holds word i of each row */
+SHA_AVX2 static void transpose_x8(__m256i *W,const __m256i *R)
+{
+    int i;
+    __m256i t[8],u[8];
+
+    for (i=0; i<8; i+=2)
+    {
+        t[i]=_mm256_unpacklo_epi32(R[i],R[i+1]);
+        t[i+1]=_mm256_unpackhi_epi32(R[i],R[i+1]);
+    }
+    for (i=0; i<8; i+=4)
+    {
+        u[i]=_mm256_unpacklo_epi64(t[i],t[i+2]);
+        u[i+1]=_mm256_unpackhi_epi64(t[i],t[i+2]);
+        u[i+2]=_mm256_unpacklo_epi64(t[i+1],t[i+3]);
+        u[i+3]=_mm256_unpackhi_epi64(t[i+1],t[i+3]);
+    }
+    for (i=0; i<4; i++)
+    {
+        W[i]=_mm256_permute2x128_si256(u[i],u[i+4],0x20);
+        W[i+4]=_mm256_permute2x128_si256(u[i],u[i+4],0x31);
+    }
+}
+
+/* SU= 2400, compress one block in each of 8 lanes. H[i][j] is word i of the state of lane j */
+SHA_AVX2 static void sha256_x8(unsign32 H[8][SHA256_LANES],const uchar *B[SHA256_LANES])
+{
+    int i,j;
+    __m256i W[64],R[8],S[8],t1,t2,a,b,c,d,e,f,g,h;
+    const __m256i rev=_mm256_set_epi8(12,13,14,15,8,9,10,11,4,5,6,7,0,1,2,3,
+                                      12,13,14,15,8,9,10,11,4,5,6,7,0,1,2,3);
+
+    for (i=0; i<2; i++)
+    {
+        for (j=0; j<8; j++) R[j]=_mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)&B[j][32*i]),rev);
+        transpose_x8(&W[8*i],R);
+    }
+    for (j=16; j<64; j++)
+    {
+        t1=W[j-2];
+        t1=_mm256_xor_si256(_mm256_xor_si256(ror_avx2(t1,17),ror_avx2(t1,19)),_mm256_srli_epi32(t1,10));
+        t2=W[j-15];
+        t2=_mm256_xor_si256(_mm256_xor_si256(ror_avx2(t2,7),ror_avx2(t2,18)),_mm256_srli_epi32(t2,3));
+        W[j]=_mm256_add_epi32(_mm256_add_epi32(t1,W[j-7]),_mm256_add_epi32(t2,W[j-16]));
+    }
+
+    a=_mm256_loadu_si256((const __m256i *)H[0]);
+    b=_mm256_loadu_si256((const __m256i *)H[1]);
+    c=_mm256_loadu_si256((const __m256i *)H[2]);
+    d=_mm256_loadu_si256((const __m256i *)H[3]);
+    e=_mm256_loadu_si256((const __m256i *)H[4]);
+    f=_mm256_loadu_si256((const __m256i *)H[5]);
+    g=_mm256_loadu_si256((const __m256i *)H[6]);
+    h=_mm256_loadu_si256((const __m256i *)H[7]);
+
+    for (j=0; j<64; j++)
+    {
+        t1=_mm256_xor_si256(_mm256_xor_si256(ror_avx2(e,6),ror_avx2(e,11)),ror_avx2(e,25));
+        t1=_mm256_add_epi32(_mm256_add_epi32(h,t1),_mm256_add_epi32(W[j],_mm256_set1_epi32((int)K_256[j])));
+        t1=_mm256_add_epi32(t1,_mm256_xor_si256(_mm256_and_si256(e,f),_mm256_andnot_si256(e,g)));
+        t2=_mm256_xor_si256(_mm256_xor_si256(ror_avx2(a,2),ror_avx2(a,13)),ror_avx2(a,22));
+        t2=_mm256_add_epi32(t2,_mm256_xor_si256(_mm256_and_si256(a,_mm256_xor_si256(b,c)),_mm256_and_si256(b,c)));
+        h=g;
+        g=f;
+        f=e;
+        e=_mm256_add_epi32(d,t1);
+        d=c;
+        c=b;
+        b=a;
+        a=_mm256_add_epi32(t1,t2);
+    }
+
+    S[0]=a;
+    S[1]=b;
+    S[2]=c;
+    S[3]=d;
+    S[4]=e;
+    S[5]=f;
+    S[6]=g;
+    S[7]=h;
+    for (i=0; i<8; i++)
+        _mm256_storeu_si256((__m256i *)H[i],_mm256_add_epi32(S[i],_mm256_loadu_si256((const __m256i *)H[i])));
+}
+
+SHA_AVX2 static __m256i ror64_avx2(__m256i x,int n)
+{
+    return _mm256_or_si256(_mm256_srli_epi64(x,n),_mm256_slli_epi64(x,64-n));
+}
+
+/* SU= 3000, compress one block in each of 4 lanes. H[i][j] is word i of the state of lane j */
+SHA_AVX2 static void sha512_x4(unsign64 H[8][SHA512_LANES],const uchar *B[SHA512_LANES])
+{
+    int i,j;
+    __m256i W[80],R[4],S[8],t1,t2,a,b,c,d,e,f,g,h;
+    const __m256i rev=_mm256_set_epi8(8,9,10,11,12,13,14,15,0,1,2,3,4,5,6,7,
+                                      8,9,10,11,12,13,14,15,0,1,2,3,4,5,6,7);
+
+    for (i=0; i<4; i++)
+    {
+        /* transpose 4 rows of 4 words */
+        for (j=0; j<4; j++) R[j]=_mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)&B[j][32*i]),rev);
+        t1=_mm256_unpacklo_epi64(R[0],R[1]);
+        t2=_mm256_unpacklo_epi64(R[2],R[3]);
+        W[4*i]=_mm256_permute2x128_si256(t1,t2,0x20);
+        W[4*i+2]=_mm256_permute2x128_si256(t1,t2,0x31);
+        t1=_mm256_unpackhi_epi64(R[0],R[1]);
+        t2=_mm256_unpackhi_epi64(R[2],R[3]);
+        W[4*i+1]=_mm256_permute2x128_si256(t1,t2,0x20);
+        W[4*i+3]=_mm256_permute2x128_si256(t1,t2,0x31);
+    }
+    for (j=16; j<80; j++)
+    {
+        t1=W[j-2];
+        t1=_mm256_xor_si256(_mm256_xor_si256(ror64_avx2(t1,19),ror64_avx2(t1,61)),_mm256_srli_epi64(t1,6));
+        t2=W[j-15];
+        t2=_mm256_xor_si256(_mm256_xor_si256(ror64_avx2(t2,1),ror64_avx2(t2,8)),_mm256_srli_epi64(t2,7));
+        W[j]=_mm256_add_epi64(_mm256_add_epi64(t1,W[j-7]),_mm256_add_epi64(t2,W[j-16]));
+    }
+
+    a=_mm256_loadu_si256((const __m256i *)H[0]);
+    b=_mm256_loadu_si256((const __m256i *)H[1]);
+    c=_mm256_loadu_si256((const __m256i *)H[2]);
+    d=_mm256_loadu_si256((const __m256i *)H[3]);
+    e=_mm256_loadu_si256((const __m256i *)H[4]);
+    f=_mm256_loadu_si256((const __m256i *)H[5]);
+    g=_mm256_loadu_si256((const __m256i *)H[6]);
+    h=_mm256_loadu_si256((const __m256i *)H[7]);
+
+    for (j=0; j<80; j++)
+    {
+        t1=_mm256_xor_si256(_mm256_xor_si256(ror64_avx2(e,14),ror64_avx2(e,18)),ror64_avx2(e,41));
+        t1=_mm256_add_epi64(_mm256_add_epi64(h,t1),_mm256_add_epi64(W[j],_mm256_set1_epi64x((long long)K_512[j])));
+        t1=_mm256_add_epi64(t1,_mm256_xor_si256(_mm256_and_si256(e,f),_mm256_andnot_si256(e,g)));
+        t2=_mm256_xor_si256(_mm256_xor_si256(ror64_avx2(a,28),ror64_avx2(a,34)),ror64_avx2(a,39));
+        t2=_mm256_add_epi64(t2,_mm256_xor_si256(_mm256_and_si256(a,_mm256_xor_si256(b,c)),_mm256_and_si256(b,c)));
+        h=g;
+        g=f;
+        f=e;
+        e=_mm256_add_epi64(d,t1);
+        d=c;
+        c=b;
+        b=a;
+        a=_mm256_add_epi64(t1,t2);
+    }
+
+    S[0]=a;
+    S[1]=b;
+    S[2]=c;
+    S[3]=d;
+    S[4]=e;
+    S[5]=f;
+    S[6]=g;
+    S[7]=h;
+    for (i=0; i<8; i++)
+        _mm256_storeu_si256((__m256i *)H[i],_mm256_add_epi64(S[i],_mm256_loadu_si256((const __m256i *)H[i])));
+}
+
+/* SU= 5000, hash n messages 8 at a time, each from state sh[k], or from the start if sh is NULL */
+static void sha256_multi(int n,const hash256 *sh[],const char *msg[],const size_t len[],char *out[])
+{
+    static const uchar idle[64]= {0};
+    const unsign32 iv[8]= {H0_256,H1_256,H2_256,H3_256,H4_256,H5_256,H6_256,H7_256};
+    int i,j,k,busy;
+    unsign32 H[8][SHA256_LANES];
+    const uchar *b[SHA256_LANES];
+    hash_lane L[SHA256_LANES];
+
+    for (j=0; j<SHA256_LANES; j++) L[j].job=-1;
+    for (k=0;;)
+    {
+        busy=0;
+        for (j=0; j<SHA256_LANES; j++)
+        {
+            b[j]=(L[j].job<0)?NULL:lane_block(&L[j],64);
+            if (b[j]==NULL)
+            {
+                if (L[j].job>=0)
+                {
+                    /* lane finished */
+                    for (i=0; i<32; i++) out[L[j].job][i]=(char)(H[i/4][j]>>(8*(3-i%4)));
+                    L[j].job=-1;
+                }
+                if (k<n)
+                {
+                    if (sh==NULL)
+                    {
+                        lane_start(&L[j],k,msg[k],len[k],0,64);
+                        for (i=0; i<8; i++) H[i][j]=iv[i];
+                    }
+                    else
+                    {
+                        lane_start(&L[j],k,msg[k],len[k],(((unsign64)sh[k]->length[1]<<32)|sh[k]->length[0])>>3,64);
+                        for (i=0; i<8; i++) H[i][j]=sh[k]->h[i];
+                    }
+                    k++;
+                    b[j]=lane_block(&L[j],64);
+                }
+            }
+            if (b[j]==NULL) b[j]=idle;
+            else busy=1;
+        }
+        if (!busy) break;
+        sha256_x8(H,b);
+    }
+
+    /* leave no message tails or hash states behind */
+    lane_wipe(L,sizeof(L));
+    lane_wipe(H,sizeof(H));
+}
+
+/* SU= 5000, hash n messages 4 at a time, each from state sh[k], or from initial state iv if sh is NULL,
+   with digest length hlen */
+static void sha512_multi(int n,const hash512 *sh[],const char *msg[],const size_t len[],char *out[],const unsign64 *iv,int hlen)
+{
+    static const uchar idle[128]= {0};
+    int i,j,k,busy;
+    unsign64 H[8][SHA512_LANES];
+    const uchar *b[SHA512_LANES];
+    hash_lane L[SHA512_LANES];
+
+    for (j=0; j<SHA512_LANES; j++) L[j].job=-1;
+    for (k=0;;)
+    {
+        busy=0;
+        for (j=0; j<SHA512_LANES; j++)
+        {
+            b[j]=(L[j].job<0)?NULL:lane_block(&L[j],128);
+            if (b[j]==NULL)
+            {
+                if (L[j].job>=0)
+                {
+                    for (i=0; i<hlen; i++) out[L[j].job][i]=(char)(H[i/8][j]>>(8*(7-i%8)));
+                    L[j].job=-1;
+                }
+                if (k<n)
+                {
+                    if (sh==NULL)
+                    {
+                        lane_start(&L[j],k,msg[k],len[k],0,128);
+                        for (i=0; i<8; i++) H[i][j]=iv[i];
+                    }
+                    else
+                    {
+                        /* only lengths below 2^64 bits are resumed */
+                        lane_start(&L[j],k,msg[k],len[k],sh[k]->length[0]>>3,128);
+                        for (i=0; i<8; i++) H[i][j]=sh[k]->h[i];
+                    }
+                    k++;
+                    b[j]=lane_block(&L[j],128);
+                }
+            }
+            if (b[j]==NULL) b[j]=idle;
+            else busy=1;
+        }
+        if (!busy) break;
+        sha512_x4(H,b);
+    }
+
+    /* leave no message tails or hash states behind */
+    lane_wipe(L,sizeof(L));
+    lane_wipe(H,sizeof(H));
+}
+
+/* Vector lanes resume only states that have hashed whole blocks */
+static int whole256(int n,const hash256 *sh[])
+{
+    int i;
+    for (i=0; i<n; i++)
+        if ((sh[i]->length[0]%512)!=0) return 0;
+    return 1;
+}
+
+static int whole512(int n,const hash512 *sh[])
+{
+    int i;
+    for (i=0; i<n; i++)
+        if ((sh[i]->length[0]%1024)!=0 || sh[i]->length[1]!=0) return 0;
+    return 1;
+}
+
+#endif
+
+/* Hash n independent messages */
+void HASH256_multi(int n,const char *msg[],const size_t len[],char *out[])
+{
+    int i;
+    hash256 sh;
+#ifdef AMCL_X86_64
+    if (n>1 && avx2_supported())
+    {
+        sha256_multi(n,NULL,msg,len,out);
+        return;
+    }
+#endif
+    for (i=0; i<n; i++)
+    {
+        HASH256_init(&sh);
+        HASH256_update(&sh,msg[i],len[i]);
+        HASH256_hash(&sh,out[i]);
+    }
+}
+
+/* Hash n independent messages */
+void HASH384_multi(int n,const char *msg[],const size_t len[],char *out[])
+{
+    int i;
+    hash384 sh;
+#ifdef AMCL_X86_64
+    const unsign64 iv[8]= {H8_512,H9_512,HA_512,HB_512,HC_512,HD_512,HE_512,HF_512};
+    if (n>1 && avx2_supported())
+    {
+        sha512_multi(n,NULL,msg,len,out,iv,48);
+        return;
+    }
+#endif
+    for (i=0; i<n; i++)
+    {
+        HASH384_init(&sh);
+        HASH384_update(&sh,msg[i],len[i]);
+        HASH384_hash(&sh,out[i]);
+    }
+}
+
+/* Hash n independent messages */
+void HASH512_multi(int n,const char *msg[],const size_t len[],char *out[])
+{
+    int i;
+    hash512 sh;
+#ifdef AMCL_X86_64
+    const unsign64 iv[8]= {H0_512,H1_512,H2_512,H3_512,H4_512,H5_512,H6_512,H7_512};
+    if (n>1 && avx2_supported())
+    {
+        sha512_multi(n,NULL,msg,len,out,iv,64);
+        return;
+    }
+#endif
+    for (i=0; i<n; i++)
+    {
+        HASH512_init(&sh);
+        HASH512_update(&sh,msg[i],len[i]);
+        HASH512_hash(&sh,out[i]);
+    }
+}
+
+/* Finish hashing n independent messages, each from its own state */
+void HASH256_multi_final(int n,const hash256 *sh[],const char *msg[],const size_t len[],char *out[])
+{
+    int i;
+    hash256 t;
+#ifdef AMCL_X86_64
+    if (n>1 && avx2_supported() && whole256(n,sh))
+    {
+        sha256_multi(n,sh,msg,len,out);
+        return;
+    }
+#endif
+    for (i=0; i<n; i++)
+    {
+        t=*sh[i];
+        HASH256_update(&t,msg[i],len[i]);
+        HASH256_hash(&t,out[i]);
+    }
+}
+
+/* Finish hashing n independent messages, each from its own state */
+void HASH384_multi_final(int n,const hash384 *sh[],const char *msg[],const size_t len[],char *out[])
+{
+    int i;
+    hash384 t;
+#ifdef AMCL_X86_64
+    if (n>1 && avx2_supported() && whole512(n,sh))
+    {
+        sha512_multi(n,sh,msg,len,out,NULL,48);
+        return;
+    }
+#endif
+    for (i=0; i<n; i++)
+    {
+        t=*sh[i];
+        HASH384_update(&t,msg[i],len[i]);
+        HASH384_hash(&t,out[i]);
+    }
+}
+
+/* Finish hashing n independent messages, each from its own state */
+void HASH512_multi_final(int n,const hash512 *sh[],const char *msg[],const size_t len[],char *out[])
+{
+    int i;
+    hash512 t;
+#ifdef AMCL_X86_64
+    if (n>1 && avx2_supported() && whole512(n,sh))
+    {
+        sha512_multi(n,sh,msg,len,out,NULL,64);
+        return;
+    }
+#endif
+    for (i=0; i<n; i++)
+    {
+        t=*sh[i];
+        HASH512_update(&t,msg[i],len[i]);
+        HASH512_hash(&t,out[i]);
+    }
+}
+
+
 /* test program: should produce digest
 
 160 bit
@@ -66,17 +66,17 @@ static void mpin_hash(int sha,FP4 *f, ECP *P,octet *w)
     {
     case SHA256:
         HASH256_init(&sha256);
-        for (i=0; i<6*MODBYTES; i++) HASH256_process(&sha256,t[i]);
+        HASH256_update(&sha256,t,6*MODBYTES);
         HASH256_hash(&sha256,h);
         break;
     case SHA384:
         HASH384_init(&sha512);
-        for (i=0; i<6*MODBYTES; i++) HASH384_process(&sha512,t[i]);
+        HASH384_update(&sha512,t,6*MODBYTES);
         HASH384_hash(&sha512,h);
         break;
     case SHA512:
         HASH512_init(&sha512);
-        for (i=0; i<6*MODBYTES; i++) HASH512_process(&sha512,t[i]);
+        HASH512_update(&sha512,t,6*MODBYTES);
         HASH512_hash(&sha512,h);
         break;
     }
@@ -181,7 +181,8 @@ static void mapit(octet *h,ECP *P)
 /* General purpose hash function w=hash(p|n|x|y) */
 static void hashit(int sha,int n,octet *x,octet *w)
 {
-    int i,c[4],hlen;
+    int i,hlen;
+    char c[4];
     hash256 sha256;
     hash512 sha512;
     char hh[64];
@@ -207,37 +208,34 @@ static void hashit(int sha,int n,octet *x,octet *w)
         c[1]=(n>>16)&0xff;
         c[2]=(n>>8)&0xff;
         c[3]=(n)&0xff;
-        for (i=0; i<4; i++)
+        switch(sha)
         {
-            switch(sha)
-            {
-            case SHA256:
-                HASH256_process(&sha256,c[i]);
-                break;
-            case SHA384:
-                HASH384_process(&sha512,c[i]);
-                break;
-            case SHA512:
-                HASH512_process(&sha512,c[i]);
-                break;
-            }
+        case SHA256:
+            HASH256_update(&sha256,c,4);
+            break;
+        case SHA384:
+            HASH384_update(&sha512,c,4);
+            break;
+        case SHA512:
+            HASH512_update(&sha512,c,4);
+            break;
         }
     }
-    if (x!=NULL) for (i=0; i<x->len; i++)
+    if (x!=NULL)
+    {
+        switch(sha)
         {
-            switch(sha)
-            {
-            case SHA256:
-                HASH256_process(&sha256,x->val[i]);
-                break;
-            case SHA384:
-                HASH384_process(&sha512,x->val[i]);
-                break;
-            case SHA512:
-                HASH512_process(&sha512,x->val[i]);
-                break;
-            }
+        case SHA256:
+            HASH256_update(&sha256,x->val,x->len);
+            break;
+        case SHA384:
+            HASH384_update(&sha512,x->val,x->len);
+            break;
+        case SHA512:
+            HASH512_update(&sha512,x->val,x->len);
+            break;
         }
+    }
 
     for (i=0; i<hlen; i++) hh[i]=0;
     switch (sha)
@@ -264,6 +262,65 @@ static void hashit(int sha,int n,octet *x,octet *w)
     }
 }
 
+#ifndef USE_ANONYMOUS
+
+/* Hash m octets together, w[i]=hashit(sha,n,x[i],w[i]). With a prefix n>0, each x[i] is at most MODBYTES */
+static void hashit_multi(int sha,int n,int m,octet *x[],octet *w[])
+{
+    int i,j,k,hlen=sha;
+    char t[MPIN_HASH_LANES][4+MODBYTES],hh[MPIN_HASH_LANES][64];
+    const char *msg[MPIN_HASH_LANES];
+    size_t len[MPIN_HASH_LANES];
+    char *out[MPIN_HASH_LANES];
+
+    for (i=0; i<m; i+=k)
+    {
+        for (k=0; k<MPIN_HASH_LANES && i+k<m; k++)
+        {
+            msg[k]=x[i+k]->val;
+            len[k]=x[i+k]->len;
+            out[k]=hh[k];
+            if (n>0)
+            {
+                t[k][0]=(n>>24)&0xff;
+                t[k][1]=(n>>16)&0xff;
+                t[k][2]=(n>>8)&0xff;
+                t[k][3]=(n)&0xff;
+                for (j=0; j<x[i+k]->len; j++) t[k][4+j]=x[i+k]->val[j];
+                msg[k]=t[k];
+                len[k]=4+x[i+k]->len;
+            }
+        }
+
+        switch (sha)
+        {
+        case SHA256:
+            HASH256_multi(k,msg,len,out);
+            break;
+        case SHA384:
+            HASH384_multi(k,msg,len,out);
+            break;
+        case SHA512:
+            HASH512_multi(k,msg,len,out);
+            break;
+        }
+
+        for (j=0; j<k; j++)
+        {
+            OCT_empty(w[i+j]);
+            if (hlen>=MODBYTES)
+                OCT_jbytes(w[i+j],hh[j],MODBYTES);
+            else
+            {
+                OCT_jbytes(w[i+j],hh[j],hlen);
+                OCT_jbyte(w[i+j],0,MODBYTES-hlen);
+            }
+        }
+    }
+}
+
+#endif
+
 /* Supply today's date as days from the epoch */
 unsign32 MPIN_today(void)
 {
@@ -618,14 +675,10 @@ int MPIN_GET_SERVER_SECRET(octet *S,octet *SST)
     int res=0;
 
     BIG_rcopy(r,CURVE_Order);
-    BIG_rcopy(qx.a,CURVE_Pxa);
-    FP_nres(qx.a);
-    BIG_rcopy(qx.b,CURVE_Pxb);
-    FP_nres(qx.b);
-    BIG_rcopy(qy.a,CURVE_Pya);
-    FP_nres(qy.a);
-    BIG_rcopy(qy.b,CURVE_Pyb);
-    FP_nres(qy.b);
+    BIG_rcopy(qx.a,CURVE_Pxa_NRES);
+    BIG_rcopy(qx.b,CURVE_Pxb_NRES);
+    BIG_rcopy(qy.a,CURVE_Pya_NRES);
+    BIG_rcopy(qy.b,CURVE_Pyb_NRES);
     ECP2_set(&Q,&qx,&qy);
 
     if (res==0)
@@ -689,67 +742,106 @@ void MPIN_SERVER_1(int sha,int date,octet *CID,octet *HID,octet *HTID)
 
 }
 
-/* Perform third pass on the server side of the 3-pass version of the M-Pin protocol */
-int MPIN_SERVER_2(int date,octet *HID,octet *HTID,octet *Y,octet *SST,octet *xID,octet *xCID,octet *mSEC,octet *E,octet *F)
+/* Server first pass for a batch of clients, hashing their IDs together */
+void MPIN_SERVER_1_batch(int sha,int date,int n,octet *CID[],octet *HID[],octet *HTID[])
 {
-    BIG px,py,y;
-    FP2 qx,qy;
-    FP12 g;
-    ECP2 Q,sQ;
+    int i;
+#ifdef USE_ANONYMOUS
+    for (i=0; i<n; i++) MPIN_SERVER_1(sha,date,CID[i],HID[i],(date)?HTID[i]:NULL);
+#else
+    int j,k;
+    char h[MPIN_HASH_LANES][MODBYTES],t[MPIN_HASH_LANES][MODBYTES];
+    octet H[MPIN_HASH_LANES],T[MPIN_HASH_LANES];
+    octet *pH[MPIN_HASH_LANES],*pT[MPIN_HASH_LANES];
     ECP P,R;
-    int res=0;
-
-    BIG_rcopy(qx.a,CURVE_Pxa);
-    FP_nres(qx.a);
-    BIG_rcopy(qx.b,CURVE_Pxb);
-    FP_nres(qx.b);
-    BIG_rcopy(qy.a,CURVE_Pya);
-    FP_nres(qy.a);
-    BIG_rcopy(qy.b,CURVE_Pyb);
-    FP_nres(qy.b);
-
-    if (!ECP2_set(&Q,&qx,&qy)) res=MPIN_INVALID_POINT;
 
-    if (res==0)
+    for (j=0; j<MPIN_HASH_LANES; j++)
     {
-        if (!ECP2_fromOctet(&sQ,SST)) res=MPIN_INVALID_POINT;
+        H[j].len=0;
+        H[j].max=MODBYTES;
+        H[j].val=h[j];
+        T[j].len=0;
+        T[j].max=MODBYTES;
+        T[j].val=t[j];
+        pH[j]=&H[j];
+        pT[j]=&T[j];
     }
 
-    if (res==0)
+    for (i=0; i<n; i+=k)
     {
-        if (date)
-        {
-            BIG_fromBytes(px,&(xCID->val[1]));
-            BIG_fromBytes(py,&(xCID->val[PFS+1]));
-        }
-        else
+        k=(n-i<MPIN_HASH_LANES)?n-i:MPIN_HASH_LANES;
+        hashit_multi(sha,-1,k,&CID[i],pH);
+        if (date) hashit_multi(sha,date,k,pH,pT);
+
+        for (j=0; j<k; j++)
         {
-            BIG_fromBytes(px,&(xID->val[1]));
-            BIG_fromBytes(py,&(xID->val[PFS+1]));
+            mapit(&H[j],&P);
+            ECP_toOctet(HID[i+j],&P);
+            if (date)
+            {
+                mapit(&T[j],&R);
+                ECP_add(&P,&R);
+                ECP_toOctet(HTID[i+j],&P);
+            }
         }
-        if (!ECP_set(&R,px,py)) res=MPIN_INVALID_POINT; // x(A+AT)
     }
+#endif
+}
+
+/* Decode and combine the client values of the third pass - on exit the check is e(Q,R).e(sQ,P)=1 */
+static int server_2_points(int date,octet *HID,octet *HTID,octet *Y,octet *xID,octet *xCID,octet *mSEC,ECP *P,ECP *R)
+{
+    BIG px,py,y;
+    int res=0;
+
+    if (date)
+    {
+        BIG_fromBytes(px,&(xCID->val[1]));
+        BIG_fromBytes(py,&(xCID->val[PFS+1]));
+    }
+    else
+    {
+        BIG_fromBytes(px,&(xID->val[1]));
+        BIG_fromBytes(py,&(xID->val[PFS+1]));
+    }
+    if (!ECP_set(R,px,py)) res=MPIN_INVALID_POINT; // x(A+AT)
+
     if (res==0)
     {
         BIG_fromBytes(y,Y->val);
         if (date)
         {
-            if (!ECP_fromOctet(&P,HTID))  res=MPIN_INVALID_POINT;
+            if (!ECP_fromOctet(P,HTID))  res=MPIN_INVALID_POINT;
         }
         else
         {
-            if (!ECP_fromOctet(&P,HID))  res=MPIN_INVALID_POINT;
+            if (!ECP_fromOctet(P,HID))  res=MPIN_INVALID_POINT;
         }
     }
     if (res==0)
     {
-        PAIR_G1mul(&P,y);  // y(A+AT)
-        ECP_add(&P,&R); // x(A+AT)+y(A+T)
-        if (!ECP_fromOctet(&R,mSEC))  res=MPIN_INVALID_POINT; // V
+        PAIR_G1mul(P,y);  // y(A+AT)
+        ECP_add(P,R); // x(A+AT)+y(A+T)
+        if (!ECP_fromOctet(R,mSEC))  res=MPIN_INVALID_POINT; // V
     }
+    return res;
+}
+
+/* Third pass on the server side, given the decoded generator Q and server secret sQ, and optionally their precomputed lines */
+static int server_2(int date,octet *HID,octet *HTID,octet *Y,ECP2 *Q,ECP2 *sQ,pair_table *TQ,pair_table *TsQ,octet *xID,octet *xCID,octet *mSEC,octet *E,octet *F)
+{
+    BIG y;
+    FP12 g;
+    ECP P,R;
+    int res;
+
+    res=server_2_points(date,HID,HTID,Y,xID,xCID,mSEC,&P,&R);
     if (res==0)
     {
-        PAIR_double_ate(&g,&Q,&R,&sQ,&P);
+        if (TQ!=NULL)
+            PAIR_double_ate_precomp(&g,TQ,&R,TsQ,&P);
+        else
+            PAIR_double_ate(&g,Q,&R,sQ,&P);
         PAIR_fexp(&g);
 
         if (!FP12_isunity(&g))
@@ -768,13 +860,17 @@ int MPIN_SERVER_2(int date,octet *HID,octet *HTID,octet *Y,octet *SST,octet *xID
 
                     if (res==0)
                     {
+                        BIG_fromBytes(y,Y->val);
                         PAIR_G1mul(&P,y);  // yA
                         ECP_add(&P,&R); // yA+xA
                     }
                 }
                 if (res==0)
                 {
-                    PAIR_ate(&g,&Q,&P);
+                    if (TQ!=NULL)
+                        PAIR_ate_precomp(&g,TQ,&P);
+                    else
+                        PAIR_ate(&g,Q,&P);
                     PAIR_fexp(&g);
                     FP12_toOctet(F,&g);
                 }
@@ -786,6 +882,88 @@ int MPIN_SERVER_2(int date,octet *HID,octet *HTID,octet *Y,octet *SST,octet *xID
     return res;
 }
 
+/* Perform third pass on the server side of the 3-pass version of the M-Pin protocol */
+int MPIN_SERVER_2(int date,octet *HID,octet *HTID,octet *Y,octet *SST,octet *xID,octet *xCID,octet *mSEC,octet *E,octet *F)
+{
+    FP2 qx,qy;
+    ECP2 Q,sQ;
+    int res=0;
+
+    BIG_rcopy(qx.a,CURVE_Pxa_NRES);
+    BIG_rcopy(qx.b,CURVE_Pxb_NRES);
+    BIG_rcopy(qy.a,CURVE_Pya_NRES);
+    BIG_rcopy(qy.b,CURVE_Pyb_NRES);
+
+    if (!ECP2_set(&Q,&qx,&qy)) res=MPIN_INVALID_POINT;
+
+    if (res==0)
+    {
+        if (!ECP2_fromOctet(&sQ,SST)) res=MPIN_INVALID_POINT;
+    }
+
+    if (res==0)
+        res=server_2(date,HID,HTID,Y,&Q,&sQ,NULL,NULL,xID,xCID,mSEC,E,F);
+
+    return res;
+}
+
+/* Initialise a server context from the server secret */
+int MPIN_SERVER_CTX_CREATE(MPIN_SERVER_CTX *C,octet *SST,int precompute)
+{
+    FP2 qx,qy;
+    int res=0;
+
+    C->precomp=0;
+
+    BIG_rcopy(qx.a,CURVE_Pxa_NRES);
+    BIG_rcopy(qx.b,CURVE_Pxb_NRES);
+    BIG_rcopy(qy.a,CURVE_Pya_NRES);
+    BIG_rcopy(qy.b,CURVE_Pyb_NRES);
+
+    if (!ECP2_set(&(C->Q),&qx,&qy)) res=MPIN_INVALID_POINT;
+
+    if (res==0)
+    {
+        if (!ECP2_fromOctet(&(C->sQ),SST)) res=MPIN_INVALID_POINT;
+    }
+
+    if (res==0)
+    {
+        ECP2_affine(&(C->Q));
+        ECP2_affine(&(C->sQ));
+        if (precompute)
+        {
+            if (!PAIR_precompute(&(C->TQ),&(C->Q)) || !PAIR_precompute(&(C->TsQ),&(C->sQ))) res=MPIN_INVALID_POINT;
+            else C->precomp=1;
+        }
+    }
+
+    if (res!=0) MPIN_SERVER_CTX_KILL(C);
+    return res;
+}
+
+/* Kill a server context, erasing the server secret */
+void MPIN_SERVER_CTX_KILL(MPIN_SERVER_CTX *C)
+{
+    int i;
+    char *b=(char *)C;
+    for (i=0; i<(int)sizeof(MPIN_SERVER_CTX); i++) b[i]=0;
+}
+
+/* Perform third pass on the server side of the 3-pass version of the M-Pin protocol, using a server context */
+int MPIN_SERVER_2_ctx(MPIN_SERVER_CTX *C,int date,octet *HID,octet *HTID,octet *Y,octet *xID,octet *xCID,octet *mSEC,octet *E,octet *F)
+{
+    ECP2 Q,sQ;
+
+    if (C->precomp)
+        return server_2(date,HID,HTID,Y,NULL,NULL,&(C->TQ),&(C->TsQ),xID,xCID,mSEC,E,F);
+
+    /* Pairing may normalise its arguments, so leave the context untouched */
+    ECP2_copy(&Q,&(C->Q));
+    ECP2_copy(&sQ,&(C->sQ));
+    return server_2(date,HID,HTID,Y,&Q,&sQ,NULL,NULL,xID,xCID,mSEC,E,F);
+}
+
 #if MAXPIN==10000
 #define MR_TS 10  /* 2^10/10 approx = sqrt(MAXPIN) */
 #define TRAP 200  /* 2*sqrt(MAXPIN) */
@@ -893,14 +1071,10 @@ int MPIN_PRECOMPUTE(octet *TOKEN,octet *CID,octet *CP,octet *G1,octet *G2)
         }
         else
         {
-            BIG_rcopy(qx.a,CURVE_Pxa);
-            FP_nres(qx.a);
-            BIG_rcopy(qx.b,CURVE_Pxb);
-            FP_nres(qx.b);
-            BIG_rcopy(qy.a,CURVE_Pya);
-            FP_nres(qy.a);
-            BIG_rcopy(qy.b,CURVE_Pyb);
-            FP_nres(qy.b);
+            BIG_rcopy(qx.a,CURVE_Pxa_NRES);
+            BIG_rcopy(qx.b,CURVE_Pxb_NRES);
+            BIG_rcopy(qy.a,CURVE_Pya_NRES);
+            BIG_rcopy(qy.b,CURVE_Pyb_NRES);
             if (!ECP2_set(&Q,&qx,&qy)) res=MPIN_INVALID_POINT;
         }
     }
@@ -946,9 +1120,9 @@ int MPIN_CLIENT_KEY(int sha,octet *G1,octet *G2,int pin,octet *R,octet *X,octet
 
         PAIR_G1mul(&W,x);
 
-        BIG_rcopy(a,CURVE_Fra);
-        BIG_rcopy(b,CURVE_Frb);
-        FP2_from_BIGs(&f,a,b);
+        BIG_rcopy(a,CURVE_Fra_NRES);
+        BIG_rcopy(b,CURVE_Frb_NRES);
+        FP2_from_FPs(&f,a,b);
 
         BIG_rcopy(q,Modulus);
         BIG_copy(m,q);
@@ -1112,13 +1286,221 @@ int MPIN_SERVER(int sha,int date,octet *HID,octet *HTID,octet *Y,octet *sQ,octet
     return 0;
 }
 
+/* Batch third pass on the server side. Random linear combination of all checks, so one double pairing is
+   needed if every client is good. Each item is re-checked separately only if the combined check fails */
+int MPIN_SERVER_2_batch(MPIN_SERVER_CTX *C,csprng *RNG,int n,int date,octet *HID[],octet *HTID[],octet *Y[],octet *xID[],octet *xCID[],octet *mSEC[],int results[])
+{
+    int i,k=0,good=0,res=0;
+    BIG r,rho;
+    FP12 g;
+    ECP P,R,SP,SR;
+    ECP2 Q,sQ;
+
+    BIG_rcopy(r,CURVE_Order);
+    ECP_inf(&SP);
+    ECP_inf(&SR);
+
+    for (i=0; i<n; i++)
+    {
+        results[i]=server_2_points(date,HID[i],HTID[i],Y[i],xID[i],xCID[i],mSEC[i],&P,&R);
+        if (results[i]!=0) continue;
+
+        BIG_randomnum(rho,r,RNG);
+        BIG_mod2m(rho,MPIN_BATCH_BITS);
+        ECP_mul(&P,rho);
+        ECP_mul(&R,rho);
+        ECP_add(&SP,&P);
+        ECP_add(&SR,&R);
+        k++;
+    }
+
+    if (k>1 && !ECP_isinf(&SP) && !ECP_isinf(&SR))
+    {
+        if (C->precomp)
+            PAIR_double_ate_precomp(&g,&(C->TQ),&SR,&(C->TsQ),&SP);
+        else
+        {
+            ECP2_copy(&Q,&(C->Q));
+            ECP2_copy(&sQ,&(C->sQ));
+            PAIR_double_ate(&g,&Q,&SR,&sQ,&SP);
+        }
+        PAIR_fexp(&g);
+        good=FP12_isunity(&g);
+    }
+
+    /* If the combined check failed, find the bad items */
+    for (i=0; i<n; i++)
+    {
+        if (results[i]==0 && !good)
+            results[i]=MPIN_SERVER_2_ctx(C,date,HID[i],HTID[i],Y[i],xID[i],xCID[i],mSEC[i],NULL,NULL);
+        if (results[i]!=0) res=results[i];
+    }
+    return res;
+}
+
+#ifdef USE_THREADS
+
+/* Worker thread - waits for a job and verifies its share of the batch */
+static void *pool_worker(void *arg)
+{
+    MPIN_POOL *P=(MPIN_POOL *)arg;
+    int w,lo,hi,seen;
+
+    pthread_mutex_lock(&(P->lock));
+    w=P->pending++;  /* worker index */
+    seen=P->generation;
+    pthread_cond_signal(&(P->done));
+
+    for (;;)
+    {
+        while (!P->quit && P->generation==seen)
+            pthread_cond_wait(&(P->work),&(P->lock));
+        if (P->quit) break;
+        seen=P->generation;
+        pthread_mutex_unlock(&(P->lock));
+
+        lo=(int)(((long)P->n*w)/P->nthreads);
+        hi=(int)(((long)P->n*(w+1))/P->nthreads);
+        P->rtn[w]=0;
+        if (hi>lo)
+            P->rtn[w]=MPIN_SERVER_2_batch(P->C,&(P->rng[w]),hi-lo,P->d,&(P->HID[lo]),&(P->HTID[lo]),&(P->Y[lo]),&(P->U[lo]),&(P->UT[lo]),&(P->V[lo]),&(P->results[lo]));
+
+        pthread_mutex_lock(&(P->lock));
+        if (--P->pending==0) pthread_cond_signal(&(P->done));
+    }
+    pthread_mutex_unlock(&(P->lock));
+    return NULL;
+}
+
+/* Start a pool of worker threads */
+int MPIN_POOL_CREATE(MPIN_POOL *P,int t,csprng *RNG)
+{
+    int i,j;
+    char raw[100];
+
+    if (t<1 || t>MPIN_MAX_THREADS) return MPIN_THREAD_ERROR;
+
+    /* Each worker has its own generator */
+    for (i=0; i<t; i++)
+    {
+        for (j=0; j<100; j++) raw[j]=RAND_byte(RNG);
+        RAND_seed(&(P->rng[i]),100,raw);
+    }
+    for (j=0; j<100; j++) raw[j]=0;
+
+    P->nthreads=0;
+    P->generation=0;
+    P->pending=0;
+    P->quit=0;
+    pthread_mutex_init(&(P->call),NULL);
+    pthread_mutex_init(&(P->lock),NULL);
+    pthread_cond_init(&(P->work),NULL);
+    pthread_cond_init(&(P->done),NULL);
+
+    /* Workers take their index from pending, so start them one at a time */
+    pthread_mutex_lock(&(P->lock));
+    for (i=0; i<t; i++)
+    {
+        if (pthread_create(&(P->thread[i]),NULL,pool_worker,P)!=0) break;
+        while (P->pending==i) pthread_cond_wait(&(P->done),&(P->lock));
+    }
+    P->nthreads=i;
+    P->pending=0;
+    pthread_mutex_unlock(&(P->lock));
+
+    if (i<t)
+    {
+        MPIN_POOL_KILL(P);
+        return MPIN_THREAD_ERROR;
+    }
+    return 0;
+}
+
+/* Stop the worker threads of a pool */
+void MPIN_POOL_KILL(MPIN_POOL *P)
+{
+    int i;
+    pthread_mutex_lock(&(P->lock));
+    P->quit=1;
+    pthread_cond_broadcast(&(P->work));
+    pthread_mutex_unlock(&(P->lock));
+
+    for (i=0; i<P->nthreads; i++)
+        pthread_join(P->thread[i],NULL);
+    for (i=0; i<MPIN_MAX_THREADS; i++)
+        RAND_clean(&(P->rng[i]));
+    P->nthreads=0;
+
+    pthread_cond_destroy(&(P->done));
+    pthread_cond_destroy(&(P->work));
+    pthread_mutex_destroy(&(P->lock));
+    pthread_mutex_destroy(&(P->call));
+}
+
+/* Batch third pass on the server side, split between the workers of a pool */
+int MPIN_SERVER_2_pool(MPIN_POOL *P,MPIN_SERVER_CTX *C,int n,int date,octet *HID[],octet *HTID[],octet *Y[],octet *xID[],octet *xCID[],octet *mSEC[],int results[])
+{
+    int i,res=0;
+
+    pthread_mutex_lock(&(P->call));
+    pthread_mutex_lock(&(P->lock));
+    P->C=C;
+    P->n=n;
+    P->d=date;
+    P->HID=HID;
+    P->HTID=HTID;
+    P->Y=Y;
+    P->U=xID;
+    P->UT=xCID;
+    P->V=mSEC;
+    P->results=results;
+    P->pending=P->nthreads;
+    P->generation++;
+    pthread_cond_broadcast(&(P->work));
+    while (P->pending>0)
+        pthread_cond_wait(&(P->done),&(P->lock));
+    pthread_mutex_unlock(&(P->lock));
+
+    for (i=0; i<P->nthreads; i++)
+        if (P->rtn[i]!=0) res=P->rtn[i];
+    pthread_mutex_unlock(&(P->call));
+    return res;
+}
+
+#endif
+
+/* Perform server side of the one-pass version of the M-Pin protocol, using a server context */
+int MPIN_SERVER_ctx(MPIN_SERVER_CTX *C,int sha,int date,octet *HID,octet *HTID,octet *Y,octet *U,octet *UT,octet *V,octet *E,octet *F,octet *ID,octet *MESSAGE,int TimeValue)
+{
+    char m[M_SIZE];
+    octet M= {0,sizeof(m),m};
+
+    octet *pU;
+    if (date == 0)
+        pU = U;
+    else
+        pU = UT;
+
+    MPIN_SERVER_1(sha,date,ID,HID,HTID);
+
+    OCT_joctet(&M,pU);
+    if (MESSAGE!=NULL)
+    {
+        OCT_joctet(&M,MESSAGE);
+    }
+
+    MPIN_GET_Y(sha,TimeValue,&M,Y);
+
+    return MPIN_SERVER_2_ctx(C,date,HID,HTID,Y,U,UT,V,E,F);
+}
+
 /* AES-GCM Encryption */
 void MPIN_AES_GCM_ENCRYPT(octet *K,octet *IV,octet *H,octet *P,octet *C,octet *T)
 {
     gcm g;
     GCM_init(&g,K->len,K->val,IV->len,IV->val);
     GCM_add_header(&g,H->val,H->len);
-    GCM_add_plain(&g,C->val,P->val,P->len);
+    GCM_encrypt(&g,C->val,P->val,P->len);
     C->len=P->len;
     GCM_finish(&g,T->val);
     T->len=16;
@@ -1130,7 +1512,7 @@ void MPIN_AES_GCM_DECRYPT(octet *K,octet *IV,octet *H,octet *C,octet *P,octet *T
     gcm g;
     GCM_init(&g,K->len,K->val,IV->len,IV->val);
     GCM_add_header(&g,H->val,H->len);
-    GCM_add_cipher(&g,P->val,C->val,C->len);
+    GCM_decrypt(&g,P->val,C->val,C->len);
     P->len=C->len;
     GCM_finish(&g,T->val);
     T->len=16;
@@ -1159,10 +1541,10 @@ int MPIN_TEST_PAIRING(octet *CID,octet *R)
     int res=0;
 
 	hashit(-1,CID,&P);
-	BIG_rcopy(qx.a,CURVE_Pxa); FP_nres(qx.a);
-	BIG_rcopy(qx.b,CURVE_Pxb); FP_nres(qx.b);
-	BIG_rcopy(qy.a,CURVE_Pya); FP_nres(qy.a);
-	BIG_rcopy(qy.b,CURVE_Pyb); FP_nres(qy.b);
+	BIG_rcopy(qx.a,CURVE_Pxa_NRES);
+	BIG_rcopy(qx.b,CURVE_Pxb_NRES);
+	BIG_rcopy(qy.a,CURVE_Pya_NRES);
+	BIG_rcopy(qy.b,CURVE_Pyb_NRES);
 
 	if (!ECP2_set(&Q,&qx,&qy))  res=MPIN_INVALID_POINT;
 
@@ -30,27 +30,21 @@
 
 #include "amcl.h"
 
-/* Line function */
-static void PAIR_line(FP12 *v,ECP2 *A,ECP2 *B,BIG Qx,BIG Qy)
+/* Line function coefficients - updates A and returns the line through A and B as c[0], c[1], c[2]
+   such that the line evaluated at Q is a=[c[0]*Qy,c[1]], b=[c[2]*Qx]. These do not depend on Q */
+static int PAIR_linecoeffs(FP2 c[3],ECP2 *A,ECP2 *B)
 {
     ECP2 P;
-    FP2 Z3,X,Y,ZZ,T,NY;
-    FP4 a,b,c;
+    FP2 X,Y,ZZ,T,NY;
     int D;
     ECP2_copy(&P,A);
     if (A==B)
         D=ECP2_dbl(A);  // check these return numbers...
     else
         D=ECP2_add(A,B);
-    if (D<0)
-    {
-        /* Infinity */
-        FP12_one(v);
-        return;
-    }
+    if (D<0) return D;  /* Infinity */
 
-    FP2_copy(&Z3,&(A->z));
-    FP4_zero(&c);
+    FP2_copy(&c[0],&(A->z));
     FP2_sqr(&ZZ,&(P.z)); // ZZ=Z^2
     if (D==0)
     {
@@ -62,14 +56,10 @@ static void PAIR_line(FP12 *v,ECP2 *A,ECP2 *B,BIG Qx,BIG Qy)
 
         FP2_neg(&NY,&(P.y));
         FP2_add(&ZZ,&ZZ,&NY);     // ZZ=Z^3*Y2-Y (slope numerator)
-        FP2_pmul(&Z3,&Z3,Qy);     // Z3*Qy
         FP2_mul(&T,&T,&(P.x));
         FP2_mul(&X,&X,&NY);
-        FP2_add(&T,&T,&X);        // Z*Y2*X-X2*Y
-        FP4_from_FP2s(&a,&Z3,&T); // a=[Z3*Qy,Z*Y2*X-X2*Y]
-        FP2_neg(&ZZ,&ZZ);
-        FP2_pmul(&ZZ,&ZZ,Qx);
-        FP4_from_FP2(&b,&ZZ);     // b=-slope*Qx
+        FP2_add(&c[1],&T,&X);     // Z*Y2*X-X2*Y
+        FP2_neg(&c[2],&ZZ);       // -slope
     }
     else
     {
@@ -79,34 +69,48 @@ static void PAIR_line(FP12 *v,ECP2 *A,ECP2 *B,BIG Qx,BIG Qy)
         FP2_sqr(&Y,&(P.y));
 
         FP2_add(&Y,&Y,&Y);        // Y=2Y^2
-        FP2_mul(&Z3,&Z3,&ZZ);     // Z3=Z3*ZZ
-        FP2_pmul(&Z3,&Z3,Qy);     // Z3=Z3*ZZ*Qy
+        FP2_mul(&c[0],&c[0],&ZZ); // Z3*ZZ
 
         FP2_mul(&X,&(P.x),&T);
-        FP2_sub(&X,&X,&Y);        // X=X*slope-2Y^2
-        FP4_from_FP2s(&a,&Z3,&X); // a=[Z3*ZZ*Qy , X*slope-2Y^2]
+        FP2_sub(&c[1],&X,&Y);     // X*slope-2Y^2
         FP2_neg(&T,&T);
-        FP2_mul(&ZZ,&ZZ,&T);
-        FP2_pmul(&ZZ,&ZZ,Qx);
-        FP4_from_FP2(&b,&ZZ);     // b=-slope*ZZ*Qx
+        FP2_mul(&c[2],&ZZ,&T);    // -slope*ZZ
     }
-
-    FP12_from_FP4s(v,&a,&b,&c);
+    return D;
 }
 
-/* Optimal R-ate pairing r=e(P,Q) */
-void PAIR_ate(FP12 *r,ECP2 *P,ECP *Q)
+/* Evaluate line with coefficients c at Q=(Qx,Qy). c is only read, as tables may be shared between threads */
+static void PAIR_lineeval(FP12 *v,FP2 c[3],BIG Qx,BIG Qy)
 {
-    FP2 X;
-    BIG x,n,Qx,Qy;
-    int i,nb;
-    ECP2 A;
-    FP12 lv;
+    FP2 t;
+    FP4 a,b,z;
+    FP2_copy(&t,&c[0]);
+    FP2_pmul(&t,&t,Qy);
+    FP4_from_FP2s(&a,&t,&c[1]);
+    FP2_copy(&t,&c[2]);
+    FP2_pmul(&t,&t,Qx);
+    FP4_from_FP2(&b,&t);
+    FP4_zero(&z);
+    FP12_from_FP4s(v,&a,&b,&z);
+}
 
-    BIG_rcopy(Qx,CURVE_Fra);
-    BIG_rcopy(Qy,CURVE_Frb);
-    FP2_from_BIGs(&X,Qx,Qy);
+/* Line function */
+static void PAIR_line(FP12 *v,ECP2 *A,ECP2 *B,BIG Qx,BIG Qy)
+{
+    FP2 c[3];
+    if (PAIR_linecoeffs(c,A,B)<0)
+    {
+        /* Infinity */
+        FP12_one(v);
+        return;
+    }
+    PAIR_lineeval(v,c,Qx,Qy);
+}
 
+/* Miller loop parameter, 6x+2 for BN curves (x negative), x for BLS curves. Returns its length in bits */
+static int PAIR_loopbits(BIG n)
+{
+    BIG x;
     BIG_rcopy(x,CURVE_Bnx);
 
 #if CHOICE<BLS_CURVES
@@ -117,6 +121,23 @@ void PAIR_ate(FP12 *r,ECP2 *P,ECP *Q)
 #endif
 
     BIG_norm(n);
+    return BIG_nbits(n);
+}
+
+/* Optimal R-ate pairing r=e(P,Q) */
+void PAIR_ate(FP12 *r,ECP2 *P,ECP *Q)
+{
+    FP2 X;
+    BIG n,Qx,Qy;
+    int i,nb;
+    ECP2 A;
+    FP12 lv;
+
+    BIG_rcopy(Qx,CURVE_Fra_NRES);
+    BIG_rcopy(Qy,CURVE_Frb_NRES);
+    FP2_from_FPs(&X,Qx,Qy);
+
+    nb=PAIR_loopbits(n);
 
     ECP2_affine(P);
     ECP_affine(Q);
@@ -126,7 +147,6 @@ void PAIR_ate(FP12 *r,ECP2 *P,ECP *Q)
 
     ECP2_copy(&A,P);
     FP12_one(r);
-    nb=BIG_nbits(n);
 
     /* Main Miller Loop */
     for (i=nb-2; i>=1; i--)
@@ -173,25 +193,16 @@ void PAIR_ate(FP12 *r,ECP2 *P,ECP *Q)
 void PAIR_double_ate(FP12 *r,ECP2 *P,ECP *Q,ECP2 *R,ECP *S)
 {
     FP2 X;
-    BIG x,n,Qx,Qy,Sx,Sy;
+    BIG n,Qx,Qy,Sx,Sy;
     int i,nb;
     ECP2 A,B;
     FP12 lv;
 
-    BIG_rcopy(Qx,CURVE_Fra);
-    BIG_rcopy(Qy,CURVE_Frb);
-    FP2_from_BIGs(&X,Qx,Qy);
-
-    BIG_rcopy(x,CURVE_Bnx);
-
-#if CHOICE<BLS_CURVES
-    BIG_pmul(n,x,6);
-    BIG_dec(n,2);
-#else
-    BIG_copy(n,x);
-#endif
+    BIG_rcopy(Qx,CURVE_Fra_NRES);
+    BIG_rcopy(Qy,CURVE_Frb_NRES);
+    FP2_from_FPs(&X,Qx,Qy);
 
-    BIG_norm(n);
+    nb=PAIR_loopbits(n);
 
     ECP2_affine(P);
     ECP_affine(Q);
@@ -208,7 +219,6 @@ void PAIR_double_ate(FP12 *r,ECP2 *P,ECP *Q,ECP2 *R,ECP *S)
     ECP2_copy(&A,P);
     ECP2_copy(&B,R);
     FP12_one(r);
-    nb=BIG_nbits(n);
 
     /* Main Miller Loop */
     for (i=nb-2; i>=1; i--)
@@ -271,6 +281,300 @@ void PAIR_double_ate(FP12 *r,ECP2 *P,ECP *Q,ECP2 *R,ECP *S)
 #endif
 }
 
+/* Optimal R-ate multi-pairing r=e(P[0],Q[0]).e(P[1],Q[1])...e(P[n-1],Q[n-1]) */
+/* Pairs are processed in batches of up to PAIR_MULTI_MAX, with one Miller loop per batch sharing the FP12 squarings */
+void PAIR_multi_ate(FP12 *r,int n,ECP2 *P[],ECP *Q[])
+{
+    FP2 X;
+    BIG m,a,b,Qx[PAIR_MULTI_MAX],Qy[PAIR_MULTI_MAX];
+    int i,j,k,l,nb;
+    ECP2 A[PAIR_MULTI_MAX],*B[PAIR_MULTI_MAX];
+    FP12 t,lv;
+#if CHOICE<BLS_CURVES
+    ECP2 K;
+#endif
+
+    BIG_rcopy(a,CURVE_Fra_NRES);
+    BIG_rcopy(b,CURVE_Frb_NRES);
+    FP2_from_FPs(&X,a,b);
+
+    nb=PAIR_loopbits(m);
+
+    FP12_one(r);
+    j=0;
+    while (j<n)
+    {
+        /* Collect next batch, skipping pairs involving the point at infinity */
+        for (k=0; j<n && k<PAIR_MULTI_MAX; j++)
+        {
+            if (ECP2_isinf(P[j]) || ECP_isinf(Q[j])) continue;
+            ECP2_affine(P[j]);
+            ECP_affine(Q[j]);
+            B[k]=P[j];
+            ECP2_copy(&A[k],P[j]);
+            BIG_copy(Qx[k],Q[j]->x);
+            BIG_copy(Qy[k],Q[j]->y);
+            k++;
+        }
+        if (k==0) break;
+
+        FP12_one(&t);
+
+        /* Main Miller Loop */
+        for (i=nb-2; i>=1; i--)
+        {
+            for (l=0; l<k; l++)
+            {
+                PAIR_line(&lv,&A[l],&A[l],Qx[l],Qy[l]);
+                FP12_smul(&t,&lv);
+            }
+            if (BIG_bit(m,i))
+            {
+                for (l=0; l<k; l++)
+                {
+                    PAIR_line(&lv,&A[l],B[l],Qx[l],Qy[l]);
+                    FP12_smul(&t,&lv);
+                }
+            }
+            FP12_sqr(&t,&t);
+        }
+
+        for (i=0; i<k; i++)
+        {
+            PAIR_line(&lv,&A[i],&A[i],Qx[i],Qy[i]);
+            FP12_smul(&t,&lv);
+        }
+
+        if (BIG_parity(m))
+        {
+            for (i=0; i<k; i++)
+            {
+                PAIR_line(&lv,&A[i],B[i],Qx[i],Qy[i]);
+                FP12_smul(&t,&lv);
+            }
+        }
+
+        /* R-ate fixup required for BN curves */
+#if CHOICE<BLS_CURVES
+        FP12_conj(&t,&t);
+        for (i=0; i<k; i++)
+        {
+            ECP2_copy(&K,B[i]);
+            ECP2_frob(&K,&X);
+            ECP2_neg(&A[i]);
+            PAIR_line(&lv,&A[i],&K,Qx[i],Qy[i]);
+            FP12_smul(&t,&lv);
+            ECP2_frob(&K,&X);
+            ECP2_neg(&K);
+            PAIR_line(&lv,&A[i],&K,Qx[i],Qy[i]);
+            FP12_smul(&t,&lv);
+        }
+#endif
+        FP12_mul(r,&t);
+    }
+}
+
+/* Test e(P[0],Q[0]).e(P[1],Q[1])...e(P[n-1],Q[n-1])=1, using a single final exponentiation */
+int PAIR_multi_isunity(int n,ECP2 *P[],ECP *Q[])
+{
+    FP12 r;
+    PAIR_multi_ate(&r,n,P,Q);
+    PAIR_fexp(&r);
+    return FP12_isunity(&r);
+}
+
+/* Store line coefficients of the Miller loop for fixed P in T, in the order they are used by PAIR_ate */
+int PAIR_precompute(pair_table *T,ECP2 *P)
+{
+    int i,nb,j=0;
+    BIG n;
+    ECP2 A;
+#if CHOICE<BLS_CURVES
+    FP2 X;
+    BIG a,b;
+    ECP2 K;
+#endif
+
+    T->n=0;
+    if (ECP2_isinf(P)) return 0;
+
+    /* check the table is big enough for the lines of this loop parameter */
+    nb=PAIR_loopbits(n);
+    j=nb-1;
+    for (i=nb-2; i>=0; i--) j+=BIG_bit(n,i);
+#if CHOICE<BLS_CURVES
+    j+=2;
+#endif
+    if (j>PAIR_TABLE_LINES) return 0;
+    j=0;
+
+    ECP2_affine(P);
+    ECP2_copy(&A,P);
+
+    /* Main Miller Loop */
+    for (i=nb-2; i>=1; i--)
+    {
+        if (PAIR_linecoeffs(T->c[j++],&A,&A)<0) return 0;
+        if (BIG_bit(n,i))
+        {
+            if (PAIR_linecoeffs(T->c[j++],&A,P)<0) return 0;
+        }
+    }
+
+    if (PAIR_linecoeffs(T->c[j++],&A,&A)<0) return 0;
+    if (BIG_parity(n))
+    {
+        if (PAIR_linecoeffs(T->c[j++],&A,P)<0) return 0;
+    }
+
+    /* R-ate fixup required for BN curves */
+#if CHOICE<BLS_CURVES
+    BIG_rcopy(a,CURVE_Fra_NRES);
+    BIG_rcopy(b,CURVE_Frb_NRES);
+    FP2_from_FPs(&X,a,b);
+
+    ECP2_copy(&K,P);
+    ECP2_frob(&K,&X);
+    ECP2_neg(&A);
+    if (PAIR_linecoeffs(T->c[j++],&A,&K)<0) return 0;
+    ECP2_frob(&K,&X);
+    ECP2_neg(&K);
+    if (PAIR_linecoeffs(T->c[j++],&A,&K)<0) return 0;
+#endif
+
+    for (i=0; i<j; i++)
+    {
+        FP2_reduce(&(T->c[i][0]));
+        FP2_reduce(&(T->c[i][1]));
+        FP2_reduce(&(T->c[i][2]));
+    }
+    T->n=j;
+    return 1;
+}
+
+/* Optimal R-ate pairing r=e(P,Q), with the lines of P taken from table T */
+void PAIR_ate_precomp(FP12 *r,pair_table *T,ECP *Q)
+{
+    BIG n,Qx,Qy;
+    int i,nb,j=0;
+    FP12 lv;
+
+    FP12_one(r);
+    if (T->n==0) return;
+
+    nb=PAIR_loopbits(n);
+
+    ECP_affine(Q);
+    BIG_copy(Qx,Q->x);
+    BIG_copy(Qy,Q->y);
+
+    /* Main Miller Loop */
+    for (i=nb-2; i>=1; i--)
+    {
+        PAIR_lineeval(&lv,T->c[j++],Qx,Qy);
+        FP12_smul(r,&lv);
+        if (BIG_bit(n,i))
+        {
+            PAIR_lineeval(&lv,T->c[j++],Qx,Qy);
+            FP12_smul(r,&lv);
+        }
+        FP12_sqr(r,r);
+    }
+
+    PAIR_lineeval(&lv,T->c[j++],Qx,Qy);
+    FP12_smul(r,&lv);
+
+    if (BIG_parity(n))
+    {
+        PAIR_lineeval(&lv,T->c[j++],Qx,Qy);
+        FP12_smul(r,&lv);
+    }
+
+    /* R-ate fixup required for BN curves */
+#if CHOICE<BLS_CURVES
+    FP12_conj(r,r);
+    PAIR_lineeval(&lv,T->c[j++],Qx,Qy);
+    FP12_smul(r,&lv);
+    PAIR_lineeval(&lv,T->c[j++],Qx,Qy);
+    FP12_smul(r,&lv);
+#endif
+}
+
+/* Optimal R-ate double pairing e(P,Q).e(R,S), with the lines of P and R taken from tables T and U */
+void PAIR_double_ate_precomp(FP12 *r,pair_table *T,ECP *Q,pair_table *U,ECP *S)
+{
+    BIG n,Qx,Qy,Sx,Sy;
+    int i,nb,j=0;
+    FP12 lv;
+
+    if (T->n==0)
+    {
+        PAIR_ate_precomp(r,U,S);
+        return;
+    }
+    if (U->n==0)
+    {
+        PAIR_ate_precomp(r,T,Q);
+        return;
+    }
+
+    nb=PAIR_loopbits(n);
+
+    ECP_affine(Q);
+    ECP_affine(S);
+
+    BIG_copy(Qx,Q->x);
+    BIG_copy(Qy,Q->y);
+
+    BIG_copy(Sx,S->x);
+    BIG_copy(Sy,S->y);
+
+    FP12_one(r);
+
+    /* Main Miller Loop - both tables have the same layout */
+    for (i=nb-2; i>=1; i--)
+    {
+        PAIR_lineeval(&lv,T->c[j],Qx,Qy);
+        FP12_smul(r,&lv);
+        PAIR_lineeval(&lv,U->c[j++],Sx,Sy);
+        FP12_smul(r,&lv);
+
+        if (BIG_bit(n,i))
+        {
+            PAIR_lineeval(&lv,T->c[j],Qx,Qy);
+            FP12_smul(r,&lv);
+            PAIR_lineeval(&lv,U->c[j++],Sx,Sy);
+            FP12_smul(r,&lv);
+        }
+        FP12_sqr(r,r);
+    }
+
+    PAIR_lineeval(&lv,T->c[j],Qx,Qy);
+    FP12_smul(r,&lv);
+    PAIR_lineeval(&lv,U->c[j++],Sx,Sy);
+    FP12_smul(r,&lv);
+
+    if (BIG_parity(n))
+    {
+        PAIR_lineeval(&lv,T->c[j],Qx,Qy);
+        FP12_smul(r,&lv);
+        PAIR_lineeval(&lv,U->c[j++],Sx,Sy);
+        FP12_smul(r,&lv);
+    }
+
+    /* R-ate fixup required for BN curves */
+#if CHOICE<BLS_CURVES
+    FP12_conj(r,r);
+    for (i=0; i<2; i++)
+    {
+        PAIR_lineeval(&lv,T->c[j],Qx,Qy);
+        FP12_smul(r,&lv);
+        PAIR_lineeval(&lv,U->c[j++],Sx,Sy);
+        FP12_smul(r,&lv);
+    }
+#endif
+}
+
 /* final exponentiation - keep separate for multi-pairings and to avoid thrashing stack */
 void PAIR_fexp(FP12 *r)
 {
@@ -279,9 +583,9 @@ void PAIR_fexp(FP12 *r)
     FP12 t0,y0,y1,y2,y3;
 
     BIG_rcopy(x,CURVE_Bnx);
-    BIG_rcopy(a,CURVE_Fra);
-    BIG_rcopy(b,CURVE_Frb);
-    FP2_from_BIGs(&X,a,b);
+    BIG_rcopy(a,CURVE_Fra_NRES);
+    BIG_rcopy(b,CURVE_Frb_NRES);
+    FP2_from_FPs(&X,a,b);
 
     /* Easy part of final exp */
 
@@ -570,8 +874,7 @@ void PAIR_G1mul(ECP *P,BIG e)
 
     ECP_affine(P);
     ECP_copy(&Q,P);
-    BIG_rcopy(cru,CURVE_Cru);
-    FP_nres(cru);
+    BIG_rcopy(cru,CURVE_Cru_NRES);
     FP_mul(Q.x,Q.x,cru);
 
     // note that -a.B = a.(-B). Use a or -a depending on which is smaller
@@ -611,9 +914,9 @@ void PAIR_G2mul(ECP2 *P,BIG e)
     BIG x,y;
     BIG u[4];
 
-    BIG_rcopy(x,CURVE_Fra);
-    BIG_rcopy(y,CURVE_Frb);
-    FP2_from_BIGs(&X,x,y);
+    BIG_rcopy(x,CURVE_Fra_NRES);
+    BIG_rcopy(y,CURVE_Frb_NRES);
+    FP2_from_FPs(&X,x,y);
 
     BIG_rcopy(y,CURVE_Order);
     gs(u,e);
@@ -658,9 +961,9 @@ void PAIR_GTpow(FP12 *f,BIG e)
     BIG t,q,x,y;
     BIG u[4];
 
-    BIG_rcopy(x,CURVE_Fra);
-    BIG_rcopy(y,CURVE_Frb);
-    FP2_from_BIGs(&X,x,y);
+    BIG_rcopy(x,CURVE_Fra_NRES);
+    BIG_rcopy(y,CURVE_Frb_NRES);
+    FP2_from_FPs(&X,x,y);
 
     BIG_rcopy(q,CURVE_Order);
     gs(u,e);
@@ -784,9 +1087,9 @@ int main()
     FP2 x,y,X;
 
 
-    BIG_rcopy(a,CURVE_Fra);
-    BIG_rcopy(b,CURVE_Frb);
-    FP2_from_BIGs(&X,a,b);
+    BIG_rcopy(a,CURVE_Fra_NRES);
+    BIG_rcopy(b,CURVE_Frb_NRES);
+    FP2_from_FPs(&X,a,b);
 
     BIG_rcopy(xa,CURVE_Gx);
     BIG_rcopy(ya,CURVE_Gy);
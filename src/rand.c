@@ -87,11 +87,17 @@ static void sirand(csprng* rng,unsign32 seed)
 static void fill_pool(csprng *rng)
 {
     int i;
+    char b[128];
+    volatile char *vb=b;
     hash256 sh;
     HASH256_init(&sh);
-    for (i=0; i<128; i++) HASH256_process(&sh,sbrand(rng));
+    for (i=0; i<128; i++) b[i]=(char)sbrand(rng);
+    HASH256_update(&sh,b,128);
     HASH256_hash(&sh,rng->pool);
     rng->pool_ptr=0;
+
+    /* leave no generator output behind, through a volatile pointer so the stores are kept */
+    for (i=0; i<128; i++) vb[i]=0;
 }
 
 /* Pack bytes into a 32-bit word */
@@ -114,8 +120,7 @@ void RAND_seed(csprng *rng,int rawlen,char *raw)
     if (rawlen>0)
     {
         HASH256_init(&sh);
-        for (i=0; i<rawlen; i++)
-            HASH256_process(&sh,raw[i]);
+        HASH256_update(&sh,raw,rawlen);
         HASH256_hash(&sh,digest);
 
         /* initialise PRNG from distilled randomness */
@@ -37,6 +37,8 @@ const int CURVE_A=0;
 
 const chunk MConst=0x15E5;
 const BIG Modulus= {0x13,0x0,0x0,0x0,0x1A70,0x9,0x0,0x0,0x100,0x309,0x2,0x0,0x1800,0x1A26,0x6E8,0x0,0x0,0x412,0x8D9,0x4A};
+const BIG R2modp= {0xF32,0x239,0x14DC,0xCE8,0x928,0x11B6,0x130F,0x1183,0x56E,0x1AEE,0x124F,0xD2A,0x7F8,0x1CE6,0x1B50,0x77C,0x3A,0x1A9E,0x1EFD,0x1C};
+const BIG Rmodp= {0x17D6,0x1FFF,0x1FFF,0x1FFF,0x3DF,0x1BC7,0x1FFF,0x1FFF,0x11FF,0x121E,0x1F19,0x1FFF,0xFFF,0x359,0x7F6,0x1FE8,0x1FFF,0x43,0x12B4,0x15};
 const BIG CURVE_Order= {0xD,0x0,0x0,0x0,0xA10,0x8,0x0,0x0,0x1F80,0x1FFC,0x1,0x0,0x1800,0x1A26,0x6E8,0x0,0x0,0x412,0x8D9,0x4A};
 const BIG CURVE_Cof= {0x1};
 const BIG CURVE_B= {0x2};
@@ -58,12 +60,26 @@ const BIG CURVE_W[2]= {{0x3,0x0,0x0,0x0,0x40,0x1,0x0,0x0,0x180,0x30C},{0x1,0x0,0
 const BIG CURVE_SB[2][2]= {{{0x4,0x0,0x0,0x0,0x850,0x1,0x0,0x0,0x180,0x30C},{0x1,0x0,0x0,0x0,0x810}},{{0x1,0x0,0x0,0x0,0x810},{0xA,0x0,0x0,0x0,0x9D0,0x7,0x0,0x0,0x1E00,0x1CF0,0x1,0x0,0x1800,0x1A26,0x6E8,0x0,0x0,0x412,0x8D9,0x4A}}};
 const BIG CURVE_WB[4]= {{0x0,0x0,0x0,0x0,0x408,0x0,0x0,0x0,0x80,0x104},{0x5,0x0,0x0,0x0,0x14A8,0x2,0x0,0x0,0x700,0xE38,0x0,0x0,0x1800,0x1120,0xC4},{0x3,0x0,0x0,0x0,0xC58,0x1,0x0,0x0,0x380,0x71C,0x0,0x0,0xC00,0x890,0x62},{0x1,0x0,0x0,0x0,0xC18,0x0,0x0,0x0,0x80,0x104}};
 const BIG CURVE_BB[4][4]= {{{0xD,0x0,0x0,0x0,0x608,0x8,0x0,0x0,0x1F80,0x1FFC,0x1,0x0,0x1800,0x1A26,0x6E8,0x0,0x0,0x412,0x8D9,0x4A},{0xC,0x0,0x0,0x0,0x608,0x8,0x0,0x0,0x1F80,0x1FFC,0x1,0x0,0x1800,0x1A26,0x6E8,0x0,0x0,0x412,0x8D9,0x4A},{0xC,0x0,0x0,0x0,0x608,0x8,0x0,0x0,0x1F80,0x1FFC,0x1,0x0,0x1800,0x1A26,0x6E8,0x0,0x0,0x412,0x8D9,0x4A},{0x2,0x0,0x0,0x0,0x810}},{{0x1,0x0,0x0,0x0,0x810},{0xC,0x0,0x0,0x0,0x608,0x8,0x0,0x0,0x1F80,0x1FFC,0x1,0x0,0x1800,0x1A26,0x6E8,0x0,0x0,0x412,0x8D9,0x4A},{0xD,0x0,0x0,0x0,0x608,0x8,0x0,0x0,0x1F80,0x1FFC,0x1,0x0,0x1800,0x1A26,0x6E8,0x0,0x0,0x412,0x8D9,0x4A},{0xC,0x0,0x0,0x0,0x608,0x8,0x0,0x0,0x1F80,0x1FFC,0x1,0x0,0x1800,0x1A26,0x6E8,0x0,0x0,0x412,0x8D9,0x4A}},{{0x2,0x0,0x0,0x0,0x810},{0x1,0x0,0x0,0x0,0x810},{0x1,0x0,0x0,0x0,0x810},{0x1,0x0,0x0,0x0,0x810}},{{0x2,0x0,0x0,0x0,0x408},{0x2,0x0,0x0,0x0,0x1020},{0xA,0x0,0x0,0x0,0x200,0x8,0x0,0x0,0x1F80,0x1FFC,0x1,0x0,0x1800,0x1A26,0x6E8,0x0,0x0,0x412,0x8D9,0x4A},{0x2,0x0,0x0,0x0,0x408}}};
+
+/* Curve constants pre-converted to n-residue form */
+const BIG CURVE_B_NRES= {0xFAC,0x1FFF,0x1FFF,0x1FFF,0x7BF,0x178E,0x1FFF,0x1FFF,0x3FF,0x43D,0x1E33,0x1FFF,0x1FFF,0x6B2,0xFEC,0x1FD0,0x1FFF,0x87,0x568,0x2B};
+const BIG CURVE_Gx_NRES= {0x83D,0x0,0x0,0x0,0x1690,0x442,0x0,0x0,0xF00,0x10EA,0xE8,0x0,0x800,0x16CD,0x1EF2,0x17,0x0,0x3CE,0x1625,0x34};
+const BIG CURVE_Gy_NRES= {0x17D6,0x1FFF,0x1FFF,0x1FFF,0x3DF,0x1BC7,0x1FFF,0x1FFF,0x11FF,0x121E,0x1F19,0x1FFF,0xFFF,0x359,0x7F6,0x1FE8,0x1FFF,0x43,0x12B4,0x15};
+const BIG CURVE_Cru_NRES= {0x140A,0xB01,0x1C5E,0x72,0x1DB1,0x11CD,0xA11,0x1D8E,0x1BF6,0x1028,0xF6F,0x1653,0x1CA6,0x162B,0x167D,0x3B,0x0,0xAFC,0x18E6,0x39};
+const BIG CURVE_Fra_NRES= {0x1682,0x14A7,0x1D7,0x700,0x1EC8,0x1AF6,0x6C7,0x138F,0xE7F,0xBCD,0x1DAB,0x1925,0xED2,0x2FC,0x104C,0x1F3D,0x12AC,0x16C0,0x861,0x1F};
+const BIG CURVE_Frb_NRES= {0x991,0xB58,0x1E28,0x18FF,0x1BA7,0x512,0x1938,0xC70,0x1280,0x173B,0x256,0x6DA,0x92D,0x172A,0x169C,0xC2,0xD53,0xD51,0x77,0x2B};
+const BIG CURVE_Pxa_NRES= {0x5A2,0x12CF,0x1D8D,0x1555,0x6E5,0x383,0x6F,0x67A,0x502,0x1F6F,0xCC9,0x1A8C,0x11DC,0x1046,0x16C6,0x16A9,0x1DF5,0x67C,0x54C,0x1};
+const BIG CURVE_Pxb_NRES= {0xDEB,0x97A,0xF43,0x1768,0x1F8B,0x1B0C,0x21E,0xD78,0xAE2,0xB5F,0xD4E,0x85C,0x1A7A,0x1D8C,0x1795,0x9D0,0x30C,0xBB5,0x1FBF,0x10};
+const BIG CURVE_Pya_NRES= {0x92,0x410,0x19D1,0x1626,0x1D70,0x2E,0x1F44,0x618,0x12F1,0xEAD,0x1308,0x965,0xE88,0x98F,0x1F6D,0x418,0x2D1,0x35A,0x196E,0x1E};
+const BIG CURVE_Pyb_NRES= {0x19F5,0x1AEB,0x7F2,0x1ABC,0xDC0,0x8CF,0x894,0x1547,0x1962,0x1B21,0x164E,0xFF0,0x892,0x1DE2,0x953,0x143E,0x1D1,0x1A9A,0x139D,0x16};
 #endif
 
 #if CHUNK==32
 
 const chunk MConst=0x179435E5;
 const BIG Modulus= {0x13,0x18000000,0x4E9,0x2000000,0x8612,0x6C00000,0x6E8D1,0x10480000,0x252364};
+const BIG R2modp= {0x11CBCB5,0x18CE8A6E,0x3E367A8,0x97460E6,0x124F515F,0x123F0D2A,0x1E665ACB,0x19981D1D,0x14CC78};
+const BIG Rmodp= {0x1FFFEFAC,0x1FFFFFFF,0x1FFBC71E,0x7FFFFFF,0x1F8CC87A,0x12FFFFFF,0x1A0FEC35,0x21FFFFF,0x1595A0};
 const BIG CURVE_Order= {0xD,0x8000000,0x428,0x1F000000,0x7FF9,0x6C00000,0x6E8D1,0x10480000,0x252364};
 const BIG CURVE_Cof= {0x1};
 const BIG CURVE_B= {0x2};
@@ -85,12 +101,26 @@ const BIG CURVE_W[2]= {{0x3,0x0,0x81,0x3000000,0x618},{0x1,0x8000000,0x20}};
 const BIG CURVE_SB[2][2]= {{{0x4,0x8000000,0xA1,0x3000000,0x618},{0x1,0x8000000,0x20}},{{0x1,0x8000000,0x20},{0xA,0x8000000,0x3A7,0x1C000000,0x79E1,0x6C00000,0x6E8D1,0x10480000,0x252364}}};
 const BIG CURVE_WB[4]= {{0x0,0x4000000,0x10,0x1000000,0x208},{0x5,0x14000000,0x152,0xE000000,0x1C70,0xC00000,0xC489},{0x3,0xC000000,0xB1,0x7000000,0xE38,0x10600000,0x6244},{0x1,0xC000000,0x30,0x1000000,0x208}};
 const BIG CURVE_BB[4][4]= {{{0xD,0x4000000,0x418,0x1F000000,0x7FF9,0x6C00000,0x6E8D1,0x10480000,0x252364},{0xC,0x4000000,0x418,0x1F000000,0x7FF9,0x6C00000,0x6E8D1,0x10480000,0x252364},{0xC,0x4000000,0x418,0x1F000000,0x7FF9,0x6C00000,0x6E8D1,0x10480000,0x252364},{0x2,0x8000000,0x20}},{{0x1,0x8000000,0x20},{0xC,0x4000000,0x418,0x1F000000,0x7FF9,0x6C00000,0x6E8D1,0x10480000,0x252364},{0xD,0x4000000,0x418,0x1F000000,0x7FF9,0x6C00000,0x6E8D1,0x10480000,0x252364},{0xC,0x4000000,0x418,0x1F000000,0x7FF9,0x6C00000,0x6E8D1,0x10480000,0x252364}},{{0x2,0x8000000,0x20},{0x1,0x8000000,0x20},{0x1,0x8000000,0x20},{0x1,0x8000000,0x20}},{{0x2,0x4000000,0x10},{0x2,0x10000000,0x40},{0xA,0x0,0x408,0x1F000000,0x7FF9,0x6C00000,0x6E8D1,0x10480000,0x252364},{0x2,0x4000000,0x10}}};
+
+/* Curve constants pre-converted to n-residue form */
+const BIG CURVE_B_NRES= {0x1FFFDF45,0x7FFFFFF,0x1FF78954,0xDFFFFFF,0x1F190AE2,0x1F3FFFFF,0x1418EF99,0x13F7FFFF,0x607DB};
+const BIG CURVE_Gx_NRES= {0x1067,0x18000000,0x43DCA,0x1A000000,0x73BD97,0x13C00000,0x5F6FC9B,0xE280000,0xF8DC4};
+const BIG CURVE_Gy_NRES= {0x1FFFEFAC,0x1FFFFFFF,0x1FFBC71E,0x7FFFFFF,0x1F8CC87A,0x12FFFFFF,0x1A0FEC35,0x21FFFFF,0x1595A0};
+const BIG CURVE_Cru_NRES= {0x12C06801,0x19039717,0x231C903,0xDDBB1CA,0x17B73A91,0x110A6B29,0xEE61291,0x7980000,0x14A3CE};
+const BIG CURVE_Fra_NRES= {0x1D29ED04,0x8380075,0x18FAF6F6,0x19FE71E6,0x1ED5AF35,0x18ED2C92,0xF60982F,0x1604AB3E,0x1F430D};
+const BIG CURVE_Frb_NRES= {0x2D6130F,0xFC7FF8A,0x7050DF3,0x8018E19,0x12AD6DC,0xDD2D36D,0x10A650A1,0x1A4354C1,0x5E056};
+const BIG CURVE_Pxa_NRES= {0xCB3CB44,0x5AAAF63,0xDE38337,0x1408CF40,0x664FDBC,0xD1DCD46,0xA6D8D04,0x13E77D6D,0x12A61};
+const BIG CURVE_Pxb_NRES= {0x1A5E9BD6,0xBBB43D0,0x3DB0CFC,0xB89AF02,0x6A72D7D,0x19A7A42E,0x142F2BD8,0x1DA8C313,0x10FDFA};
+const BIG CURVE_Pya_NRES= {0x9040124,0x10B13674,0x8802EEB,0xBC4C31F,0x19843AB6,0x1EE884B2,0x63EDA98,0x1AD0B448,0x1ECB70};
+const BIG CURVE_Pyb_NRES= {0x16BAF3EA,0xD5E1FC,0x1288CF6E,0x58AA8E8,0xB276C87,0x48927F8,0xF92A7DE,0x14D07468,0x169CEE};
 #endif
 
 #if CHUNK==64
 
 const chunk MConst=0x435E50D79435E5;
 const BIG Modulus= {0x13,0x13A7,0x80000000086121,0x40000001BA344D,0x25236482};
+const BIG R2modp= {0x2F2A96FF5E7E39,0x64E8642B96F13C,0x9926F7B00C7146,0x8321E7B4DACD24,0x1D127A2E};
+const BIG Rmodp= {0xFFFFFF7D07A8A8,0xFFFF7888802F07,0xFFC63D474548B7,0xF417D05FB10933,0x95E45DD};
 const BIG CURVE_Order= {0xD,0x800000000010A1,0x8000000007FF9F,0x40000001BA344D,0x25236482};
 const BIG CURVE_Cof= {0x1};
 const BIG CURVE_B= {0x2};
@@ -113,6 +143,18 @@ const BIG CURVE_W[2]= {{0x3,0x80000000000204,0x6181},{0x1,0x81}};
 const BIG CURVE_SB[2][2]= {{{0x4,0x80000000000285,0x6181},{0x1,0x81}},{{0x1,0x81},{0xA,0xE9D,0x80000000079E1E,0x40000001BA344D,0x25236482}}};
 const BIG CURVE_WB[4]= {{0x80000000000000,0x80000000000040,0x2080},{0x80000000000005,0x54A,0x8000000001C707,0x312241},{0x80000000000003,0x800000000002C5,0xC000000000E383,0x189120},{0x80000000000001,0x800000000000C1,0x2080}};
 const BIG CURVE_BB[4][4]= {{{0x8000000000000D,0x80000000001060,0x8000000007FF9F,0x40000001BA344D,0x25236482},{0x8000000000000C,0x80000000001060,0x8000000007FF9F,0x40000001BA344D,0x25236482},{0x8000000000000C,0x80000000001060,0x8000000007FF9F,0x40000001BA344D,0x25236482},{0x2,0x81}},{{0x1,0x81},{0x8000000000000C,0x80000000001060,0x8000000007FF9F,0x40000001BA344D,0x25236482},{0x8000000000000D,0x80000000001060,0x8000000007FF9F,0x40000001BA344D,0x25236482},{0x8000000000000C,0x80000000001060,0x8000000007FF9F,0x40000001BA344D,0x25236482}},{{0x2,0x81},{0x1,0x81},{0x1,0x81},{0x1,0x81}},{{0x80000000000002,0x40},{0x2,0x102},{0xA,0x80000000001020,0x8000000007FF9F,0x40000001BA344D,0x25236482},{0x80000000000002,0x40}}};
+
+/* Curve constants pre-converted to n-residue form */
+const BIG CURVE_B_NRES= {0xFFFFFEFA0F5150,0xFFFEF111005E0F,0xFF8C7A8E8A916F,0xE82FA0BF621267,0x12BC8BBB};
+const BIG CURVE_Gx_NRES= {0x82F8576B,0x87777FE49F,0x8039C2B8C31869,0x4BE82FA2092B19,0x1BC51EA4};
+const BIG CURVE_Gy_NRES= {0xFFFFFF7D07A8A8,0xFFFF7888802F07,0xFFC63D474548B7,0xF417D05FB10933,0x95E45DD};
+const BIG CURVE_Cru_NRES= {0x1796033FB3865D,0x284638C918E2A0,0x1BDB7807582576,0xDDC47711EC20DD,0x154C291};
+const BIG CURVE_Fra_NRES= {0x75E94F67A00D0A,0x9B1F5E5A70A722,0x2F6A9F2D430D95,0x1EB58E7F83C506,0x1C9382EF};
+const BIG CURVE_Frb_NRES= {0x8A16B0985FF309,0x64E0A1A58F6C84,0x509560D2C5538B,0x214A7182366F47,0x88FE193};
+const BIG CURVE_Pxa_NRES= {0x63659E5A1B3ACE,0x1BC7061F68B05,0x63327CC3BD5437,0xD4DAAB02D42FA3,0xC2BD3BD};
+const BIG CURVE_Pxb_NRES= {0xD0D2F4DE6A7468,0x87B61579CDF0B,0xE3537812E954B4,0xE858051A592E56,0x236E5072};
+const BIG CURVE_Pya_NRES= {0x74482008A1F696,0x7D10055B137B34,0x2CC1E5C570BD1E,0x8C723FD38F175E,0x19B0312A};
+const BIG CURVE_Pyb_NRES= {0xFCB5D79EF37300,0xA251198E065CE1,0x85938D72766BA3,0x1F1CE5B7830FFF,0xE9DA75A};
 #endif
 
 #endif
@@ -126,6 +168,8 @@ const int CURVE_A=0;
 
 const chunk MConst=0x4E5;
 const BIG Modulus= {0x713,0x15A5,0x1FBB,0x1B77,0xBE9,0x125D,0x13D1,0xAC2,0xA55,0x374,0x157C,0xDF1,0x1369,0x5D5,0x1BE8,0x29,0x517,0x6DB,0x48,0x48};
+const BIG R2modp= {0x1429,0x115A,0x1A81,0xA37,0x382,0x533,0x1CAB,0xDB,0x1D83,0x1EAB,0x11D2,0x646,0x4FE,0x1B4F,0x1E2F,0x142A,0x8B2,0x1F5F,0x6B1,0x42};
+const BIG Rmodp= {0x9D,0x1212,0x1E28,0x8,0x1DC6,0x4C8,0x7E,0x18,0x1055,0x19A7,0x437,0x1853,0xE75,0xCB6,0xE83,0xD84,0xD8,0x1943,0x1F,0x37};
 const BIG CURVE_Order= {0x10D,0x981,0x1FA3,0xAEE,0x3A7,0x59B,0xACB,0x692,0x8D4,0x74,0x157C,0xDF1,0x1369,0x5D5,0x1BE8,0x29,0x517,0x6DB,0x48,0x48};
 const BIG CURVE_Cof= {0x1};
 const BIG CURVE_B= {0x2};
@@ -143,12 +187,26 @@ const BIG CURVE_W[2]= {{0x403,0xC1C,0x18,0xC86,0x1842,0xCC1,0x906,0x430,0x181,0x
 const BIG CURVE_SB[2][2]= {{{0x504,0xC20,0x1018,0xE87,0x42,0xCC2,0x906,0x430,0x181,0x300},{0x101,0x4,0x1000,0x201,0x800}},{{0x101,0x4,0x1000,0x201,0x800},{0x1D0A,0x1D64,0x1F8A,0x1E68,0xB64,0x18D9,0x1C4,0x262,0x753,0x1D74,0x157B,0xDF1,0x1369,0x5D5,0x1BE8,0x29,0x517,0x6DB,0x48,0x48}}};
 const BIG CURVE_WB[4]= {{0x80,0x406,0x1808,0x280,0xC16,0x440,0x302,0xC10,0x80,0x100},{0xA85,0x462,0x102,0xA72,0x36B,0xE36,0xD4B,0x5F4,0x1EAD,0x1476,0x1621,0x6C6,0xDA4,0x90,0xC0},{0x583,0x232,0xC81,0x15B9,0x3B5,0x171B,0x6A5,0x12FA,0xF56,0x1A3B,0xB10,0x363,0x6D2,0x48,0x60},{0x181,0x40A,0x808,0x482,0x1416,0x440,0x302,0xC10,0x80,0x100}};
 const BIG CURVE_BB[4][4]= {{{0x8D,0x97F,0x7A3,0x9EE,0x1FA7,0x59A,0xACB,0x692,0x8D4,0x74,0x157C,0xDF1,0x1369,0x5D5,0x1BE8,0x29,0x517,0x6DB,0x48,0x48},{0x8C,0x97F,0x7A3,0x9EE,0x1FA7,0x59A,0xACB,0x692,0x8D4,0x74,0x157C,0xDF1,0x1369,0x5D5,0x1BE8,0x29,0x517,0x6DB,0x48,0x48},{0x8C,0x97F,0x7A3,0x9EE,0x1FA7,0x59A,0xACB,0x692,0x8D4,0x74,0x157C,0xDF1,0x1369,0x5D5,0x1BE8,0x29,0x517,0x6DB,0x48,0x48},{0x102,0x4,0x1000,0x201,0x800}},{{0x101,0x4,0x1000,0x201,0x800},{0x8C,0x97F,0x7A3,0x9EE,0x1FA7,0x59A,0xACB,0x692,0x8D4,0x74,0x157C,0xDF1,0x1369,0x5D5,0x1BE8,0x29,0x517,0x6DB,0x48,0x48},{0x8D,0x97F,0x7A3,0x9EE,0x1FA7,0x59A,0xACB,0x692,0x8D4,0x74,0x157C,0xDF1,0x1369,0x5D5,0x1BE8,0x29,0x517,0x6DB,0x48,0x48},{0x8C,0x97F,0x7A3,0x9EE,0x1FA7,0x59A,0xACB,0x692,0x8D4,0x74,0x157C,0xDF1,0x1369,0x5D5,0x1BE8,0x29,0x517,0x6DB,0x48,0x48}},{{0x102,0x4,0x1000,0x201,0x800},{0x101,0x4,0x1000,0x201,0x800},{0x101,0x4,0x1000,0x201,0x800},{0x101,0x4,0x1000,0x201,0x800}},{{0x82,0x2,0x1800,0x100,0x400},{0x202,0x8,0x0,0x403,0x1000},{0xA,0x97D,0xFA3,0x8ED,0x1BA7,0x59A,0xACB,0x692,0x8D4,0x74,0x157C,0xDF1,0x1369,0x5D5,0x1BE8,0x29,0x517,0x6DB,0x48,0x48},{0x82,0x2,0x1800,0x100,0x400}}};
+
+/* Curve constants pre-converted to n-residue form */
+const BIG CURVE_B_NRES= {0x1A27,0xE7E,0x1C95,0x499,0xFA2,0x1734,0xD2A,0x156D,0x1654,0xFDA,0x12F3,0x2B4,0x982,0x1397,0x11E,0x1ADF,0x1C99,0xBAA,0x1FF7,0x25};
+const BIG CURVE_Gx_NRES= {0x676,0x393,0x193,0x1B6F,0xE23,0xD94,0x1353,0xAAA,0x1A00,0x9CC,0x1144,0x159E,0x4F3,0x191F,0xD64,0x12A5,0x43E,0xD98,0x28,0x11};
+const BIG CURVE_Gy_NRES= {0x9D,0x1212,0x1E28,0x8,0x1DC6,0x4C8,0x7E,0x18,0x1055,0x19A7,0x437,0x1853,0xE75,0xCB6,0xE83,0xD84,0xD8,0x1943,0x1F,0x37};
+const BIG CURVE_Cru_NRES= {0x1B01,0x76B,0x11DA,0x66F,0x123B,0x16FC,0x1538,0x19F2,0x474,0x304,0x1326,0x1FFE,0x7A1,0xE35,0x127D,0x13AE,0x69,0x216,0xE20,0xA};
+const BIG CURVE_Fra_NRES= {0x565,0x14E0,0x1E5E,0x831,0x539,0x45D,0x12E9,0x9E7,0x11CF,0x1F26,0x1E1C,0x9F6,0x11D8,0x2C6,0x144,0xEBD,0x724,0x1CBC,0x1689,0x18};
+const BIG CURVE_Frb_NRES= {0x1AE,0xC5,0x15D,0x1346,0x6B0,0xE00,0xE8,0xDB,0x1886,0x44D,0x175F,0x3FA,0x191,0x30F,0x1AA4,0x116C,0x1DF2,0xA1E,0x9BE,0x2F};
+const BIG CURVE_Pxa_NRES= {0x134C,0x13B2,0xF9E,0x5FB,0x15C,0x1A,0x1B17,0x25,0x1630,0xBD7,0x6D6,0x420,0x1D00,0x1218,0xC4B,0x1946,0x14C7,0x1915,0xA47,0x18};
+const BIG CURVE_Pxb_NRES= {0x137D,0x1D8B,0x1AFF,0x615,0x1093,0x1E86,0x1AC0,0x1EE,0x1308,0xF37,0x88,0x1B5,0x3A,0x11A5,0xA56,0xF72,0xD4,0x7D6,0x1CD0,0x2D};
+const BIG CURVE_Pya_NRES= {0x11B0,0xED1,0x1EA0,0x1BF3,0x125B,0x1DCB,0x13A,0x9CF,0xC6C,0x62D,0x22,0x7E9,0x1903,0xF2D,0x10A9,0x135F,0xFBE,0x1F56,0x180,0x23};
+const BIG CURVE_Pyb_NRES= {0xD26,0xD9C,0x5E,0x1874,0x1F3,0x56F,0x17BE,0x10FB,0xB0B,0x13C7,0x1AAC,0xEDC,0x513,0x334,0xB71,0x1D2A,0x1752,0x1833,0x7AD,0x41};
 #endif
 
 #if CHUNK==32
 
 const chunk MConst=0x1914C4E5;
 const BIG Modulus= {0xEB4A713,0x14EDDFF7,0x1D192EAF,0x14AAAC29,0xD5F06E8,0x159B4B7C,0x53BE82E,0x1B6CA2E0,0x240120};
+const BIG R2modp= {0xC8F5B6B,0x5D9DD5A,0x137EDA29,0xE18327B,0x9B5E0A5,0x1BCDE3D1,0x5C506DD,0x3AE70B0,0x1867BD};
+const BIG Rmodp= {0x15CFDA27,0x11126792,0x12AB9A3E,0xCA956D6,0x4BCDFB5,0x174C10AD,0x1BE11E9C,0xEAB933A,0x12FFDD};
 const BIG CURVE_Order= {0xD30210D,0x13ABBBF4,0xCB2CD8E,0x11A86925,0xD5F00E8,0x159B4B7C,0x53BE82E,0x1B6CA2E0,0x240120};
 const BIG CURVE_Cof= {0x1};
 const BIG CURVE_B= {0x2};
@@ -166,12 +224,26 @@ const BIG CURVE_W[2]= {{0x1838403,0x1321803,0x106660E1,0x3024304,0x600},{0x8101,
 const BIG CURVE_SB[2][2]= {{{0x1840504,0x13A1E03,0x10666101,0x3024304,0x600},{0x8101,0x80600,0x20}},{{0x8101,0x80600,0x20},{0xBAC9D0A,0x1279A3F1,0x1C4C6CAD,0xEA62620,0xD5EFAE8,0x159B4B7C,0x53BE82E,0x1B6CA2E0,0x240120}}};
 const BIG CURVE_WB[4]= {{0x80C080,0xB0A0301,0x10222030,0x100C101,0x200},{0x88C4A85,0x15A9C820,0x14B71B0D,0x1D5A5F46,0x158868ED,0x106D21B1,0xC004},{0x4464583,0x1AD6E590,0xA5B8D8E,0x1EAD2FA3,0x1AC43476,0x83690D8,0x6002},{0x814181,0xB120901,0x10222050,0x100C101,0x200}};
 const BIG CURVE_BB[4][4]= {{{0xD2FE08D,0x13A7B8F4,0xCB2CD7E,0x11A86925,0xD5F00E8,0x159B4B7C,0x53BE82E,0x1B6CA2E0,0x240120},{0xD2FE08C,0x13A7B8F4,0xCB2CD7E,0x11A86925,0xD5F00E8,0x159B4B7C,0x53BE82E,0x1B6CA2E0,0x240120},{0xD2FE08C,0x13A7B8F4,0xCB2CD7E,0x11A86925,0xD5F00E8,0x159B4B7C,0x53BE82E,0x1B6CA2E0,0x240120},{0x8102,0x80600,0x20}},{{0x8101,0x80600,0x20},{0xD2FE08C,0x13A7B8F4,0xCB2CD7E,0x11A86925,0xD5F00E8,0x159B4B7C,0x53BE82E,0x1B6CA2E0,0x240120},{0xD2FE08D,0x13A7B8F4,0xCB2CD7E,0x11A86925,0xD5F00E8,0x159B4B7C,0x53BE82E,0x1B6CA2E0,0x240120},{0xD2FE08C,0x13A7B8F4,0xCB2CD7E,0x11A86925,0xD5F00E8,0x159B4B7C,0x53BE82E,0x1B6CA2E0,0x240120}},{{0x8102,0x80600,0x20},{0x8101,0x80600,0x20},{0x8101,0x80600,0x20},{0x8101,0x80600,0x20}},{{0x4082,0x40300,0x10},{0x10202,0x100C00,0x40},{0xD2FA00A,0x13A3B5F4,0xCB2CD6E,0x11A86925,0xD5F00E8,0x159B4B7C,0x53BE82E,0x1B6CA2E0,0x240120},{0x4082,0x40300,0x10}}};
+
+/* Curve constants pre-converted to n-residue form */
+const BIG CURVE_B_NRES= {0x1CEB0D3B,0xD36EF2D,0x83E05CD,0x4A80183,0x1C1AB882,0x18FCD5DD,0x1286550A,0x1EA8395,0x1FE9A};
+const BIG CURVE_Gx_NRES= {0x18E4CCEC,0x3DB7864,0xA6D9471,0x8015553,0x8A22733,0x1E4F3ACF,0x95AC991,0xCC10FA5,0x110143};
+const BIG CURVE_Gy_NRES= {0x15CFDA27,0x11126792,0x12AB9A3E,0xCA956D6,0x4BCDFB5,0x174C10AD,0x1BE11E9C,0xEAB933A,0x12FFDD};
+const BIG CURVE_Cru_NRES= {0x11DAF602,0x1B337C76,0x716FC91,0x11D33E55,0x9930C10,0xA7A1FFF,0xBA4FAE3,0x10B01A67,0xA7100};
+const BIG CURVE_Fra_NRES= {0x15380ACA,0x19418F97,0x1D245D29,0x73D3CF2,0xF0E7C9A,0xD1D84FB,0xF42882C,0x5E1C91D,0x18B44F};
+const BIG CURVE_Frb_NRES= {0x197C9C49,0x1BAC505F,0x1FF4D185,0xD6D6F36,0x1E508A4E,0x87DC680,0x15F96002,0x158AD9C2,0xB4CD1};
+const BIG CURVE_Pxa_NRES= {0x14ECA698,0x1C2FDBE7,0x2E01A0A,0x18C004BB,0x36B2F5E,0x11D00210,0x11989721,0x8AD31F2,0x18523E};
+const BIG CURVE_Pxb_NRES= {0x10AE3FE7,0x1E42CEC8,0x1B0557D4,0x177591B0,0x2E535F5,0x1468555E,0x1758C4EB,0x343923E,0x9E561};
+const BIG CURVE_Pya_NRES= {0x3B46360,0x1BDF9FA8,0x75DCB92,0x11B139E1,0x101118B5,0x1B9033F4,0x17E152F2,0x1AB3EFA6,0x230C07};
+const BIG CURVE_Pyb_NRES= {0x4B27339,0x1ED5C020,0x1AAC405F,0x1783734D,0x1FF74834,0x12B5EBF1,0x55AFA04,0x63131DA,0x1D3C4D};
 #endif
 
 #if CHUNK==64
 
 const chunk MConst=0xC5A872D914C4E5;
 const BIG Modulus= {0x9DBBFEEEB4A713,0x555614F464BABE,0x3696F8D5F06E8A,0x6517014EFA0BAB,0x240120DB};
+const BIG R2modp= {0xE4BBD09FF2103D,0x2F99966DF8976B,0x2BC099E13E06F0,0x14256FFE875FFF,0x1EDD4394};
+const BIG Rmodp= {0xDC983B411E7432,0x316330C2CD3A77,0x3EE71617AABCD6,0x37861AF68DF858,0x3B72EE};
 const BIG CURVE_Order= {0x75777E8D30210D,0xD43492B2CB363A,0x3696F8D5F00E88,0x6517014EFA0BAB,0x240120DB};
 const BIG CURVE_Cof= {0x1};
 const BIG CURVE_B= {0x2};
@@ -189,6 +261,18 @@ const BIG CURVE_W[2]= {{0x26430061838403,0x81218241998384,0x6001},{0x100C0000081
 const BIG CURVE_SB[2][2]= {{{0x2743C061840504,0x81218241998404,0x6001},{0x100C000008101,0x80}},{{0x100C000008101,0x80},{0x4F347E2BAC9D0A,0x5313107131B2B6,0x3696F8D5EFAE87,0x6517014EFA0BAB,0x240120DB}}};
 const BIG CURVE_WB[4]= {{0x6140602080C080,0x806080C08880C1,0x2000},{0xB53904088C4A85,0xAD2FA352DC6C36,0xDA436358868EDE,0x300120},{0x5ADCB204464583,0x5697D1A96E363B,0x6D21B1AC43476F,0x180090},{0x62412020814181,0x806080C0888141,0x2000}};
 const BIG CURVE_BB[4][4]= {{{0x74F71E8D2FE08D,0xD43492B2CB35FA,0x3696F8D5F00E88,0x6517014EFA0BAB,0x240120DB},{0x74F71E8D2FE08C,0xD43492B2CB35FA,0x3696F8D5F00E88,0x6517014EFA0BAB,0x240120DB},{0x74F71E8D2FE08C,0xD43492B2CB35FA,0x3696F8D5F00E88,0x6517014EFA0BAB,0x240120DB},{0x100C000008102,0x80}},{{0x100C000008101,0x80},{0x74F71E8D2FE08C,0xD43492B2CB35FA,0x3696F8D5F00E88,0x6517014EFA0BAB,0x240120DB},{0x74F71E8D2FE08D,0xD43492B2CB35FA,0x3696F8D5F00E88,0x6517014EFA0BAB,0x240120DB},{0x74F71E8D2FE08C,0xD43492B2CB35FA,0x3696F8D5F00E88,0x6517014EFA0BAB,0x240120DB}},{{0x100C000008102,0x80},{0x100C000008101,0x80},{0x100C000008101,0x80},{0x100C000008101,0x80}},{{0x806000004082,0x40},{0x2018000010202,0x100},{0x7476BE8D2FA00A,0xD43492B2CB35BA,0x3696F8D5F00E88,0x6517014EFA0BAB,0x240120DB},{0x806000004082,0x40}}};
+
+/* Curve constants pre-converted to n-residue form */
+const BIG CURVE_B_NRES= {0xB93076823CE864,0x62C661859A74EF,0x7DCE2C2F5579AC,0x6F0C35ED1BF0B0,0x76E5DC};
+const BIG CURVE_Gx_NRES= {0xC123C3AD9632E1,0x23F2E431978046,0xF7AFE2BE45B1B4,0x2D90E6586C1352,0x23C5ADED};
+const BIG CURVE_Gy_NRES= {0xDC983B411E7432,0x316330C2CD3A77,0x3EE71617AABCD6,0x37861AF68DF858,0x3B72EE};
+const BIG CURVE_Cru_NRES= {0xF5FCE43BCE5069,0xEDA75BFC66C5A3,0xB49D9608A2873B,0xF6F5CE74233B0A,0x12046652};
+const BIG CURVE_Fra_NRES= {0x14EDE8C86EDEB2,0x5227F717ECAAF,0xC5A4B545F6B343,0x352052222088EA,0x1FE2E6C3};
+const BIG CURVE_Frb_NRES= {0x88CE162645C861,0x50339582E5F00F,0x70F2438FF9BB47,0x2FF6AF2CD982C0,0x41E3A18};
+const BIG CURVE_Pxa_NRES= {0x472C4AD31F42B0,0x8B7E8C286EB654,0x855CF431055089,0x210EF2E0ADF14F,0x192BAD61};
+const BIG CURVE_Pxb_NRES= {0xBE3A60036D87DB,0xC8B33D51C34A87,0x30F2681C3E681C,0xF60FFAA6082000,0x11AA9AAA};
+const BIG CURVE_Pya_NRES= {0xD15DA04EB04C2,0x5B61C982393AE2,0x836CDC3A983BFA,0x182C18AE16CCF6,0xD453FA5};
+const BIG CURVE_Pyb_NRES= {0x3338E497642485,0x5A908061A3AE4E,0xE3A6AD15DC733B,0xDCD6F2E03478CE,0x1122FCC5};
 #endif
 
 #endif
@@ -200,6 +284,8 @@ const int CURVE_A=0;
 
 const chunk MConst=0x1CDD;
 const BIG Modulus= {0x48B,0x305,0xAED,0x5B8,0x1E8B,0xB28,0x3C3,0x1C85,0xF93,0x40E,0x1400,0x1713,0xF3,0x710,0x16DD,0xB55,0x10F,0x412,0x1,0x48};
+const BIG R2modp= {0x1730,0x240,0x1ECA,0x13EC,0x90E,0x1319,0x16C,0x16D8,0x17AF,0xAF7,0x7AE,0x1938,0x10CF,0x1383,0x1E02,0x1105,0xA86,0x160D,0x1966,0x26};
+const BIG Rmodp= {0x1EA5,0xABA,0xD58,0x19A1,0x490,0x12EC,0x16C5,0x93D,0x1FB8,0x159A,0xBF1,0x1056,0x146B,0x1EC,0x85A,0x1F2A,0x838,0x140A,0x1F80,0x37};
 const BIG CURVE_Order= {0xBF5,0xD51,0x944,0x16E3,0x1D7F,0x1C19,0x1EDC,0x1C24,0xF8D,0x10E,0x1400,0x1713,0xF3,0x710,0x16DD,0xB55,0x10F,0x412,0x1,0x48};
 const BIG CURVE_Cof= {0x1};
 const BIG CURVE_B= {0x2};
@@ -217,12 +303,26 @@ const BIG CURVE_W[2]= {{0x1083,0x9A3,0xA8,0xEC5,0x110B,0xF0E,0x4E6,0x60,0x6,0x30
 const BIG CURVE_SB[2][2]= {{{0x148C,0xFAB,0x128,0xECD,0x190B,0xF0E,0x4E6,0x60,0x6,0x300},{0x409,0x608,0x80,0x8,0x800}},{{0x409,0x608,0x80,0x8,0x800},{0x1B72,0x3AD,0x89C,0x81E,0xC74,0xD0B,0x19F6,0x1BC4,0xF87,0x1E0E,0x13FF,0x1713,0xF3,0x710,0x16DD,0xB55,0x10F,0x412,0x1,0x48}}};
 const BIG CURVE_WB[4]= {{0x224,0x1385,0x1522,0x4E5,0x1459,0x504,0x1A2,0x20,0x2,0x100},{0xF19,0x187,0xB3C,0x14AE,0x1D5,0x1B9,0x18D5,0xA2E,0x396,0xDCD,0x1228,0x1FA,0x824,0x2,0xC0},{0x188F,0x245,0x5BE,0x1A59,0x12EA,0x10DC,0xC6A,0x517,0x11CB,0x6E6,0x914,0xFD,0x412,0x1,0x60},{0x62D,0x198D,0x15A2,0x4ED,0x1C59,0x504,0x1A2,0x20,0x2,0x100}};
 const BIG CURVE_BB[4][4]= {{{0x9F1,0xA4D,0x904,0x16DF,0x197F,0x1C19,0x1EDC,0x1C24,0xF8D,0x10E,0x1400,0x1713,0xF3,0x710,0x16DD,0xB55,0x10F,0x412,0x1,0x48},{0x9F0,0xA4D,0x904,0x16DF,0x197F,0x1C19,0x1EDC,0x1C24,0xF8D,0x10E,0x1400,0x1713,0xF3,0x710,0x16DD,0xB55,0x10F,0x412,0x1,0x48},{0x9F0,0xA4D,0x904,0x16DF,0x197F,0x1C19,0x1EDC,0x1C24,0xF8D,0x10E,0x1400,0x1713,0xF3,0x710,0x16DD,0xB55,0x10F,0x412,0x1,0x48},{0x40A,0x608,0x80,0x8,0x800}},{{0x409,0x608,0x80,0x8,0x800},{0x9F0,0xA4D,0x904,0x16DF,0x197F,0x1C19,0x1EDC,0x1C24,0xF8D,0x10E,0x1400,0x1713,0xF3,0x710,0x16DD,0xB55,0x10F,0x412,0x1,0x48},{0x9F1,0xA4D,0x904,0x16DF,0x197F,0x1C19,0x1EDC,0x1C24,0xF8D,0x10E,0x1400,0x1713,0xF3,0x710,0x16DD,0xB55,0x10F,0x412,0x1,0x48},{0x9F0,0xA4D,0x904,0x16DF,0x197F,0x1C19,0x1EDC,0x1C24,0xF8D,0x10E,0x1400,0x1713,0xF3,0x710,0x16DD,0xB55,0x10F,0x412,0x1,0x48}},{{0x40A,0x608,0x80,0x8,0x800},{0x409,0x608,0x80,0x8,0x800},{0x409,0x608,0x80,0x8,0x800},{0x409,0x608,0x80,0x8,0x800}},{{0x206,0x304,0x40,0x4,0x400},{0x812,0xC10,0x100,0x10,0x1000},{0x7EA,0x749,0x8C4,0x16DB,0x157F,0x1C19,0x1EDC,0x1C24,0xF8D,0x10E,0x1400,0x1713,0xF3,0x710,0x16DD,0xB55,0x10F,0x412,0x1,0x48},{0x206,0x304,0x40,0x4,0x400}}};
+
+/* Curve constants pre-converted to n-residue form */
+const BIG CURVE_B_NRES= {0x18BF,0x1270,0xFC3,0xD8A,0xA96,0x1AAF,0x9C7,0x15F6,0xFDC,0x727,0x3E3,0x999,0x7E3,0x1CC9,0x19D6,0x12FE,0xF62,0x402,0x1F00,0x27};
+const BIG CURVE_Gx_NRES= {0x5E6,0x184A,0x1D94,0xC16,0x19FA,0x183C,0xCFD,0x1347,0xFDB,0xE73,0x80E,0x6BD,0xC88,0x523,0xE83,0xC2B,0x18D6,0x1007,0x80,0x10};
+const BIG CURVE_Gy_NRES= {0x1EA5,0xABA,0xD58,0x19A1,0x490,0x12EC,0x16C5,0x93D,0x1FB8,0x159A,0xBF1,0x1056,0x146B,0x1EC,0x85A,0x1F2A,0x838,0x140A,0x1F80,0x37};
+const BIG CURVE_Cru_NRES= {0x1856,0x1504,0xCFE,0x3E2,0xAEF,0x1245,0x7F3,0xEBE,0x1A24,0x97D,0x1302,0xFE3,0x177F,0xC9E,0x12C5,0x819,0x1546,0x1DD9,0x66B,0x3B};
+const BIG CURVE_Fra_NRES= {0x19AA,0x9C6,0x1F66,0x11B2,0x1758,0x1371,0x18CA,0x1CE8,0x2F5,0x55D,0xF7,0x1080,0xCE8,0x14C9,0x12B6,0x1A65,0x1964,0x120F,0x7DA,0xD};
+const BIG CURVE_Frb_NRES= {0xAE1,0x193E,0xB86,0x1405,0x732,0x17B7,0xAF8,0x1F9C,0xC9D,0x1EB1,0x1308,0x693,0x140B,0x1246,0x426,0x10F0,0x7AA,0x1202,0x1826,0x3A};
+const BIG CURVE_Pxa_NRES= {0xA9F,0x1338,0x11A8,0x1F6C,0xDBF,0x8E8,0x1AA3,0x932,0x3AE,0xEAB,0x12F8,0x476,0x9EC,0x9E1,0x1CB2,0xA2,0xA6C,0x7EC,0xF84,0x2};
+const BIG CURVE_Pxb_NRES= {0x6BE,0x1973,0x1E,0x175A,0x188A,0x1ED,0x1C79,0xFC7,0xA2F,0x61E,0x12EA,0x12BF,0x1283,0xB19,0x1214,0x14C5,0x1AC9,0x1D3C,0xC1A,0xA};
+const BIG CURVE_Pya_NRES= {0xFD1,0x1A68,0x1E5E,0x676,0x1778,0x1BE8,0x1D01,0x1705,0x352,0xFB9,0x1A4E,0xF61,0x112A,0x12AE,0xE1C,0x1D9B,0x1795,0x1256,0x1D44,0x42};
+const BIG CURVE_Pyb_NRES= {0x1318,0x1D8F,0x5D2,0x186D,0x176B,0x3F8,0x1AEB,0x77D,0x1E49,0xE8B,0x1989,0x5E5,0x1A22,0xB80,0x1AA0,0x1F50,0x28C,0x12E9,0xEE1,0x3B};
 #endif
 
 #if CHUNK==32
 
 const chunk MConst=0x6505CDD;
 const BIG Modulus= {0x1460A48B,0x596E15D,0x1C35947A,0x1F27C851,0x1D00081C,0x10079DC4,0xAB6DD38,0x104821EB,0x240004};
+const BIG R2modp= {0x185F13AA,0x12110CA9,0x2BB099C,0x1F2E255F,0xDAE4783,0xE0ABDAE,0xD8A4FFF,0x44FF6D,0x59662};
+const BIG Rmodp= {0xE4E18BF,0xB3629F8,0x1C7D57AA,0x1FB95F64,0x8F8CE4E,0x93F1A66,0x1FD9D6E6,0x1009EC52,0x13FC00};
 const BIG CURVE_Order= {0x11AA2BF5,0x1FDB8D28,0xDCE0CF5,0x1F1BC24F,0x1D00021C,0x10079DC4,0xAB6DD38,0x104821EB,0x240004};
 const BIG CURVE_Cof= {0x1};
 const BIG CURVE_B= {0x2};
@@ -240,12 +340,26 @@ const BIG CURVE_W[2]= {{0x1347083,0x5BB1415,0xE678744,0xC0602,0x600},{0xC10409,0
 const BIG CURVE_SB[2][2]= {{{0x1F5748C,0x5BB3425,0xE678764,0xC0602,0x600},{0xC10409,0x2010,0x20}},{{0xC10409,0x2010,0x20},{0x1075BB72,0x1A207913,0x1F6685B1,0x1F0FBC4C,0x1CFFFC1C,0x10079DC4,0xAB6DD38,0x104821EB,0x240004}}};
 const BIG CURVE_WB[4]= {{0xA70A224,0xC9396A4,0x1A228251,0x40200,0x200},{0x1030EF19,0xAD2B967,0xD50DC87,0x72CA2EC,0x148A1B9A,0x241207E,0xC000},{0x1848B88F,0x156964B7,0x6A86E4B,0x3965176,0xA450DCD,0x120903F,0x6000},{0xB31A62D,0xC93B6B4,0x1A228271,0x40200,0x200}};
 const BIG CURVE_BB[4][4]= {{{0x1149A9F1,0x1FDB7D20,0xDCE0CE5,0x1F1BC24F,0x1D00021C,0x10079DC4,0xAB6DD38,0x104821EB,0x240004},{0x1149A9F0,0x1FDB7D20,0xDCE0CE5,0x1F1BC24F,0x1D00021C,0x10079DC4,0xAB6DD38,0x104821EB,0x240004},{0x1149A9F0,0x1FDB7D20,0xDCE0CE5,0x1F1BC24F,0x1D00021C,0x10079DC4,0xAB6DD38,0x104821EB,0x240004},{0xC1040A,0x2010,0x20}},{{0xC10409,0x2010,0x20},{0x1149A9F0,0x1FDB7D20,0xDCE0CE5,0x1F1BC24F,0x1D00021C,0x10079DC4,0xAB6DD38,0x104821EB,0x240004},{0x1149A9F1,0x1FDB7D20,0xDCE0CE5,0x1F1BC24F,0x1D00021C,0x10079DC4,0xAB6DD38,0x104821EB,0x240004},{0x1149A9F0,0x1FDB7D20,0xDCE0CE5,0x1F1BC24F,0x1D00021C,0x10079DC4,0xAB6DD38,0x104821EB,0x240004}},{{0xC1040A,0x2010,0x20},{0xC10409,0x2010,0x20},{0xC10409,0x2010,0x20},{0xC10409,0x2010,0x20}},{{0x608206,0x1008,0x10},{0x1820812,0x4020,0x40},{0x10E927EA,0x1FDB6D18,0xDCE0CD5,0x1F1BC24F,0x1D00021C,0x10079DC4,0xAB6DD38,0x104821EB,0x240004},{0x608206,0x1008,0x10}}};
+
+/* Curve constants pre-converted to n-residue form */
+const BIG CURVE_B_NRES= {0x83B8CF3,0x10D57293,0x1CC51ADA,0x4AF677,0x14F19481,0x2769707,0x14FCD094,0xFCBB6BA,0x3F7FC};
+const BIG CURVE_Gx_NRES= {0x6128BCC,0x1A60B765,0x1FB83CCF,0x1F6E68EC,0x140739CD,0x6C8835E,0xADD0652,0x3E3598,0x100404};
+const BIG CURVE_Gy_NRES= {0xE4E18BF,0xB3629F8,0x1C7D57AA,0x1FB95F64,0x8F8CE4E,0x93F1A66,0x1FD9D6E6,0x1009EC52,0x13FC00};
+const BIG CURVE_Cru_NRES= {0xE08C21,0x98831E2,0x23CB0DD,0x96A0F76,0x1C811DDA,0xD705A2C,0x1BAEAD91,0x1E852FA4,0x17335A};
+const BIG CURVE_Fra_NRES= {0x1271B354,0x188D97D9,0x195371BA,0xBD79D18,0x7B9574,0x12CE8840,0x19656D4C,0x107E5934,0xD3ED4};
+const BIG CURVE_Frb_NRES= {0x1EEF137,0xD094984,0x2E222BF,0x13502B39,0x1C8472A8,0x1D391584,0x11516FEB,0x1FC9C8B6,0x16C12F};
+const BIG CURVE_Pxa_NRES= {0x4CE153E,0x1FFB646A,0x1468E86D,0xEB9265A,0x97C3AAC,0x29EC23B,0x8B9649E,0x1F629B01,0x27C21};
+const BIG CURVE_Pxb_NRES= {0x165CCD7C,0xABAD007,0xF21EDC4,0x8BDF8FC,0x19751879,0x1328395F,0x116428B1,0x9E6B269,0xA60D7};
+const BIG CURVE_Pya_NRES= {0x2397B17,0x129CD63A,0x4065441,0xE23186B,0x2736C7,0xD0B09EC,0x1C255BF2,0x26DC38F,0x1EEA20};
+const BIG CURVE_Pyb_NRES= {0x30341A5,0x62C8817,0x12E6441,0x19FD2769,0x1FC4B212,0x119A852D,0x97E637F,0x7008153,0x177708};
 #endif
 
 #if CHUNK==64
 
 const chunk MConst=0xFE6A47A6505CDD;
 const BIG Modulus= {0xB2DC2BB460A48B,0x93E428F0D651E8,0xF3B89D00081CF,0x410F5AADB74E20,0x24000482};
+const BIG R2modp= {0x3DEDFF9C685AC7,0x2C23614B469C72,0x9A05E14FAA885,0xDA88B448E34338,0x4562107};
+const BIG Rmodp= {0x5D4742FA1D48BF,0xFA92A65BC7FB22,0xAF26317702AA28,0xECB368585B67A0,0x3FC7AE0};
 const BIG CURVE_Order= {0xFB71A511AA2BF5,0x8DE127B73833D7,0xF3B89D00021CF,0x410F5AADB74E20,0x24000482};
 const BIG CURVE_Cof= {0x1};
 const BIG CURVE_B= {0x2};
@@ -263,6 +377,18 @@ const BIG CURVE_W[2]= {{0xB76282A1347083,0x60301399E1D10,0x6000},{0x40200C10409,
 const BIG CURVE_SB[2][2]= {{{0xB76684A1F5748C,0x60301399E1D90,0x6000},{0x40200C10409,0x80}},{{0x40200C10409,0x80},{0x440F227075BB72,0x87DE267D9A16C7,0xF3B89CFFFC1CF,0x410F5AADB74E20,0x24000482}}};
 const BIG CURVE_WB[4]= {{0x9272D48A70A224,0x20100688A0945,0x2000},{0x5A572CF030EF19,0x9651763543721D,0x8240FD48A1B9A3,0x300004},{0xAD2C96F848B88F,0xCB28BB1AA1B92E,0x41207EA450DCD1,0x180002},{0x9276D68B31A62D,0x20100688A09C5,0x2000}};
 const BIG CURVE_BB[4][4]= {{{0xFB6FA41149A9F1,0x8DE127B7383397,0xF3B89D00021CF,0x410F5AADB74E20,0x24000482},{0xFB6FA41149A9F0,0x8DE127B7383397,0xF3B89D00021CF,0x410F5AADB74E20,0x24000482},{0xFB6FA41149A9F0,0x8DE127B7383397,0xF3B89D00021CF,0x410F5AADB74E20,0x24000482},{0x40200C1040A,0x80}},{{0x40200C10409,0x80},{0xFB6FA41149A9F0,0x8DE127B7383397,0xF3B89D00021CF,0x410F5AADB74E20,0x24000482},{0xFB6FA41149A9F1,0x8DE127B7383397,0xF3B89D00021CF,0x410F5AADB74E20,0x24000482},{0xFB6FA41149A9F0,0x8DE127B7383397,0xF3B89D00021CF,0x410F5AADB74E20,0x24000482}},{{0x40200C1040A,0x80},{0x40200C10409,0x80},{0x40200C10409,0x80},{0x40200C10409,0x80}},{{0x20100608206,0x40},{0x80401820812,0x100},{0xFB6DA310E927EA,0x8DE127B7383357,0xF3B89D00021CF,0x410F5AADB74E20,0x24000482},{0x20100608206,0x40}}};
+
+/* Curve constants pre-converted to n-residue form */
+const BIG CURVE_B_NRES= {0xBA8E85F43A917E,0xF5254CB78FF644,0x5E4C62EE055451,0xD966D0B0B6CF41,0x7F8F5C1};
+const BIG CURVE_Gx_NRES= {0x5594E8BA435BCC,0x995182950E56C6,0x60155858FDD7A6,0x545BF2555BE67F,0x200389A1};
+const BIG CURVE_Gy_NRES= {0x5D4742FA1D48BF,0xFA92A65BC7FB22,0xAF26317702AA28,0xECB368585B67A0,0x3FC7AE0};
+const BIG CURVE_Cru_NRES= {0x2D5B6ED6F3B4A2,0x590BD8C521D67D,0x127E812FE29A7D,0xB41517C1374FDA,0x186257C7};
+const BIG CURVE_Fra_NRES= {0x37F7454CE4D54,0x518EBA1E8DB82,0x52DE9FC18DD6A,0x7D2720D9DC532E,0x6DA21C5};
+const BIG CURVE_Frb_NRES= {0xAF5CB75F925737,0x8ECB3D4EED7666,0xA0D9FD3E7A465,0xC3E839D3DAFAF2,0x1D25E2BC};
+const BIG CURVE_Pxa_NRES= {0xDEF4629C944F0C,0x9A01C0759D6140,0x7071064E8CE98B,0x7AFC84D842303A,0x1D5B4A1B};
+const BIG CURVE_Pxb_NRES= {0xF1876E6964CD88,0x6D88DF0B3280F,0x94ED2E9141D4B8,0x918F1E5AACE374,0x1013A5BE};
+const BIG CURVE_Pya_NRES= {0x4E93102C545670,0x2E7EC52E5E5097,0x6AC278E7EFD413,0xCD076FAC4AD1F9,0x21A1DC8F};
+const BIG CURVE_Pyb_NRES= {0x7F433DCDA92234,0xFF9A593A72A541,0xEB9B92484AB16,0xDECACB16BD0465,0x1A3D5D4C};
 #endif
 
 
@@ -277,6 +403,8 @@ const int CURVE_A=0;
 
 const chunk MConst=0x1E85;
 const BIG Modulus= {0x15B3,0xDA,0x1BD7,0xC47,0x1BE6,0x1F70,0x24,0x1DC3,0x1FD6,0x1921,0x19B4,0x14C6,0x1647,0x1EEF,0x16C2,0x541,0x870,0x0,0x0,0x48};
+const BIG R2modp= {0x1527,0x146B,0x12A7,0x1A60,0x1E0A,0x1382,0x2BC,0x1D3F,0xB30,0xA8,0xD19,0x11AB,0x1D40,0x1965,0xD6D,0x643,0x10FF,0x1BC7,0x1E61,0x31};
+const BIG Rmodp= {0xBFD,0x1F79,0x1615,0x1446,0xF4E,0x1F2D,0xFAC,0x1CEC,0x1220,0x7FE,0x733,0x143F,0xA5F,0x1832,0x13F0,0xDFE,0x67D,0x1FE2,0x1FFF,0x37};
 const BIG CURVE_Order= {0x1F6D,0x1758,0x98D,0x381,0xBE1,0x367,0x1324,0x1DC1,0x1FD6,0x1621,0x19B4,0x14C6,0x1647,0x1EEF,0x16C2,0x541,0x870,0x0,0x0,0x48};
 const BIG CURVE_Cof= {0x1};
 const BIG CURVE_B= {0x2};
@@ -294,12 +422,26 @@ const BIG CURVE_W[2]= {{0xB83,0x117F,0x1245,0x8C6,0x5,0x1C09,0xD00,0x1,0x0,0x300
 const BIG CURVE_SB[2][2]= {{{0x10E4,0xD80,0x1247,0x8C6,0x805,0x1C09,0xD00,0x1,0x0,0x300},{0x561,0x1C01,0x1,0x0,0x800}},{{0x561,0x1C01,0x1,0x0,0x800},{0x13EA,0x5D9,0x1748,0x1ABA,0xBDB,0x75E,0x623,0x1DC0,0x1FD6,0x1321,0x19B4,0x14C6,0x1647,0x1EEF,0x16C2,0x541,0x870,0x0,0x0,0x48}}};
 const BIG CURVE_WB[4]= {{0x4B0,0x13D4,0x615,0x1842,0x401,0x958,0xF00,0x0,0x0,0x100},{0x475,0x1110,0x56F,0x1BF3,0x36C,0x1FCD,0x329,0x1DB5,0x1E94,0xE03,0xA83,0x10E0,0x0,0x0,0xC0},{0xB93,0x788,0x12B8,0xDF9,0x13B6,0x1FE6,0x1194,0xEDA,0x1F4A,0x1701,0x541,0x870,0x0,0x0,0x60},{0xA11,0xFD5,0x617,0x1842,0xC01,0x958,0xF00,0x0,0x0,0x100}};
 const BIG CURVE_BB[4][4]= {{{0xCBD,0x1958,0x98C,0x381,0x7E1,0x367,0x1324,0x1DC1,0x1FD6,0x1621,0x19B4,0x14C6,0x1647,0x1EEF,0x16C2,0x541,0x870,0x0,0x0,0x48},{0xCBC,0x1958,0x98C,0x381,0x7E1,0x367,0x1324,0x1DC1,0x1FD6,0x1621,0x19B4,0x14C6,0x1647,0x1EEF,0x16C2,0x541,0x870,0x0,0x0,0x48},{0xCBC,0x1958,0x98C,0x381,0x7E1,0x367,0x1324,0x1DC1,0x1FD6,0x1621,0x19B4,0x14C6,0x1647,0x1EEF,0x16C2,0x541,0x870,0x0,0x0,0x48},{0x562,0x1C01,0x1,0x0,0x800}},{{0x561,0x1C01,0x1,0x0,0x800},{0xCBC,0x1958,0x98C,0x381,0x7E1,0x367,0x1324,0x1DC1,0x1FD6,0x1621,0x19B4,0x14C6,0x1647,0x1EEF,0x16C2,0x541,0x870,0x0,0x0,0x48},{0xCBD,0x1958,0x98C,0x381,0x7E1,0x367,0x1324,0x1DC1,0x1FD6,0x1621,0x19B4,0x14C6,0x1647,0x1EEF,0x16C2,0x541,0x870,0x0,0x0,0x48},{0xCBC,0x1958,0x98C,0x381,0x7E1,0x367,0x1324,0x1DC1,0x1FD6,0x1621,0x19B4,0x14C6,0x1647,0x1EEF,0x16C2,0x541,0x870,0x0,0x0,0x48}},{{0x562,0x1C01,0x1,0x0,0x800},{0x561,0x1C01,0x1,0x0,0x800},{0x561,0x1C01,0x1,0x0,0x800},{0x561,0x1C01,0x1,0x0,0x800}},{{0x12B2,0x1E00,0x0,0x0,0x400},{0xAC2,0x1802,0x3,0x0,0x1000},{0x1A0A,0x1B57,0x98B,0x381,0x3E1,0x367,0x1324,0x1DC1,0x1FD6,0x1621,0x19B4,0x14C6,0x1647,0x1EEF,0x16C2,0x541,0x870,0x0,0x0,0x48},{0x12B2,0x1E00,0x0,0x0,0x400}}};
+
+/* Curve constants pre-converted to n-residue form */
+const BIG CURVE_B_NRES= {0x247,0x1E18,0x1054,0x1C45,0x2B6,0x1EEA,0x1F34,0x1C15,0x46A,0x16DB,0x14B1,0x13B7,0x1E77,0x1174,0x111E,0x16BB,0x48A,0x1FC4,0x1FFF,0x27};
+const BIG CURVE_Gx_NRES= {0x9B6,0x161,0x5C1,0x1801,0xC97,0x43,0x1078,0xD6,0xDB6,0x1123,0x1281,0x87,0xBE8,0x6BD,0x2D2,0x1743,0x1F2,0x1E,0x0,0x10};
+const BIG CURVE_Gy_NRES= {0xBFD,0x1F79,0x1615,0x1446,0xF4E,0x1F2D,0xFAC,0x1CEC,0x1220,0x7FE,0x733,0x143F,0xA5F,0x1832,0x13F0,0xDFE,0x67D,0x1FE2,0x1FFF,0x37};
+const BIG CURVE_Cru_NRES= {0x136A,0x1B5B,0x19A3,0x1D75,0x6B3,0x17B3,0xF48,0x1116,0x19B,0xC83,0xF3D,0x1FB2,0xBE,0x1DD4,0x10EF,0x158,0x1CC4,0x1B39,0x289,0x37};
+const BIG CURVE_Fra_NRES= {0xF26,0x1E65,0x173E,0x10B5,0x26A,0x1741,0x1D6F,0xAC7,0x16EC,0x11A6,0xAB2,0xADB,0x198B,0x1FB8,0x596,0xCA2,0x14E7,0x1CC8,0xE02,0x20};
+const BIG CURVE_Frb_NRES= {0x68D,0x275,0x498,0x1B92,0x197B,0x82F,0x2B5,0x12FB,0x8EA,0x77B,0xF02,0x9EB,0x1CBC,0x1F36,0x112B,0x189F,0x1388,0x337,0x11FD,0x27};
+const BIG CURVE_Pxa_NRES= {0x94,0x448,0x1586,0xF2,0x1B14,0x125F,0xF18,0x4E1,0xBEF,0x165C,0x963,0x150,0xF74,0x12C8,0x13D2,0x374,0x1683,0xC22,0x1CDA,0x1D};
+const BIG CURVE_Pxb_NRES= {0x1E9F,0x14DD,0x1F0,0x261,0x20,0x1510,0x3A,0xF75,0x165B,0x14A1,0x146F,0x1119,0x4A4,0x608,0x741,0xEC2,0x1D84,0x152,0x85,0x38};
+const BIG CURVE_Pya_NRES= {0x21E,0x9D5,0x18D7,0x1BDE,0x1D30,0xAB9,0xDF0,0x11B4,0x1BE,0x1333,0x13D2,0xB64,0x792,0x289,0x1C7A,0x1A7F,0x187E,0x1D39,0x18BD,0x2B};
+const BIG CURVE_Pyb_NRES= {0xBB7,0x1F3F,0x17F5,0x129A,0x1CB4,0x8D1,0x1A6,0x1313,0x10CB,0x6C7,0x54,0x1056,0x58B,0x2FC,0x11B8,0xAA5,0x10F3,0x13BC,0x81,0x18};
 #endif
 
 #if CHUNK==32
 
 const chunk MConst=0x19789E85;
 const BIG Modulus= {0x1C1B55B3,0x13311F7A,0x24FB86F,0x1FADDC30,0x166D3243,0xFB23D31,0x836C2F7,0x10E05,0x240000};
+const BIG R2modp= {0x1FF2936,0xF43CA5E,0xA879501,0x1A2B9765,0x3EA0BA,0x18439748,0x1148313D,0x1C76638E,0x1BE61D};
+const BIG Rmodp= {0x13C30247,0x1B71160A,0x134F750A,0x8D5C15F,0x1D2C6DB6,0x14F3BCED,0x17711E8B,0x1F109156,0x13FFFF};
 const BIG CURVE_Order= {0x16EB1F6D,0x108E0531,0x1241B3AF,0x1FADDC19,0x166D2C43,0xFB23D31,0x836C2F7,0x10E05,0x240000};
 const BIG CURVE_Cof= {0x1};
 const BIG CURVE_B= {0x2};
@@ -317,12 +459,26 @@ const BIG CURVE_W[2]= {{0x162FEB83,0x2A31A48,0x100E0480,0x16,0x600},{0x7802561,0
 const BIG CURVE_SB[2][2]= {{{0x1DB010E4,0x2A31A48,0x100E04A0,0x16,0x600},{0x7802561,0x0,0x20}},{{0x7802561,0x0,0x20},{0xBB33EA,0xDEAEAE9,0x233AF2F,0x1FADDC03,0x166D2643,0xFB23D31,0x836C2F7,0x10E05,0x240000}}};
 const BIG CURVE_WB[4]= {{0x167A84B0,0xE108C2,0x1004AC10,0x7,0x200},{0x1E220475,0x166FCCAD,0x129FE68D,0x1D29DB51,0x2A0DC07,0x438,0xC000},{0xF10B93,0x1B37E657,0x194FF34E,0x1E94EDA8,0x1506E03,0x21C,0x6000},{0x1DFAAA11,0xE108C2,0x1004AC30,0x7,0x200}};
 const BIG CURVE_BB[4][4]= {{{0x132B0CBD,0x108E0531,0x1241B39F,0x1FADDC19,0x166D2C43,0xFB23D31,0x836C2F7,0x10E05,0x240000},{0x132B0CBC,0x108E0531,0x1241B39F,0x1FADDC19,0x166D2C43,0xFB23D31,0x836C2F7,0x10E05,0x240000},{0x132B0CBC,0x108E0531,0x1241B39F,0x1FADDC19,0x166D2C43,0xFB23D31,0x836C2F7,0x10E05,0x240000},{0x7802562,0x0,0x20}},{{0x7802561,0x0,0x20},{0x132B0CBC,0x108E0531,0x1241B39F,0x1FADDC19,0x166D2C43,0xFB23D31,0x836C2F7,0x10E05,0x240000},{0x132B0CBD,0x108E0531,0x1241B39F,0x1FADDC19,0x166D2C43,0xFB23D31,0x836C2F7,0x10E05,0x240000},{0x132B0CBC,0x108E0531,0x1241B39F,0x1FADDC19,0x166D2C43,0xFB23D31,0x836C2F7,0x10E05,0x240000}},{{0x7802562,0x0,0x20},{0x7802561,0x0,0x20},{0x7802561,0x0,0x20},{0x7802561,0x0,0x20}},{{0x3C012B2,0x0,0x10},{0xF004AC2,0x0,0x40},{0xF6AFA0A,0x108E0531,0x1241B38F,0x1FADDC19,0x166D2C43,0xFB23D31,0x836C2F7,0x10E05,0x240000},{0x3C012B2,0x0,0x10}}};
+
+/* Curve constants pre-converted to n-residue form */
+const BIG CURVE_B_NRES= {0xB6AAEDB,0x3B10C9A,0x44F31A6,0x11FDA68F,0x3EBA928,0x1A353CAA,0x6AB7A1F,0x1E2014A8,0x3FFFF};
+const BIG CURVE_Gx_NRES= {0x858536C,0x17C00970,0xF004364,0x16D81AD0,0x1940C48D,0x1ABE8043,0x10C5A46B,0xF07CAE,0x100000};
+const BIG CURVE_Gy_NRES= {0x13C30247,0x1B71160A,0x134F750A,0x8D5C15F,0x1D2C6DB6,0x14F3BCED,0x17711E8B,0x1F109156,0x13FFFF};
+const BIG CURVE_Cru_NRES= {0x2BB9121,0xBA8EEE,0x6C7FAC6,0x6C0469F,0x11317FC8,0x1859B2A7,0xDEB1CE5,0x19CE22FD,0x13144E};
+const BIG CURVE_Fra_NRES= {0x17995E4C,0xA85ADCF,0xDF74113,0x1BB158FD,0x1559469A,0x1198B56D,0x88B2DFB,0x64539D9,0x207017};
+const BIG CURVE_Frb_NRES= {0x481F767,0x8AB71AB,0x1458775C,0x3FC8332,0x113EBA9,0x1E1987C4,0x1FAB94FB,0x19BBD42B,0x38FE8};
+const BIG CURVE_Pxa_NRES= {0x11120128,0x14079561,0x3125FD8,0xFBC9C2F,0x4B1D971,0x10F740A8,0x1D27A52C,0x115A0C6,0x1DE6D3};
+const BIG CURVE_Pxb_NRES= {0x91C278B,0xCE1E901,0x5055791,0x19C01270,0x3CAA042,0x980B5B,0x857BF69,0xA965318,0x140428};
+const BIG CURVE_Pya_NRES= {0x1E59EE89,0x1DADD6BA,0x1BBB0179,0x74C5A5D,0x137C1A88,0x2C6E880,0x17C23131,0x9CD11AF,0x7C5EF};
+const BIG CURVE_Pyb_NRES= {0xFCFD76E,0x1494D5FD,0x14C8D1E5,0x32E6261,0x2A1B1E,0x1858B82B,0x963702F,0x1DE43CD5,0x18040C};
 #endif
 
 #if CHUNK==64
 
 const chunk MConst=0x4E205BF9789E85;
 const BIG Modulus= {0x6623EF5C1B55B3,0xD6EE18093EE1BE,0x647A6366D3243F,0x8702A0DB0BDDF,0x24000000};
+const BIG R2modp= {0x466A0618A0800A,0x2B3A22543056A3,0x148515B09C6600,0xEC9EA5606BDF50,0x1C992E66};
+const BIG Rmodp= {0xA96F211585EDB,0xF2942F28DB526F,0x2FF74229029FCD,0xF4EABE779E75E4,0x3C3FED4};
 const BIG CURVE_Order= {0x11C0A636EB1F6D,0xD6EE0CC906CEBE,0x647A6366D2C43F,0x8702A0DB0BDDF,0x24000000};
 const BIG CURVE_Cof= {0x1};
 const BIG CURVE_B= {0x2};
@@ -340,6 +496,18 @@ const BIG CURVE_W[2]= {{0x546349162FEB83,0xB40381200,0x6000},{0x7802561,0x80}};
 const BIG CURVE_SB[2][2]= {{{0x5463491DB010E4,0xB40381280,0x6000},{0x7802561,0x80}},{{0x7802561,0x80},{0xBD5D5D20BB33EA,0xD6EE0188CEBCBD,0x647A6366D2643F,0x8702A0DB0BDDF,0x24000000}}};
 const BIG CURVE_WB[4]= {{0x1C2118567A84B0,0x3C012B040,0x2000},{0xCDF995BE220475,0x94EDA8CA7F9A36,0x8702A0DC07E,0x300000},{0x66FCCAE0F10B93,0x4A76D4653FCD3B,0x4381506E03F,0x180000},{0x1C21185DFAAA11,0x3C012B0C0,0x2000}};
 const BIG CURVE_BB[4][4]= {{{0x11C0A6332B0CBD,0xD6EE0CC906CE7E,0x647A6366D2C43F,0x8702A0DB0BDDF,0x24000000},{0x11C0A6332B0CBC,0xD6EE0CC906CE7E,0x647A6366D2C43F,0x8702A0DB0BDDF,0x24000000},{0x11C0A6332B0CBC,0xD6EE0CC906CE7E,0x647A6366D2C43F,0x8702A0DB0BDDF,0x24000000},{0x7802562,0x80}},{{0x7802561,0x80},{0x11C0A6332B0CBC,0xD6EE0CC906CE7E,0x647A6366D2C43F,0x8702A0DB0BDDF,0x24000000},{0x11C0A6332B0CBD,0xD6EE0CC906CE7E,0x647A6366D2C43F,0x8702A0DB0BDDF,0x24000000},{0x11C0A6332B0CBC,0xD6EE0CC906CE7E,0x647A6366D2C43F,0x8702A0DB0BDDF,0x24000000}},{{0x7802562,0x80},{0x7802561,0x80},{0x7802561,0x80},{0x7802561,0x80}},{{0x3C012B2,0x40},{0xF004AC2,0x100},{0x11C0A62F6AFA0A,0xD6EE0CC906CE3E,0x647A6366D2C43F,0x8702A0DB0BDDF,0x24000000},{0x3C012B2,0x40}}};
+
+/* Curve constants pre-converted to n-residue form */
+const BIG CURVE_B_NRES= {0x152DE422B0BDB6,0xE5285E51B6A4DE,0x5FEE8452053F9B,0xE9D57CEF3CEBC8,0x787FDA9};
+const BIG CURVE_Gx_NRES= {0x5B8CFD4AC2F6D8,0xE459E8E0638F4F,0x3483213DD08471,0x13856B961247FB,0x203C012B};
+const BIG CURVE_Gy_NRES= {0xA96F211585EDB,0xF2942F28DB526F,0x2FF74229029FCD,0xF4EABE779E75E4,0x3C3FED4};
+const BIG CURVE_Cru_NRES= {0xEE4B1DFBEC33AE,0xBE1C3C26EED1CB,0xB88A580B57FDBB,0x9CE972425E274D,0x1E7364F8};
+const BIG CURVE_Fra_NRES= {0xEB07D39020D012,0x72CFD2B15DF29C,0x7941A172F3EEF0,0xFA92E85E8BCBA7,0x119111A2};
+const BIG CURVE_Frb_NRES= {0x7B1C1BCBFA85A1,0x641E4557E0EF21,0xEB38C1F3DF354F,0xDDD41AF24F237,0x126EEE5D};
+const BIG CURVE_Pxa_NRES= {0x6D92B9EEE59A6A,0x99EF2C82B20B85,0x3B43B68E0A36D7,0xDAFF5E0504C3B4,0x1045301F};
+const BIG CURVE_Pxb_NRES= {0xD8211252455DD7,0x114CC2F3B4A7BB,0x6272B8A4A0DE38,0x8F513B9369B0DA,0x16A56F3D};
+const BIG CURVE_Pya_NRES= {0x8A3D3A30A833F1,0xE2AC6FB3763511,0xECC7F06DD0771A,0x87B00A64C16BCC,0x67335D8};
+const BIG CURVE_Pyb_NRES= {0xB400DAA5DA1DBF,0x89783A92A898F0,0x79797A38F6B9F8,0xE0882222A3C6E1,0x1B78E22C};
 #endif
 
 #endif
@@ -354,6 +522,8 @@ const chunk MConst=1;
 #if CHUNK==16
 
 const BIG Modulus= {0x1FFF,0x1FFF,0x1FFF,0x1FFF,0x1FFF,0x1FFF,0x1FFF,0x1F,0x0,0x0,0x0,0x0,0x0,0x0,0x400,0x0,0x0,0x1FF8,0x1FFF,0x1FF};
+const BIG R2modp= {0x300,0x0,0x0,0x0,0x0,0x1F80,0x1FFF,0x1FFF,0x1FFB,0x1FFF,0x1FBF,0x1FFF,0x1FFF,0x1FFF,0x1FFF,0x1FBF,0x1FFF,0x7FF,0x1,0x0};
+const BIG Rmodp= {0x10,0x0,0x0,0x0,0x0,0x0,0x0,0x1E00,0x1FFF,0x1FFF,0x1FFF,0x1FFF,0x1FFF,0x1FFF,0x1FFF,0x1FFD,0x1FFF,0x7F,0x0,0x0};
 const BIG CURVE_B= {0x4B,0x1E93,0xF89,0x1C78,0x3BC,0x187B,0x114E,0x1619,0x1D06,0x328,0x1AF,0xD31,0x1557,0x15DE,0x1ECF,0x127C,0xA3A,0xEC5,0x118D,0xB5};
 const BIG CURVE_Order= {0x551,0x319,0x10BF,0x1395,0xF3B,0xF42,0x1C5E,0x15B4,0x6FA,0x1DE7,0x1FFF,0x1FFF,0x1FFF,0x1FFF,0x3FF,0x0,0x0,0x1FF8,0x1FFF,0x1FF};
 const BIG CURVE_Gx= {0x296,0x4C6,0x1176,0x272,0xF4A,0x19D0,0x17AC,0x1025,0x37D,0x13B8,0x103C,0x748,0xE56,0x1E73,0x1FE2,0x848,0x12C,0xF97,0x5F4,0xD6};
@@ -364,6 +534,8 @@ const BIG CURVE_Gy= {0x11F5,0x1DFA,0x1A0D,0xC80,0xCBB,0xF67,0xCC5,0xAED,0xE33,0x
 #if CHUNK==32
 
 const BIG Modulus= {0x1FFFFFFF,0x1FFFFFFF,0x1FFFFFFF,0x1FF,0x0,0x0,0x40000,0x1FE00000,0xFFFFFF};
+const BIG R2modp= {0xC00,0x0,0x1FFF0000,0x1FDFFFFF,0x1FBFFFFF,0x1FFFFFFF,0x1FFFFFFF,0x1FFFFFFE,0x13};
+const BIG Rmodp= {0x20,0x0,0x0,0x1FFFC000,0x1FFFFFFF,0x1FFFFFFF,0x1F7FFFFF,0x3FFFFFF,0x0};
 const BIG CURVE_B= {0x7D2604B,0x1E71E1F1,0x14EC3D8E,0x1A0D6198,0x86BC651,0x1EAABB4C,0xF9ECFAE,0x1B154752,0x5AC635};
 const BIG CURVE_Order= {0x1C632551,0x1DCE5617,0x5E7A13C,0xDF55B4E,0x1FFFFBCE,0x1FFFFFFF,0x3FFFF,0x1FE00000,0xFFFFFF};
 const BIG CURVE_Gx= {0x1898C296,0x509CA2E,0x1ACCE83D,0x6FB025B,0x40F2770,0x1372B1D2,0x91FE2F3,0x1E5C2588,0x6B17D1};
@@ -374,6 +546,8 @@ const BIG CURVE_Gy= {0x17BF51F5,0x1DB20341,0xC57B3B2,0x1C66AED6,0x19E162BC,0x15A
 #if CHUNK==64
 
 const BIG Modulus= {0xFFFFFFFFFFFFFF,0xFFFFFFFFFF,0x0,0x1000000,0xFFFFFFFF};
+const BIG R2modp= {0x3000000050000,0x0,0xFFFFFBFFFFFFFA,0xFFFAFFFFFFFEFF,0x2FFFF};
+const BIG Rmodp= {0x1000000,0x0,0xFFFFFFFFFFFF00,0xFEFFFFFFFFFFFF,0xFFFFFF};
 const BIG CURVE_B= {0xCE3C3E27D2604B,0x6B0CC53B0F63B,0x55769886BC651D,0xAA3A93E7B3EBBD,0x5AC635D8};
 const BIG CURVE_Order= {0xB9CAC2FC632551,0xFAADA7179E84F3,0xFFFFFFFFFFBCE6,0xFFFFFF,0xFFFFFFFF};
 const BIG CURVE_Gx= {0xA13945D898C296,0x7D812DEB33A0F4,0xE563A440F27703,0xE12C4247F8BCE6,0x6B17D1F2};
@@ -395,6 +569,8 @@ const BIG CURVE_Gy= {0xB6406837BF51F5,0x33576B315ECECB,0x4A7C0F9E162BCE,0xFE1A7F
 
 const BIG Modulus= {0x1FFFFFFF,0x1FFFFFFF,0x1FFFFFFF,0x1FFFFFFF,0x1FFFFFFF,0x1FFFFFFF,0x1FFFFFFF,0x1FFFFFFF,0x3F80FF};
 const chunk MConst=0x3F8100;
+const BIG R2modp= {0x14300,0x3FFEFE,0x1FDFC001,0x1800203F,0x407FFDF,0x1FFBF800,0x1F000407,0x80FFFB,0x3C7F00};
+const BIG Rmodp= {0x80,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x3F8000};
 
 #if CURVETYPE==WEIERSTRASS
 const int CURVE_A= -3;
@@ -426,6 +602,8 @@ const BIG CURVE_Gx= {0x3};
 
 const BIG Modulus= {0xFFFFFFFFFFFFFF,0xFFFFFFFFFFFFFF,0xFFFFFFFFFFFFFF,0xFFFFFFFFFFFFFF,0x3F80FFFF};
 const chunk MConst=0x3F810000;
+const BIG R2modp= {0x50C03CF7FC1C50,0xC00101FFF7F000,0xFF7F000407FFDF,0x407FFDFC00101F,0xBA7F000};
+const BIG Rmodp= {0x407FFDF,0x0,0x0,0x0,0x2FA10000};
 
 
 #if CURVETYPE==WEIERSTRASS
@@ -465,6 +643,8 @@ const BIG CURVE_Gx= {0x3};
 
 const BIG Modulus= {0x1FFFFFFF,0x1FFFFFFF,0x1FFFFFFF,0x1FFFFFFF,0x1FFFFFFF,0x1FFFFFFF,0x1FFFFFFF,0x1FFFFFFF,0xFFA7FF};
 const chunk MConst=0xFFA800;
+const BIG R2modp= {0x8B00081,0x1A6C1527,0x885EE09,0xB69EC69,0xFAE63F2,0x27EDB9B,0x1C5DC03A,0x14CA257C,0x8CD129};
+const BIG Rmodp= {0x20,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0xB0000};
 
 #if CURVETYPE==WEIERSTRASS
 const int CURVE_A= -3;
@@ -496,6 +676,8 @@ const BIG CURVE_Gx= {0x8};
 
 const BIG Modulus= {0xFFFFFFFFFFFFFF,0xFFFFFFFFFFFFFF,0xFFFFFFFFFFFFFF,0xFFFFFFFFFFFFFF,0xFFA7FFFF};
 const chunk MConst=0xFFA80000;
+const BIG R2modp= {0x206340688D84,0xEE09D360A93A2C,0x8FC96D3D8D2885,0x3A13F6DCDBEB9,0xF059C5DC};
+const BIG Rmodp= {0x100581E,0x0,0x0,0x0,0x4A500000};
 
 
 #if CURVETYPE==WEIERSTRASS
@@ -817,6 +999,8 @@ const int CURVE_A=-3;
 
 const BIG Modulus= {0x1377,0x1B72,0x747,0x690,0x201,0x1014,0x1498,0x47A,0x1BF6,0x1371,0x35C,0x1B07,0x909,0x1305,0x10F9,0x1537,0x1EE,0x1EDD,0x1ED5,0x153};
 const chunk MConst=0x9B9;
+const BIG R2modp= {0x943,0x19F4,0x1E88,0xAE,0x196D,0xE63,0x197F,0xCE6,0x1C45,0x5D9,0x1A22,0x997,0xF94,0x1A31,0xF60,0x16DE,0x6BE,0x8C7,0x71A,0x17};
+const BIG Rmodp= {0xCD8,0xD41,0x1143,0x27A,0xFE3,0x1E1E,0x11B3,0x1480,0xEC,0xD53,0xF51,0x1755,0x713,0x1781,0x899,0x2CB,0x11A0,0x1B46,0x1BF0,0x20};
 const BIG CURVE_Order= {0x16A7,0x1A42,0xA5,0x1C1D,0x1901,0x137B,0x1586,0x1476,0x197A,0xC61,0x35C,0x1B07,0x909,0x1305,0x10F9,0x1537,0x1EE,0x1EDD,0x1ED5,0x153};
 const BIG CURVE_B= {0xB04,0x1749,0x7F,0xB02,0x16AE,0x492,0x1CBD,0x1895,0x13EB,0x1DFC,0x1DAD,0x1A16,0x1733,0x1353,0x13F9,0x9D4,0x10D8,0xE21,0xB18,0xCC};
 const BIG CURVE_Gx= {0x5F4,0x1098,0x158B,0x322,0x179A,0x1E15,0xABE,0x188F,0x142,0xD7D,0x1852,0x14CA,0x1B23,0x1109,0x1DCC,0x1CF6,0x1CF,0x19E6,0x1A3A,0x147};
@@ -827,6 +1011,8 @@ const BIG CURVE_Gy= {0x9BE,0x192E,0x1CD6,0x17D1,0x1DA,0x1380,0x740,0x1BC7,0x1CB6
 
 const BIG Modulus= {0x1F6E5377,0x9A40E8,0x9880A08,0x17EC47AA,0x18D726E3,0x5484EC1,0x6F0F998,0x1B743DD5,0xA9FB57};
 const chunk MConst=0xEFD89B9;
+const BIG R2modp= {0xCFA250C,0x1A0AEF44,0x1FDCC796,0x22B39B2,0x1A222ECF,0x5F28997,0xF3D8346,0xC735F5B,0x2E71A4};
+const BIG Rmodp= {0x1B5059B0,0x313D450,0x167E1E7F,0x3B29011,0x17A8B54C,0x2713BAA,0x12D13378,0x1A346805,0x20DF86};
 const BIG CURVE_Order= {0x174856A7,0xF07414,0x1869BDE4,0x12F5476A,0x18D718C3,0x5484EC1,0x6F0F998,0x1B743DD5,0xA9FB57};
 const BIG CURVE_B= {0x1EE92B04,0x172C080F,0xBD2495A,0x7D7895E,0x176B7BF9,0x13B99E85,0x1A93F99A,0x18861B09,0x662C61};
 const BIG CURVE_Gx= {0xE1305F4,0xD0C8AB1,0xBEF0ADE,0x28588F5,0x16149AFA,0x9D91D32,0x1EDDCC88,0x79839FC,0xA3E8EB};
@@ -837,6 +1023,8 @@ const BIG CURVE_Gy= {0x1B25C9BE,0xD5F479A,0x1409C007,0x196DBC73,0x417E69B,0x1170
 
 const BIG Modulus= {0x13481D1F6E5377,0xF623D526202820,0x909D838D726E3B,0xA1EEA9BC3E660A,0xA9FB57DB};
 const chunk MConst=0xA75590CEFD89B9;
+const BIG R2modp= {0x9E04F49B9A3787,0x29317218F3CF49,0x54E8C3CF1DBC89,0xBB411A3F7559CA,0x9773E15F};
+const BIG Rmodp= {0x7C03F50E106119,0x80B7A289AECBDF,0x69DFD13EF0B785,0x7639F0EA29F553,0x20F485EE};
 const BIG CURVE_Order= {0x1E0E82974856A7,0x7AA3B561A6F790,0x909D838D718C39,0xA1EEA9BC3E660A,0xA9FB57DB};
 const BIG CURVE_B= {0xE58101FEE92B04,0xEBC4AF2F49256A,0x733D0B76B7BF93,0x30D84EA4FE66A7,0x662C61C4};
 const BIG CURVE_Gx= {0xA191562E1305F4,0x42C47AAFBC2B79,0xB23A656149AFA1,0xC1CFE7B7732213,0xA3E8EB3C};
@@ -853,6 +1041,8 @@ const int CURVE_A=-3;
 
 const BIG Modulus= {0x1C03,0x374,0x14F6,0x19E6,0x1E8F,0x536,0xF23,0x1795,0x1AD,0x19CB,0x10D6,0x1C84,0x1E8C,0x936,0x1C40,0x1AB1,0xB3A,0x1C60,0x1F45,0x1E3};
 const chunk MConst=0x1155;
+const BIG R2modp= {0x18D2,0x15BD,0x1797,0xB59,0x17A8,0x1F6A,0x18B1,0x1EF8,0x847,0x5F4,0x1F8F,0xEB3,0xA83,0xEAA,0x426,0x104E,0x2D9,0x1E46,0xB20,0xB5};
+const BIG Rmodp= {0x1FD0,0x8B1,0x109E,0x195,0x1703,0xC90,0xDCD,0x6A8,0x524,0x34F,0x1293,0x17B7,0x1731,0xC90,0x1BFB,0x14E1,0xC52,0x19FA,0xBA1,0x1C0};
 const BIG CURVE_Order= {0x15E1,0x16B2,0x1671,0x1BA8,0x1FF,0x1FCA,0x34A,0x1C28,0x1C67,0x1A9E,0x10D6,0x1C84,0x1E8C,0x936,0x1C40,0x1AB1,0xB3A,0x1C60,0x1F45,0x1E3};
 const BIG CURVE_B= {0x173F,0x1BDD,0x59E,0xBDB,0x307,0x10C0,0x12C6,0x135C,0xC0C,0x1EFF,0x1003,0x1489,0x754,0x55D,0x35,0x1526,0x1428,0x1E52,0xD4F,0x1DC};
 const BIG CURVE_Gx= {0x1CFF,0xC7A,0xB76,0x12F4,0x164C,0x1B80,0x1E62,0x1B95,0x7D2,0xC61,0x8E5,0x13A8,0x1474,0xC1E,0xCC4,0x73D,0x16C1,0x61A,0xCF5,0x16D};
@@ -863,6 +1053,8 @@ const BIG CURVE_Gy= {0xCFB,0x31,0x555,0x2B4,0x1831,0x4F0,0x393,0xFD,0x1C3,0x138,
 
 const BIG Modulus= {0x186E9C03,0x7E79A9E,0x12329B7A,0x35B7957,0x435B396,0x16F46721,0x163C4049,0x1181675A,0xF1FD17};
 const chunk MConst=0x164E1155;
+const BIG R2modp= {0x2704745,0x8CE012D,0x1A4C3A00,0x1EE444D9,0x1B597C0B,0x125C0792,0x10D4598B,0x12E00566,0x78B4F7};
+const BIG Rmodp= {0x19BDE39D,0x1B251188,0x779F53D,0x11355BB6,0x1513D9A6,0xA7EB4BA,0x23BB67F,0x1E51AD4F,0xCE5FF6};
 const BIG CURVE_Order= {0x6D655E1,0x1FEEA2CE,0x14AFE507,0x18CFC281,0x435B53D,0x16F46721,0x163C4049,0x1181675A,0xF1FD17};
 const BIG CURVE_B= {0x1B7BB73F,0x3AF6CB3,0xC68600C,0x181935C9,0xC00FDFE,0x1D3AA522,0x4C0352A,0x194A8515,0xEE353F};
 const BIG CURVE_Gx= {0x198F5CFF,0x64BD16E,0x62DC059,0xFA5B95F,0x23958C2,0x1EA3A4EA,0x7ACC460,0x186AD827,0xB6B3D4};
@@ -873,6 +1065,8 @@ const BIG CURVE_Gy= {0x14062CFB,0x188AD0AA,0x19327860,0x3860FD1,0xEF8C270,0x18F8
 
 const BIG Modulus= {0xFCF353D86E9C03,0xADBCABC8CA6DE8,0xE8CE42435B3961,0xB3AD58F10126D,0xF1FD178C};
 const chunk MConst=0x97483A164E1155;
+const BIG R2modp= {0x18D2374288CC9C,0x4929E67646BD2B,0x220E6C1D6F7F2D,0x751B1FDABCE02E,0xE7401B78};
+const BIG Rmodp= {0xC36D580F9D843B,0x93067696B54370,0x98F172EB19C9E0,0xE039B9FE7B6EA8,0xD0B26321};
 const BIG CURVE_Order= {0xFDD459C6D655E1,0x67E140D2BF941F,0xE8CE42435B53DC,0xB3AD58F10126D,0xF1FD178C};
 const BIG CURVE_B= {0x75ED967B7BB73F,0xC9AE4B1A18030,0x754A44C00FDFEC,0x5428A9300D4ABA,0xEE353FCA};
 const BIG CURVE_Gx= {0xC97A2DD98F5CFF,0xD2DCAF98B70164,0x4749D423958C27,0x56C139EB31183D,0xB6B3D4C3};
@@ -936,6 +1130,8 @@ const int CURVE_A=-3;
 
 const BIG Modulus= {0x1FFFFFFF,0x7,0x0,0x1FFFFE00,0x1FFFEFFF,0x1FFFFFFF,0x1FFFFFFF,0x1FFFFFFF,0x1FFFFFFF,0x1FFFFFFF,0x1FFFFFFF,0x1FFFFFFF,0x1FFFFFFF,0x7F};
 const chunk MConst=0x1;
+const BIG R2modp= {0x0,0x8000,0x1FF80000,0x1FFFFF,0x2000000,0x0,0x0,0x1FFFFFFC,0xF,0x100,0x400,0x0,0x0,0x0};
+const BIG Rmodp= {0x400000,0x1E000000,0x1FFFFFFF,0x1FFFFFFF,0x3,0x20,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0};
 const BIG CURVE_Order= {0xCC52973,0x760CB56,0xC29DEBB,0x141B6491,0x12DDF581,0x6C0FA1B,0x1FFF1D8D,0x1FFFFFFF,0x1FFFFFFF,0x1FFFFFFF,0x1FFFFFFF,0x1FFFFFFF,0x1FFFFFFF,0x7F};
 const BIG CURVE_B= {0x13EC2AEF,0x142E476E,0xBB4674A,0xC731B14,0x1875AC65,0x447A809,0x4480C50,0xDDFD028,0x19181D9C,0x1F1FC168,0x623815A,0x47DCFC9,0x1312FA7E,0x59};
 const BIG CURVE_Gx= {0x12760AB7,0x12A2F1C3,0x154A5B0E,0x5E4BB7E,0x2A38550,0xF0412A,0xE6167DD,0xC5174F3,0x146E1D3B,0x1799056B,0x3AC71C7,0x1D160A6F,0x87CA22B,0x55};
@@ -946,6 +1142,8 @@ const BIG CURVE_Gy= {0x10EA0E5F,0x1218EBE4,0x1FA0675E,0x1639C3A,0xB8C00A6,0x1889
 
 const BIG Modulus= {0xFFFFFFFF,0xFFFFFF000000000,0xFFFFFFFFFFFFEFF,0xFFFFFFFFFFFFFFF,0xFFFFFFFFFFFFFFF,0xFFFFFFFFFFFFFFF,0xFFFFFF};
 const chunk MConst=0x100000001;
+const BIG R2modp= {0x0,0xFFFE00000001000,0x200000000FFFF,0xFE0000000000000,0x200000000FFFFFF,0x10000000,0x0};
+const BIG Rmodp= {0x1000000000,0xFFFFFFFFFFFFF00,0x100000000FFF,0x0,0x0,0x0,0x0};
 const BIG CURVE_Order= {0xCEC196ACCC52973,0x1A0DB248B0A77AE,0x34D81F4372DDF58,0xFFFFFFFFFFFFC76,0xFFFFFFFFFFFFFFF,0xFFFFFFFFFFFFFFF,0xFFFFFF};
 const BIG CURVE_B= {0xA85C8EDD3EC2AEF,0x56398D8A2ED19D2,0x4088F5013875AC6,0x9C6EFE814112031,0x56BE3F82D19181D,0xA7E23EE7E4988E0,0xB3312F};
 const BIG CURVE_Gx= {0xA545E3872760AB7,0x2F25DBF55296C3,0x741E082542A3855,0x3B628BA79B9859F,0x71EF320AD746E1D,0x22BE8B05378EB1C,0xAA87CA};
@@ -1009,6 +1207,8 @@ const int CURVE_A=0;
 
 const chunk MConst=0x15F615E5;
 const BIG Modulus= {0x404E013,0x1203604,0x4E0000,0x80A2084,0x2,0xC90420,0x4051078,0x3600001,0xA20660,0x36,0x5100900,0x10288468,0xD,0x2881200,0x1B0,0x0,0x6C0D80,0x48,0x0,0x480,0x0,0x0,0x90};
+const BIG R2modp= {0x47D8E45,0x1881B152,0xD0D8E5C,0x71B389E,0xC71EE7F,0xB55C23D,0x34E95A8,0xC9ACB5F,0xADF5898,0x1BE6456,0x82E3BCA,0x3944193,0x9629068,0x181E8CC5,0x1305D19C,0x1E7917A,0x19EF62AB,0xEBAC357,0x4C3C36D,0xF254830,0x1E32A5E7,0x13144033,0x51};
+const BIG Rmodp= {0xE72DC76,0x1F5558AB,0xAB9FF9F,0x12AC601D,0x1F7FEDFF,0xAD7563F,0xD551013,0x7FF6FF,0x157356C0,0x13FEE000,0x12001FF,0x5555640,0x1CFFB7FB,0x9003FF,0x1FFB8040,0x1FFFFFFC,0x1802FF,0xFFF3FF8,0x1FFFFFFF,0xFF,0x1FFFFFF8,0x1FFFFFFF,0x1F};
 const BIG CURVE_Order= {0x1E04200D,0x1203603,0x420000,0x80A207E,0x2,0xC303F0,0x4051075,0x3600001,0xA20630,0x36,0x5100900,0x1028845C,0xD,0x2881200,0x1B0,0x0,0x6C0D80,0x48,0x0,0x480,0x0,0x0,0x90};
 const BIG CURVE_Cof= {0x1};
 const BIG CURVE_B= {0x2};
@@ -1026,12 +1226,26 @@ const BIG CURVE_W[2]= {{0x6008003,0x0,0x80000,0x6,0x0,0x40030,0x3,0x0,0x30,0x0,0
 const BIG CURVE_SB[2][2]= {{{0x600A004,0x0,0xA0000,0x6,0x0,0x50030,0x3,0x0,0x30,0x0,0x0,0xC},{0x2001,0x0,0x20000,0x0,0x0,0x10000}},{{0x2001,0x0,0x20000,0x0,0x0,0x10000},{0x1803A00A,0x1203603,0x3A0000,0x80A2078,0x2,0xBF03C0,0x4051072,0x3600001,0xA20600,0x36,0x5100900,0x10288450,0xD,0x2881200,0x1B0,0x0,0x6C0D80,0x48,0x0,0x480,0x0,0x0,0x90}}};
 const BIG CURVE_WB[4]= {{0x2001000,0x0,0x10000,0x2,0x0,0x8010,0x1,0x0,0x10,0x0,0x0,0x4},{0x1C015005,0x600,0x150000,0x1201C,0x0,0x1C80E0,0x900E,0x600000,0x1200E0,0x0,0x900000,0x48038,0x0,0x480000,0x0,0x0,0xC0000},{0xE00B003,0x300,0xB0000,0x900E,0x0,0xE8070,0x4807,0x300000,0x90070,0x0,0x480000,0x2401C,0x0,0x240000,0x0,0x0,0x60000},{0x2003001,0x0,0x30000,0x2,0x0,0x18010,0x1,0x0,0x10,0x0,0x0,0x4}};
 const BIG CURVE_BB[4][4]= {{{0x1E04100D,0x1203603,0x410000,0x80A207E,0x2,0xC283F0,0x4051075,0x3600001,0xA20630,0x36,0x5100900,0x1028845C,0xD,0x2881200,0x1B0,0x0,0x6C0D80,0x48,0x0,0x480,0x0,0x0,0x90},{0x1E04100C,0x1203603,0x410000,0x80A207E,0x2,0xC283F0,0x4051075,0x3600001,0xA20630,0x36,0x5100900,0x1028845C,0xD,0x2881200,0x1B0,0x0,0x6C0D80,0x48,0x0,0x480,0x0,0x0,0x90},{0x1E04100C,0x1203603,0x410000,0x80A207E,0x2,0xC283F0,0x4051075,0x3600001,0xA20630,0x36,0x5100900,0x1028845C,0xD,0x2881200,0x1B0,0x0,0x6C0D80,0x48,0x0,0x480,0x0,0x0,0x90},{0x2002,0x0,0x20000,0x0,0x0,0x10000}},{{0x2001,0x0,0x20000,0x0,0x0,0x10000},{0x1E04100C,0x1203603,0x410000,0x80A207E,0x2,0xC283F0,0x4051075,0x3600001,0xA20630,0x36,0x5100900,0x1028845C,0xD,0x2881200,0x1B0,0x0,0x6C0D80,0x48,0x0,0x480,0x0,0x0,0x90},{0x1E04100D,0x1203603,0x410000,0x80A207E,0x2,0xC283F0,0x4051075,0x3600001,0xA20630,0x36,0x5100900,0x1028845C,0xD,0x2881200,0x1B0,0x0,0x6C0D80,0x48,0x0,0x480,0x0,0x0,0x90},{0x1E04100C,0x1203603,0x410000,0x80A207E,0x2,0xC283F0,0x4051075,0x3600001,0xA20630,0x36,0x5100900,0x1028845C,0xD,0x2881200,0x1B0,0x0,0x6C0D80,0x48,0x0,0x480,0x0,0x0,0x90}},{{0x2002,0x0,0x20000,0x0,0x0,0x10000},{0x2001,0x0,0x20000,0x0,0x0,0x10000},{0x2001,0x0,0x20000,0x0,0x0,0x10000},{0x2001,0x0,0x20000,0x0,0x0,0x10000}},{{0x1002,0x0,0x10000,0x0,0x0,0x8000},{0x4002,0x0,0x40000,0x0,0x0,0x20000},{0x1E04000A,0x1203603,0x400000,0x80A207E,0x2,0xC203F0,0x4051075,0x3600001,0xA20630,0x36,0x5100900,0x1028845C,0xD,0x2881200,0x1B0,0x0,0x6C0D80,0x48,0x0,0x480,0x0,0x0,0x90},{0x1002,0x0,0x10000,0x0,0x0,0x8000}}};
+
+/* Curve constants pre-converted to n-residue form */
+const BIG CURVE_B_NRES= {0x1CE5B8EC,0x1EAAB156,0x1573FF3F,0x558C03A,0x1EFFDBFF,0x15AEAC7F,0x1AAA2026,0xFFEDFE,0xAE6AD80,0x7FDC001,0x24003FF,0xAAAAC80,0x19FF6FF6,0x12007FF,0x1FF70080,0x1FFFFFF9,0x3005FF,0x1FFE7FF0,0x1FFFFFFE,0x1FF,0x1FFFFFF0,0x1FFFFFFF,0x3F};
+const BIG CURVE_Gx_NRES= {0x1592039D,0x1CADD58,0x15940060,0x155DC066,0x801202,0x15F1ADE0,0x16B00064,0x2E00901,0xB2EAFA0,0xC012035,0x3F00700,0xAD32E28,0x3004812,0x1F80E00,0x48170,0x3,0x540A80,0x1000C050,0x0,0x380,0x8,0x0,0x70};
+const BIG CURVE_Gy_NRES= {0xE72DC76,0x1F5558AB,0xAB9FF9F,0x12AC601D,0x1F7FEDFF,0xAD7563F,0xD551013,0x7FF6FF,0x157356C0,0x13FEE000,0x12001FF,0x5555640,0x1CFFB7FB,0x9003FF,0x1FFB8040,0x1FFFFFFC,0x1802FF,0xFFF3FF8,0x1FFFFFFF,0xFF,0x1FFFFFF8,0x1FFFFFFF,0x1F};
+const BIG CURVE_Cru_NRES= {0x42CF354,0x15E79D3B,0x1AC450B4,0x1A5130C3,0x9948F2,0x12694063,0x1849836F,0x133DD2F1,0x916DF1B,0x3390938,0xD040CD7,0xF300814,0x1DFADF2B,0x1C22F0F,0x1D6B353D,0x1209D6EE,0x78E1C9,0x1FD4D338,0x4018C2D,0x1F582021,0xFFFFD87,0x480480D,0x80};
+const BIG CURVE_Fra_NRES= {0xEE22F18,0x13BE2398,0xD7CDCD4,0x15A586EC,0x19202BF9,0x3736A03,0x298589E,0x7F6AAA6,0x18C021E,0x851637,0x1AE9B9A4,0xCB72F6B,0xFDB7628,0x16F7B4C3,0x9C95712,0x3E4673D,0x164CC8A5,0x17B473BE,0x142655D1,0x10F6A01A,0x1AF28983,0xAF402A9,0x60};
+const BIG CURVE_Frb_NRES= {0x1522B0FB,0xD62126B,0x12D1232B,0x12649997,0x6DFD408,0x1D559A1C,0x16CB7D9,0x1B69555B,0x1F160441,0x1F7AE9FE,0xA264F5B,0x37154FC,0x102489E5,0xB905D3C,0x1636AA9D,0x1C1B98C2,0xA1F44DA,0x84B8C89,0xBD9AA2E,0xF096465,0x50D767C,0x150BFD56,0x2F};
+const BIG CURVE_Pxa_NRES= {0x1D79F288,0x119F6073,0x610A4D,0x1D2BE76B,0x1768FEAB,0x7199FDA,0x1053214B,0xD4B578F,0x750ABCB,0x18AFBEEB,0xDB3E66A,0xF809517,0x13103FC8,0x12758DAB,0x68C73ED,0x1FA2F5F3,0x1A27CF54,0xCAF300F,0x1B993E66,0x7740006,0x1223FF4,0x13488AB1,0x33};
+const BIG CURVE_Pxb_NRES= {0x1ABF12A1,0x1A7B6D09,0x1D0A1A04,0x6BC61B8,0x1EDE6BB2,0xF45799F,0xDCB5904,0x167099B,0x2C79408,0x94519BF,0x92E3976,0x194F0BC2,0x1555651,0x1A6A963F,0x9CDA436,0x1542CBB,0x128EF692,0x40EE5DB,0x14FE5499,0x8282CF,0xEC4545,0x1558B2F8,0x84};
+const BIG CURVE_Pya_NRES= {0x15AB186,0x15BE57B1,0xC2E9707,0x1CB6B95B,0x2468466,0xEA296C2,0x1A747EFD,0x93536EA,0x2B665D4,0xCDCA8B9,0x1A131769,0x15789D19,0xEDB845F,0x598F075,0x15E6440A,0x16193E11,0x1EE4DE88,0x1EBE213,0xE67377C,0x19548012,0x193ABEB6,0x553D619,0x1A};
+const BIG CURVE_Pyb_NRES= {0xB88F56,0x1B733ABF,0x1482CDB3,0x1A15D972,0x188765F0,0xD69396B,0x597D3B0,0x1974B22,0x121FEA89,0x1D45B5E0,0x2134B15,0x7FEC8E6,0x5D679DC,0x1C410601,0x2A93C31,0x6F79844,0x17C5C907,0x1164B4F2,0x14F63044,0x9555D98,0x166F0A45,0xC8AC8D9,0x7D};
 #endif
 
 #if CHUNK==64
 
 const chunk MConst=0xCE50F5CF5F615E5;
 const BIG Modulus= {0x2406C08404E013,0x240510420138000,0xE01920840000000,0x601B00000901441,0x400000006C0A206,0xD814423414402,0x6C051024000000,0xD8000000000000,0x9006C,0x240000,0x240000000000};
+const BIG R2modp= {0x8FEF908B7EA0A1B,0x94CB6806D0DED6B,0xC1D794A79EAEB1C,0x39E2BF9F5FB6C9C,0x50BCCA0E3EA1F64,0x593B188F3BAF9D2,0x3514D567C5C762A,0x695C90AC3CF22F5,0x4C3C36D763ABFB,0x9F8CA979DFDD116,0x19286198A201};
+const BIG Rmodp= {0xD03C613394D6E3B,0xC3E33A275577EFF,0xB51D7563FFFEFFD,0x6002FBFF70F2CDF,0x3FFFCFFB8BD3C9F,0xF717078C93F2400,0xDCBF09003FFFF9F,0x17FFFFFFFFFCFF,0xFFFFFFBFFD0FA0C,0xFFFFFF00003FFFF,0x3FFFFFFFFFF};
 const BIG CURVE_Order= {0x2406C07E04200D,0x2405103F0108000,0xD418607E0000000,0x301B00000901441,0x400000006C0A206,0xD814422E14402,0x6C051024000000,0xD8000000000000,0x9006C,0x240000,0x240000000000};
 const BIG CURVE_Cof= {0x1};
 const BIG CURVE_B= {0x2};
@@ -1049,6 +1263,18 @@ const BIG CURVE_W[2]= {{0x6008003,0x30020000,0xC0080060000000,0x300000000000000,
 const BIG CURVE_SB[2][2]= {{{0x600A004,0x30028000,0xC00A0060000000,0x300000000000000,0x0,0x600000},{0x2001,0x8000,0x20000000000}},{{0x2001,0x8000,0x20000000000},{0x2406C07803A00A,0x2405103C00E8000,0xC817E0780000000,0x1B00000901441,0x400000006C0A206,0xD814422814402,0x6C051024000000,0xD8000000000000,0x9006C,0x240000,0x240000000000}}};
 const BIG CURVE_WB[4]= {{0x2001000,0x10004000,0x40010020000000,0x100000000000000,0x0,0x200000},{0xC01C015005,0x900E0054000,0x3803901C0000000,0xE00300000000240,0x1200,0x2401C02400,0x9000000000,0x0,0xC},{0x600E00B003,0x4807002C000,0x1C01D00E0000000,0x700180000000120,0x900,0x1200E01200,0x4800000000,0x0,0x6},{0x2003001,0x1000C000,0x40030020000000,0x100000000000000,0x0,0x200000}};
 const BIG CURVE_BB[4][4]= {{{0x2406C07E04100D,0x2405103F0104000,0xD418507E0000000,0x301B00000901441,0x400000006C0A206,0xD814422E14402,0x6C051024000000,0xD8000000000000,0x9006C,0x240000,0x240000000000},{0x2406C07E04100C,0x2405103F0104000,0xD418507E0000000,0x301B00000901441,0x400000006C0A206,0xD814422E14402,0x6C051024000000,0xD8000000000000,0x9006C,0x240000,0x240000000000},{0x2406C07E04100C,0x2405103F0104000,0xD418507E0000000,0x301B00000901441,0x400000006C0A206,0xD814422E14402,0x6C051024000000,0xD8000000000000,0x9006C,0x240000,0x240000000000},{0x2002,0x8000,0x20000000000}},{{0x2001,0x8000,0x20000000000},{0x2406C07E04100C,0x2405103F0104000,0xD418507E0000000,0x301B00000901441,0x400000006C0A206,0xD814422E14402,0x6C051024000000,0xD8000000000000,0x9006C,0x240000,0x240000000000},{0x2406C07E04100D,0x2405103F0104000,0xD418507E0000000,0x301B00000901441,0x400000006C0A206,0xD814422E14402,0x6C051024000000,0xD8000000000000,0x9006C,0x240000,0x240000000000},{0x2406C07E04100C,0x2405103F0104000,0xD418507E0000000,0x301B00000901441,0x400000006C0A206,0xD814422E14402,0x6C051024000000,0xD8000000000000,0x9006C,0x240000,0x240000000000}},{{0x2002,0x8000,0x20000000000},{0x2001,0x8000,0x20000000000},{0x2001,0x8000,0x20000000000},{0x2001,0x8000,0x20000000000}},{{0x1002,0x4000,0x10000000000},{0x4002,0x10000,0x40000000000},{0x2406C07E04000A,0x2405103F0100000,0xD418407E0000000,0x301B00000901441,0x400000006C0A206,0xD814422E14402,0x6C051024000000,0xD8000000000000,0x9006C,0x240000,0x240000000000},{0x1002,0x4000,0x10000000000}}};
+
+/* Curve constants pre-converted to n-residue form */
+const BIG CURVE_B_NRES= {0xA078C26729ADC76,0x87C6744EAAEFDFF,0x6A3AEAC7FFFDFFB,0xC005F7FEE1E59BF,0x7FFF9FF717A793E,0xEE2E0F1927E4800,0xB97E12007FFFF3F,0x2FFFFFFFFFF9FF,0xFFFFFF7FFA1F418,0xFFFFFE00007FFFF,0x7FFFFFFFFFF};
+const BIG CURVE_Gx_NRES= {0x32040AD4AB771D8,0x6021D61AABC0100,0x2AFBAB200001002,0x180400980E762,0x3004E036567,0x9C10CB5A022002,0x2A0148020000060,0xC0000000000300,0x400380660,0x1000200000,0x200000000000};
+const BIG CURVE_Gy_NRES= {0xD03C613394D6E3B,0xC3E33A275577EFF,0xB51D7563FFFEFFD,0x6002FBFF70F2CDF,0x3FFFCFFB8BD3C9F,0xF717078C93F2400,0xDCBF09003FFFF9F,0x17FFFFFFFFFCFF,0xFFFFFFBFFD0FA0C,0xFFFFFF00003FFFF,0x3FFFFFFFFFF};
+const BIG CURVE_Cru_NRES= {0x5AF9BCD73E9B8EC,0x287BBDC3542DE28,0xA283AB7538C1329,0x893ECBDD31A47FE,0xA86B8CE44343FBF,0x5C2234E2A6BA1A2,0x5B8FFF392DC3FBF,0x558F93209D6EEEB,0xC616FF537561F,0xFFFFB0FF58C2212,0xA6012012035};
+const BIG CURVE_Fra_NRES= {0x6C6B5DD61E25670,0xA0FA64C4CD9066E,0x87086B5640F2405,0xFE55CF6AB2D27C0,0xF8D20214BE25AFD,0x6F8F9FB5403ED36,0x510CE1B00930DFB,0xE6394A3E4673D4E,0x132AE8DED256011,0x5E513070F8BC1AA,0x21F02BD00AA7};
+const BIG CURVE_Frb_NRES= {0x95D50E3222289A3,0x830AAB7D33A7991,0x5910B52DBF0DBFA,0x61C53095562EC81,0x472DFDEBADE4708,0x9148748CF3D56CB,0xB5B36F5236CF204,0x2746B5C1B98C2B1,0xECD517212E3A05A,0xA1AECF8F0983E55,0x20FD42FF558};
+const BIG CURVE_Pxa_NRES= {0x277A9F4463C79EB,0xE0BEC0FC0B64885,0xA061A09136AED1F,0x559F44B57BC88ED,0xA73562BF1D70143,0x83C95D5455DC1A,0x65BB85EE176AE62,0x13D6A9FA2F5F334,0xCC9F3332BCED416,0x2447FE8774B406D,0xB59CD222AC4};
+const BIG CURVE_Pxb_NRES= {0x28071EC79DAEE6,0x77AEEF044CF480D,0x5AE4CCA38FFDBCD,0x67D124709A10F25,0x333B25146B34BE3,0xAAD2AA19A1CB13F,0x6D6539C4BC0FC2A,0x5674241542CBB4E,0x7F2A4C903B9D0E9,0x1D88A8A082994FA,0x1AA5562CBE0};
+const BIG CURVE_Pya_NRES= {0x857E48B4D3649F1,0xA7506EA9D44694B,0x587E1C86A0848D0,0x7A3C6753754A284,0x32B4B372F23BC69,0x712AA4593B58AFB,0x37158CE3E31D5DB,0x23A7116193E11AF,0x339BBE07AFF214D,0x2757D6D95627127,0x1A7D154F5867};
+const BIG CURVE_Pyb_NRES= {0xDBDD29C2135A1AF,0xDD0E6FD22BB0366,0x3A18F23FCAF10EC,0x4FA94D74B9DFE27,0x948AF517345AF7D,0xCFF53967ADA777B,0x4FAED4AE30804BA,0x672C0E6F7984415,0x7B182245934F90C,0xCDE148A9574C98A,0x1F2EB22B2366};
 #endif
 
 #endif
@@ -1061,6 +1287,8 @@ const int CURVE_A=0;
 
 const chunk MConst=0x179435E5;
 const BIG Modulus= {0x13,0x270,0x2100,0x1C00D89C,0x25084,0xA284,0x24720,0x10803AA1,0x400DA88,0x10EA,0x11002487,0xD80362,0x900025B,0xC000048,0x2400003,0x48000};
+const BIG R2modp= {0x176BC23B,0xC1D2474,0x574FDC4,0x142EC91A,0x178D4665,0x1C4BCAA9,0x1EF6382,0xB17D97A,0x6EE86DA,0x7972AC,0x525CBAA,0x1DEE2BD8,0x15649EA5,0x53CDE01,0x1313D464,0x184D7};
+const BIG Rmodp= {0x1FFF78EC,0x1FEEABBF,0x1F1563FF,0x9FC0AEF,0xF8B8F57,0x1B7C9D8F,0xFCE587F,0x105F2F63,0x9EE5D75,0x1F87BF84,0x2FC503B,0x47EF81,0x3EF40DC,0xFFDFE20,0xFFE801,0x1FF80};
 const BIG CURVE_Order= {0xD,0x210,0x1F80,0x400D884,0x24FC4,0xA27E,0x10024708,0xFC03A9F,0x400DA88,0x10EA,0x11002487,0xD80362,0x900025B,0xC000048,0x2400003,0x48000};
 const BIG CURVE_Cof= {0x1,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0};
 const BIG CURVE_B= {0x2,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0};
@@ -1080,12 +1308,26 @@ const BIG CURVE_SB[2][2]= {{{0x4,0x50,0x180,0x14000014,0xC0,0x6,0x10000018,0xC00
 const BIG CURVE_WB[4]= {{0x0,0x8,0x80,0x2000002,0x40,0x2,0x10000008,0x400000,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0},{0x5,0xA8,0x700,0xA00182A,0x381,0x121C,0x100,0x3800487,0x4000048,0x61,0x9000009,0x180000,0x0,0x0,0x0,0x0},{0x3,0x58,0x380,0x16000C16,0x1C0,0x90E,0x10000080,0x1C00243,0x12000024,0x10000030,0x4800004,0xC0000,0x0,0x0,0x0,0x0},{0x1,0x18,0x80,0x6000006,0x40,0x2,0x10000008,0x400000,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}};
 const BIG CURVE_BB[4][4]= {{{0xD,0x208,0x1F80,0x200D882,0x24FC4,0xA27E,0x10024708,0xFC03A9F,0x400DA88,0x10EA,0x11002487,0xD80362,0x900025B,0xC000048,0x2400003,0x48000},{0xC,0x208,0x1F80,0x200D882,0x24FC4,0xA27E,0x10024708,0xFC03A9F,0x400DA88,0x10EA,0x11002487,0xD80362,0x900025B,0xC000048,0x2400003,0x48000},{0xC,0x208,0x1F80,0x200D882,0x24FC4,0xA27E,0x10024708,0xFC03A9F,0x400DA88,0x10EA,0x11002487,0xD80362,0x900025B,0xC000048,0x2400003,0x48000},{0x2,0x10,0x0,0x4000004,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}},{{0x1,0x10,0x0,0x4000004,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0},{0xC,0x208,0x1F80,0x200D882,0x24FC4,0xA27E,0x10024708,0xFC03A9F,0x400DA88,0x10EA,0x11002487,0xD80362,0x900025B,0xC000048,0x2400003,0x48000},{0xD,0x208,0x1F80,0x200D882,0x24FC4,0xA27E,0x10024708,0xFC03A9F,0x400DA88,0x10EA,0x11002487,0xD80362,0x900025B,0xC000048,0x2400003,0x48000},{0xC,0x208,0x1F80,0x200D882,0x24FC4,0xA27E,0x10024708,0xFC03A9F,0x400DA88,0x10EA,0x11002487,0xD80362,0x900025B,0xC000048,0x2400003,0x48000}},{{0x2,0x10,0x0,0x4000004,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0},{0x1,0x10,0x0,0x4000004,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0},{0x1,0x10,0x0,0x4000004,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0},{0x1,0x10,0x0,0x4000004,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}},{{0x2,0x8,0x0,0x2000002,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0},{0x2,0x20,0x0,0x8000008,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0},{0xA,0x200,0x1F80,0xD880,0x24FC4,0xA27E,0x10024708,0xFC03A9F,0x400DA88,0x10EA,0x11002487,0xD80362,0x900025B,0xC000048,0x2400003,0x48000},{0x2,0x8,0x0,0x2000002,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0}}};
 
+/* Curve constants pre-converted to n-residue form */
+const BIG CURVE_B_NRES= {0x1FFEF1D8,0x1FDD577F,0x1E2AC7FF,0x13F815DF,0x1F171EAE,0x16F93B1E,0x1F9CB0FF,0xBE5EC6,0x13DCBAEB,0x1F0F7F08,0x5F8A077,0x8FDF02,0x7DE81B8,0x1FFBFC40,0x1FFD002,0x3FF00};
+const BIG CURVE_Gx_NRES= {0x8727,0x1156B0,0xEABD00,0x1204CDAC,0x1076C12D,0x48404F4,0x1033EEA0,0x210B3D,0x1A127D13,0x785165,0xE03D44B,0x9013E1,0x510C17F,0x1C020228,0x1401801,0x28080};
+const BIG CURVE_Gy_NRES= {0x1FFF78EC,0x1FEEABBF,0x1F1563FF,0x9FC0AEF,0xF8B8F57,0x1B7C9D8F,0xFCE587F,0x105F2F63,0x9EE5D75,0x1F87BF84,0x2FC503B,0x47EF81,0x3EF40DC,0xFFDFE20,0xFFE801,0x1FF80};
+const BIG CURVE_Cru_NRES= {0x1732F789,0x1CD3247E,0x1F9230F,0x8A0FA08,0xEF6E382,0x3575770,0x7CDB0D2,0x17AA6E0C,0x732053,0x95C919F,0x3115DC,0x1E4903F5,0xCF17DB2,0x81A1F55,0x15A90F42,0x29E8C};
+const BIG CURVE_Fra_NRES= {0x1CF0CB01,0x18E06F02,0x15AED4D0,0xC87B18C,0x1E6968EB,0x1CC14612,0x1630B162,0x6038529,0xBEEB567,0x12C50B9F,0x1F4FA05,0x7FF6E46,0x1235045C,0x11C253DA,0x1736AF91,0x2A007};
+const BIG CURVE_Frb_NRES= {0x30F3512,0x71F936D,0xA514C2F,0xF79270F,0x198E799,0x33F5C71,0x9D195BD,0xA7CB577,0x18122521,0xD3B054A,0xF0B2A81,0x18D8951C,0x16CAFDFE,0x1A3DAC6D,0xB095071,0x1DFF8};
+const BIG CURVE_Pxa_NRES= {0x12FBE2CC,0x1E1CD90B,0x424E384,0x1FCB50F1,0x19D1CAED,0xEC9120C,0x8FFBB32,0x10705CEF,0x16F8C513,0x99C44E2,0xD36DFDB,0xFC0CB2B,0x3E40896,0x97576EF,0xB365631,0x2038F};
+const BIG CURVE_Pxb_NRES= {0x120198BB,0x138FFB80,0x1184BEFF,0x8AB2353,0x3100B2B,0x1FD67B8A,0xDD822EB,0x66D4B21,0x122097FF,0x104B7159,0xEEAB98B,0x12A9DBF9,0x40061A9,0x1E8BCE08,0x14BD30AA,0x44732};
+const BIG CURVE_Pya_NRES= {0xADCB697,0x1DE95182,0xAE6E29F,0xFEC6208,0x18FE1A20,0x1E7D321E,0x17F1B890,0x1D23305E,0x6314EAF,0x16E6DBFF,0x170851EE,0xC47ADC,0x1B9C3DDB,0x11F93D68,0x1CF4C68E,0x367A5};
+const BIG CURVE_Pyb_NRES= {0x1F7EC554,0x11E75BC0,0x409C62E,0x196F36B4,0x62513B,0x1700B368,0x2AAB2E5,0x1C794364,0x3502790,0x344F63A,0x60C8F15,0x1BC3E5F9,0x3EA3523,0x1FD95E37,0x1546404D,0x381EE};
+
 #endif
 
 #if CHUNK==64
 
 const chunk MConst=0xF33C46ED79435E5L;
 const BIG Modulus= {0x4E00000013L,0x4E006C4E0000840L,0x800014508002508L,0x888401D5080091CL,0x21C00021D4400DAL,0x25B06C01B144009L,0xD80000909000L,0x240000900L};
+const BIG R2modp= {0x37DD63A9638EA9FL,0x9228FA897ADA084L,0x5BB7FA58F1D713AL,0x5D600E3B039BF68L,0xE6084EB6C5B73EFL,0xE4897F68902BCFBL,0x58C2BC9A251535L,0xE2670615L};
+const BIG Rmodp= {0x5555E3378E39062L,0x961A289556455DL,0x8AACE995884330CL,0xD02DBF40565E02L,0xE5F00377AD46E22L,0x3D23482D35D8108L,0x148C000F645D04L,0x18000A600L};
 const BIG CURVE_Order= {0x420000000DL,0x42006C4200007E0L,0x2000144FC0024FCL,0x887E01D4FC0091CL,0x21C00021D4400DAL,0x25B06C01B144009L,0xD80000909000L,0x240000900L};
 const BIG CURVE_Cof= {0x1L,0x0L,0x0L,0x0L,0x0L,0x0L,0x0L,0x0L};
 const BIG CURVE_B= {0x2L,0x0L,0x0L,0x0L,0x0L,0x0L,0x0L,0x0L};
@@ -1105,6 +1347,18 @@ const BIG CURVE_SB[2][2]= {{{0xA00000004L,0xA00000A0000060L,0x60000000C00000CL,0
 const BIG CURVE_WB[4]= {{0x100000000L,0x10000010000020L,0x200000004000004L,0x200000400000L,0x0L,0x0L,0x0L,0x0L},{0x1500000005L,0x15000C1500001C0L,0x2438000038L,0x481C00243800004L,0x2400000C240000L,0xC000024000L,0x0L,0x0L},{0xB00000003L,0xB00060B00000E0L,0x121C00001CL,0x240E00121C00002L,0x12000006120000L,0x6000012000L,0x0L,0x0L},{0x300000001L,0x30000030000020L,0x200000004000004L,0x200000400000L,0x0L,0x0L,0x0L,0x0L}};
 const BIG CURVE_BB[4][4]= {{{0x410000000DL,0x41006C4100007E0L,0x2000144FC0024FCL,0x887E01D4FC0091CL,0x21C00021D4400DAL,0x25B06C01B144009L,0xD80000909000L,0x240000900L},{0x410000000CL,0x41006C4100007E0L,0x2000144FC0024FCL,0x887E01D4FC0091CL,0x21C00021D4400DAL,0x25B06C01B144009L,0xD80000909000L,0x240000900L},{0x410000000CL,0x41006C4100007E0L,0x2000144FC0024FCL,0x887E01D4FC0091CL,0x21C00021D4400DAL,0x25B06C01B144009L,0xD80000909000L,0x240000900L},{0x200000002L,0x20000020000000L,0x0L,0x0L,0x0L,0x0L,0x0L,0x0L}},{{0x200000001L,0x20000020000000L,0x0L,0x0L,0x0L,0x0L,0x0L,0x0L},{0x410000000CL,0x41006C4100007E0L,0x2000144FC0024FCL,0x887E01D4FC0091CL,0x21C00021D4400DAL,0x25B06C01B144009L,0xD80000909000L,0x240000900L},{0x410000000DL,0x41006C4100007E0L,0x2000144FC0024FCL,0x887E01D4FC0091CL,0x21C00021D4400DAL,0x25B06C01B144009L,0xD80000909000L,0x240000900L},{0x410000000CL,0x41006C4100007E0L,0x2000144FC0024FCL,0x887E01D4FC0091CL,0x21C00021D4400DAL,0x25B06C01B144009L,0xD80000909000L,0x240000900L}},{{0x200000002L,0x20000020000000L,0x0L,0x0L,0x0L,0x0L,0x0L,0x0L},{0x200000001L,0x20000020000000L,0x0L,0x0L,0x0L,0x0L,0x0L,0x0L},{0x200000001L,0x20000020000000L,0x0L,0x0L,0x0L,0x0L,0x0L,0x0L},{0x200000001L,0x20000020000000L,0x0L,0x0L,0x0L,0x0L,0x0L,0x0L}},{{0x100000002L,0x10000010000000L,0x0L,0x0L,0x0L,0x0L,0x0L,0x0L},{0x400000002L,0x40000040000000L,0x0L,0x0L,0x0L,0x0L,0x0L,0x0L},{0x400000000AL,0x40006C4000007E0L,0x2000144FC0024FCL,0x887E01D4FC0091CL,0x21C00021D4400DAL,0x25B06C01B144009L,0xD80000909000L,0x240000900L},{0x100000002L,0x10000010000000L,0x0L,0x0L,0x0L,0x0L,0x0L,0x0L}}};
 
+/* Curve constants pre-converted to n-residue form */
+const BIG CURVE_B_NRES= {0xAAABC18F1C720B1L,0xC4C2D8C4AAC827AL,0x9559BEDA908410FL,0x9181B61302CB2E8L,0xAA2006CD864DB69L,0x54962458BA6C208L,0x2840001E382A08L,0xC0014300L};
+const BIG CURVE_Gx_NRES= {0xAAAA21A871C6FB1L,0x449EC9C4AA9C2E2L,0xF5532ABAF7BF1FCL,0x7B8125E1029AB19L,0x3BCFFCAA26F92B8L,0xE88D23D47B6BF00L,0xFEC4BFFF12C32FBL,0xBFFF62FFL};
+const BIG CURVE_Gy_NRES= {0x5555E3378E39062L,0x961A289556455DL,0x8AACE995884330CL,0xD02DBF40565E02L,0xE5F00377AD46E22L,0x3D23482D35D8108L,0x148C000F645D04L,0x18000A600L};
+const BIG CURVE_Cru_NRES= {0x4627096F77DF0DAL,0xA1F9C9483F6A926L,0xDF1B0BD48AA04D9L,0x6D5760A10759FB1L,0xB58F8D3A4192093L,0x2A442650CD7A65BL,0x27A8E56AA26A53FL,0x1D1672B01L};
+const BIG CURVE_Fra_NRES= {0xDB2DC6ECAF5EA8BL,0x179822390642400L,0x9CE89C8C8F44B0BL,0xE23BB07E1F4DC68L,0x51C382B6819EB76L,0x81E572480176DA6L,0x5833F60CE5F3FC7L,0x179AAF3EL};
+const BIG CURVE_Frb_NRES= {0x24D23DF350A1588L,0x36684A14F9BE43FL,0xE31777C3F0BD9FDL,0xA6485156E8B2CB3L,0xCFFC7D6B52A1563L,0xA3CAF9B9AFCD262L,0xA7D989F32315038L,0x2286559C1L};
+const BIG CURVE_Pxa_NRES= {0xAFE8ACDE2C37F3DL,0x4A007C655300FF9L,0x992A3F3841C3375L,0x67519306258EFB4L,0x9ABAA1C1CDF46F1L,0xF75FA7CF2BBA09FL,0x240959D8C3EE889L,0x168D23FBFL};
+const BIG CURVE_Pxb_NRES= {0xF25EAC198A8EFE0L,0xEAB31ED27E80F1FL,0xBC213B5DD7DEF2DL,0xEB1B24FA7E237CAL,0xAEC289F9A483DAAL,0xBC3FE0D5A4DB46AL,0xFBE9B86D11FF6C4L,0x14A66629EL};
+const BIG CURVE_Pya_NRES= {0x9F54652B6889FB7L,0x5511A311269F712L,0x16E4F432D9CE059L,0x1FD412FF67D6862L,0x745E65B761D5630L,0x674A288EA4D2D9L,0x837264581F112CL,0x2D03CF30L};
+const BIG CURVE_Pyb_NRES= {0xB3B5372C54530C2L,0x3AEF0C1AB1D714EL,0x697797B836519BL,0x95858A9BEB18603L,0x185215FACD53AF7L,0x6CE372E2C72271EL,0x7564BFD90C594DDL,0xCE15272DL};
+
 
 #endif
 
@@ -1119,6 +1373,8 @@ const int CURVE_A=0;
 
 const chunk MConst=0x1F4017FD;
 const BIG Modulus= {0x2AB,0x1500000C,0xAAA55AA,0xB12AAD6,0x6D1BA6C,0xCCA5674,0x12E2CF6E,0xA9F9662,0x34BD939,0x12D8EAB1,0xFD9978E,0x9240600,0xE0F95B,0xAAB9550,0x55555E5,0xAAAAB};
+const BIG R2modp= {0x197BCCF1,0x3227D38,0x1A3E8147,0x1DE12162,0x6496579,0x8A0A53F,0xAC329D,0xC1CC139,0x1CFB121B,0xC7ED7DD,0x1263FC4,0x29EE9FF,0xFE93988,0x1FD11E4,0x1876A39F,0x68E2E};
+const BIG Rmodp= {0x1FF801AB,0x14FFDC0B,0xBA955B2,0x131227D6,0x11A27562,0xDC6F9D0,0xA74843B,0xBDC6E9D,0x1FC02D3A,0x818D761,0x312EBCA,0x1D120484,0x1DF4E77F,0x7EBA53A,0x553A5E5,0xAA92B};
 const BIG CURVE_Order= {0x1FC00001,0x3FFF,0x10000070,0x1400000,0x1D100,0xF0003A8,0x13C0009,0x1E200,0x180002E0,0x400001,0x4000,0x0,0x0,0x0,0x0,0x0};
 const BIG CURVE_Cof= {0xABFFAAB,0x14AABFFD,0xD52AADA,0x1562AAAB,0x15556AAA,0x2A,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0};
 const BIG CURVE_B= {0xA,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0};
@@ -1134,12 +1390,26 @@ const BIG CURVE_Pxb= {0x749F03D,0xC843773,0xB17BCBA,0x1134AB4B,0x8EA016E,0x1A0D7
 const BIG CURVE_Pya= {0x181A77F4,0x191AD22,0x1E9F842A,0x1E1E6CF6,0xD55B9D9,0x1D062533,0x15BB1323,0x7ECBC1,0x1A9EC2EF,0x1EE14CE0,0x1E96B271,0xA794439,0x1C544324,0xE6AD5DC,0x16429B0F,0x448E3};
 const BIG CURVE_Pyb= {0x1E1FDBA2,0x1A09DB6C,0xF680D5B,0xFCC6122,0xC488E2A,0x1E489ECD,0x1005617E,0x1CF9EC36,0x1C89ED72,0x16C00D90,0x1563E595,0x1243DDC0,0x8698F9E,0x1BD81E7E,0xF2A0F4A,0x66A0};
 
+/* Curve constants pre-converted to n-residue form */
+const BIG CURVE_B_NRES= {0x1FAFF8AB,0x14FE980B,0x14A055FA,0x1B0D8CD6,0x12F9080A,0x16A8B80F,0x1E93DF70,0x170008AD,0x1FD72143,0x7582999,0x1016E1E3,0x106FF724,0x3A846C9,0xF2C347D,0x54475E4,0xA9BAB};
+const BIG CURVE_Gx_NRES= {0x89FAEB8,0x143D54FD,0xC65C0E0,0x17839229,0xC41D569,0xB7AE76B,0xD16A584,0x119D0E12,0xCEA2557,0x1E349091,0x45D5BE2,0xB992E86,0x96265CB,0x28F31D3,0x1F2EF58E,0xF357};
+const BIG CURVE_Gy_NRES= {0x170B5118,0x1BB6FFF5,0x79568B5,0x1D33293C,0x95D2A4F,0x5CA66E1,0x14B559D,0x1D971B14,0x1812566D,0x1F7706BE,0x8FFDBBF,0x1FD0C87F,0x5E2B057,0xE92F723,0x16ED4BE5,0x59748};
+const BIG CURVE_Cru_NRES= {0x28C626A,0x1A076D19,0x98B8D31,0x6D54FF4,0x1E025E25,0x115B65C9,0x100C5E4F,0x2DA1CD9,0x132472EE,0x10D3428,0x1B7EAFA4,0x1B7EE2F,0xD1E1B12,0x15AC8B15,0x37133AE,0x8E3C5};
+const BIG CURVE_Fra_NRES= {0x1557FB3A,0x1A6E176A,0x8041F8A,0x14D87992,0x925577B,0x1AC161F2,0x13129F8F,0x46873FD,0x1A6BFF1F,0x194AB032,0x2061B8C,0xFDEA8F,0x872222E,0x54EEB26,0x4D786A3,0x16E8E};
+const BIG CURVE_Frb_NRES= {0xAA80771,0x1A91E8A1,0x2A6361F,0x163A3144,0x1DAC62F0,0x1208F481,0x1FD02FDE,0x6372264,0x8DFDA1A,0x198E3A7E,0xDD37C01,0x8261B71,0x186ED72D,0x55CAA29,0x7DCF42,0x93C1D};
+const BIG CURVE_Pxa_NRES= {0x13DA64,0xFA5B90C,0x146EAD33,0x126EA087,0x6577F28,0x114DC234,0xFAB252A,0x14B31FD3,0x93A6DD,0x22219EB,0x14686872,0x141305D8,0x12FEB906,0x3BFB028,0x10B91CC8,0xA0E82};
+const BIG CURVE_Pxb_NRES= {0x62C34BC,0xC28933C,0x6E3E0FA,0x8A8C657,0xA92F1EB,0x1F10F735,0xBFBADE8,0x1D29F5B8,0xE3DE3F0,0x1F568CA6,0x3EC067C,0x5A1B846,0x14293109,0x9BFCE3B,0x4743DB6,0x7E582};
+const BIG CURVE_Pya_NRES= {0x18EB0C1B,0x17B1B07,0x1F527E85,0xD0BFD58,0x1CB02453,0xD74F89E,0x2F5D205,0xE3240AD,0x5F2D98,0x18EA83D9,0x72B7A53,0x7C2BC33,0x2FDCE3F,0x11CBCE6F,0x19328196,0xA6C4A};
+const BIG CURVE_Pyb_NRES= {0x15679B9,0x188C2ADD,0x1C442A6,0x15E9353C,0x9011325,0x1C08A258,0x8D02921,0x10EA06F2,0x1FC5971B,0x8488491,0x622E0F7,0x71B18EF,0x83C1231,0x11022D13,0xA01DBE9,0x191BC};
+
 #endif
 
 #if CHUNK==64
 
 const chunk MConst=0xB3EF8137F4017FDL;
 const BIG Modulus= {0xAA00001800002ABL,0xC589556B2AA956AL,0xB9994ACE86D1BA6L,0x3954FCB314B8B3DL,0xE3A5B1D56234BD9L,0x95B49203003F665L,0x57955572AA00E0FL,0x555559555L};
+const BIG R2modp= {0x7DD42D7BFF149ADL,0x3E0A69294905DDFL,0x47702B0D739FF96L,0x65323A468920931L,0xD7E2227CEF1D2BCL,0x276A8F68293321EL,0x30632AAB1F54ADFL,0x2106AC6EL};
+const BIG Rmodp= {0xA00002DFF00600CL,0x85D0070DFFF02FFL,0xADFA0FDBB074773L,0xF6B55F13572C8CDL,0x832663C914AAB95L,0x463CA38EE3B53EL,0xF902017CFC0DC7BL,0x23FFFL};
 const BIG CURVE_Order= {0x7FFFFC00001L,0xA00000400001CL,0x25E000750001D10L,0xE0000F10004F000L,0x80000380002L,0x10L,0x0L,0x0L};
 const BIG CURVE_Cof= {0xA9557FFAABFFAABL,0xAAB15555B54AAB6L,0x555556AAL,0x0L,0x0L,0x0L,0x0L,0x0L};
 const BIG CURVE_B= {0xAL,0x0L,0x0L,0x0L,0x0L,0x0L,0x0L,0x0L};
@@ -1155,6 +1425,18 @@ const BIG CURVE_Pxb= {0x99086EE6749F03DL,0xE89A55A5AC5EF2EL,0x7B41AECD88EA016L,0
 const BIG CURVE_Pya= {0x83235A4581A77F4L,0x9F0F367B7A7E10AL,0x8FA0C4A66D55B9DL,0xEF03F65E0D6EC4CL,0x9C7DC299C1A9EC2L,0x32453CA21CFA5ACL,0x6C3DCD5ABB9C544L,0x22471D90AL};
 const BIG CURVE_Pyb= {0xF413B6D9E1FDBA2L,0xA7E630913DA0356L,0xFBC913D9AC488E2L,0x72E7CF61B401585L,0x656D801B21C89EDL,0xF9E921EEE0558F9L,0x3D2B7B03CFC8698L,0x33503CA8L};
 
+/* Curve constants pre-converted to n-residue form */
+const BIG CURVE_B_NRES= {0x40001CBF603C078L,0x3A20468BFF61DFCL,0xCBC49E94E48CA83L,0xA315B6C167BD808L,0x1F7FE5DACEAB3DBL,0x2BE5E6394E51471L,0xBA140EE1D889CCEL,0x167FFFL};
+const BIG CURVE_Gx_NRES= {0x89F8667AE7B2310L,0x7C2814D9CC79734L,0x63F2E4DE44FCF47L,0x5ABDDFCF3DA155L,0x35384EFE4F30C21L,0xA5545E9BCF20463L,0x5338F2A32E5992EL,0x14C5D2B5AL};
+const BIG CURVE_Gy_NRES= {0x73DEDC64FB20346L,0x333AACBF550C947L,0xB6289DAF290BB3CL,0xEF4D7B4C6E1207BL,0x4B31D7C1E4B18E1L,0x7D8470F8C475487L,0xEACF84CEE0C5656L,0x43A29AE67L};
+const BIG CURVE_Cru_NRES= {0x161E2856030C8E2L,0xF19FF4025022D1DL,0xA1971B3A784D86DL,0xF2C4F4D020FEF0BL,0x35314177DEE8704L,0xFCFF43AB24482C7L,0xAAF8F0EA9E9C816L,0x2586E4CDAL};
+const BIG CURVE_Fra_NRES= {0x6CD21CC7ADE51E1L,0x3C8CDC778124288L,0x639EAE36828889AL,0x263056F598E7745L,0xE0907417119B79CL,0x20F7D66895CD7F2L,0x3441F8C91EF555L,0x1B57184EAL};
+const BIG CURVE_Frb_NRES= {0x3D2DE350521B0CAL,0x88FC78F3A9852E2L,0x55FA9C98044930CL,0x1324A5BD7BD13F8L,0x3153DBE509943DL,0x74BCBB9A6A71E73L,0x545135E618118BAL,0x39FE4106BL};
+const BIG CURVE_Pxa_NRES= {0x5A01609D7E00F8CL,0x97F3C0DF55C2ECL,0xB5C337339B49952L,0xFC8F350D7598441L,0x783E0BE64901C9BL,0x3F29A001DB7A497L,0x68DA5DD3129D6E1L,0x1068D7101L};
+const BIG CURVE_Pxb_NRES= {0x7E669E632C260D4L,0x244B71CE7F9CDCFL,0x3FA19E8C9725280L,0x14B405BDF74608L,0xF75F115C4B17594L,0x4FF4A254C0D59A3L,0xCEE410D1DAA4F03L,0xE26FF52EL};
+const BIG CURVE_Pya_NRES= {0xF9F81B2097F9C9EL,0x8EDF27B8464EB1CL,0x5F45125F5123EDCL,0x10A103EC0172345L,0x3AC4EA71DDE3436L,0x51F97EECBA88182L,0x63DD24D8E5F9571L,0x526408427L};
+const BIG CURVE_Pyb_NRES= {0x1BB68D8F954861DL,0x599C2627674A31CL,0x6648CD2DC2BFF4FL,0x2E96DDFCAA5AFEEL,0x55F2E6ECE53A3D7L,0xA03DA49437DDAA6L,0xB956A723E0F9A26L,0x373F284A6L};
+
 #endif
 
 
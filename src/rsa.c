@@ -39,7 +39,8 @@
 /* general purpose hash function w=hash(p|n|x|y) */
 static int hashit(int sha,octet *p,int n,octet *w)
 {
-    int i,c[4],hlen;
+    int i,hlen;
+    char c[4];
     hash256 sha256;
     hash512 sha512;
     char hh[64];
@@ -59,41 +60,38 @@ static int hashit(int sha,octet *p,int n,octet *w)
 
     hlen=sha;
 
-    if (p!=NULL) for (i=0; i<p->len; i++)
+    if (p!=NULL)
+    {
+        switch(sha)
         {
-            switch(sha)
-            {
-            case SHA256:
-                HASH256_process(&sha256,p->val[i]);
-                break;
-            case SHA384:
-                HASH384_process(&sha512,p->val[i]);
-                break;
-            case SHA512:
-                HASH512_process(&sha512,p->val[i]);
-                break;
-            }
+        case SHA256:
+            HASH256_update(&sha256,p->val,p->len);
+            break;
+        case SHA384:
+            HASH384_update(&sha512,p->val,p->len);
+            break;
+        case SHA512:
+            HASH512_update(&sha512,p->val,p->len);
+            break;
         }
+    }
     if (n>=0)
     {
         c[0]=(n>>24)&0xff;
         c[1]=(n>>16)&0xff;
         c[2]=(n>>8)&0xff;
         c[3]=(n)&0xff;
-        for (i=0; i<4; i++)
+        switch(sha)
         {
-            switch(sha)
-            {
-            case SHA256:
-                HASH256_process(&sha256,c[i]);
-                break;
-            case SHA384:
-                HASH384_process(&sha512,c[i]);
-                break;
-            case SHA512:
-                HASH512_process(&sha512,c[i]);
-                break;
-            }
+        case SHA256:
+            HASH256_update(&sha256,c,4);
+            break;
+        case SHA384:
+            HASH384_update(&sha512,c,4);
+            break;
+        case SHA512:
+            HASH512_update(&sha512,c,4);
+            break;
         }
     }
 
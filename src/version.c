@@ -43,6 +43,9 @@ void amcl_version(void)
     printf("MODBYTES - Number of bytes in Modulus: %d\n", MODBYTES);
     printf("BASEBITS - Numbers represented to base 2*BASEBITS: %d\n", BASEBITS);
     printf("NLEN - Number of words in BIG: %d\n", NLEN);
+    printf("Backends: FP %s, AES %s, GHASH %s, SHA-256 %s, FP x8 %s\n", CPU_backend(CPU_KERNEL_FP),
+           CPU_backend(CPU_KERNEL_AES), CPU_backend(CPU_KERNEL_GHASH), CPU_backend(CPU_KERNEL_SHA256),
+           CPU_backend(CPU_KERNEL_FP_X8));
 
     BIG p, r;
     BIG_rcopy(p,Modulus);
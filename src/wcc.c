@@ -72,9 +72,9 @@ static void mapit2(octet *h,ECP2 *Q)
         BIG_inc(hv,1);
     }
 
-    BIG_rcopy(Fx,CURVE_Fra);
-    BIG_rcopy(Fy,CURVE_Frb);
-    FP2_from_BIGs(&X,Fx,Fy);
+    BIG_rcopy(Fx,CURVE_Fra_NRES);
+    BIG_rcopy(Fy,CURVE_Frb_NRES);
+    FP2_from_FPs(&X,Fx,Fy);
     BIG_rcopy(x,CURVE_Bnx);
 
 #if CHOICE < BLS_CURVES
@@ -153,7 +153,8 @@ static void mapit2(octet *h,ECP2 *Q)
 /* Hash number (optional) and octet to octet */
 static void hashit(int sha,int n,octet *x,octet *w)
 {
-    int i,c[4],hlen;
+    int i,hlen;
+    char c[4];
     hash256 sha256;
     hash512 sha512;
     char hh[64];
@@ -179,37 +180,34 @@ static void hashit(int sha,int n,octet *x,octet *w)
         c[1]=(n>>16)&0xff;
         c[2]=(n>>8)&0xff;
         c[3]=(n)&0xff;
-        for (i=0; i<4; i++)
+        switch(sha)
         {
-            switch(sha)
-            {
-            case SHA256:
-                HASH256_process(&sha256,c[i]);
-                break;
-            case SHA384:
-                HASH384_process(&sha512,c[i]);
-                break;
-            case SHA512:
-                HASH512_process(&sha512,c[i]);
-                break;
-            }
+        case SHA256:
+            HASH256_update(&sha256,c,4);
+            break;
+        case SHA384:
+            HASH384_update(&sha512,c,4);
+            break;
+        case SHA512:
+            HASH512_update(&sha512,c,4);
+            break;
         }
     }
-    if (x!=NULL) for (i=0; i<x->len; i++)
+    if (x!=NULL)
+    {
+        switch(sha)
         {
-            switch(sha)
-            {
-            case SHA256:
-                HASH256_process(&sha256,x->val[i]);
-                break;
-            case SHA384:
-                HASH384_process(&sha512,x->val[i]);
-                break;
-            case SHA512:
-                HASH512_process(&sha512,x->val[i]);
-                break;
-            }
+        case SHA256:
+            HASH256_update(&sha256,x->val,x->len);
+            break;
+        case SHA384:
+            HASH384_update(&sha512,x->val,x->len);
+            break;
+        case SHA512:
+            HASH512_update(&sha512,x->val,x->len);
+            break;
         }
+    }
 
     for (i=0; i<hlen; i++) hh[i]=0;
     switch (sha)
@@ -649,7 +647,7 @@ void WCC_AES_GCM_ENCRYPT(octet *K,octet *IV,octet *H,octet *P,octet *C,octet *T)
     gcm g;
     GCM_init(&g,K->len,K->val,IV->len,IV->val);
     GCM_add_header(&g,H->val,H->len);
-    GCM_add_plain(&g,C->val,P->val,P->len);
+    GCM_encrypt(&g,C->val,P->val,P->len);
     C->len=P->len;
     GCM_finish(&g,T->val);
     T->len=16;
@@ -662,7 +660,7 @@ void WCC_AES_GCM_DECRYPT(octet *K,octet *IV,octet *H,octet *C,octet *P,octet *T)
     gcm g;
     GCM_init(&g,K->len,K->val,IV->len,IV->val);
     GCM_add_header(&g,H->val,H->len);
-    GCM_add_cipher(&g,P->val,C->val,C->len);
+    GCM_decrypt(&g,P->val,C->val,C->len);
     P->len=C->len;
     GCM_finish(&g,T->val);
     T->len=16;
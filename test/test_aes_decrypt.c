@@ -206,6 +206,8 @@ int main(int argc, char** argv)
 
             // Decrypt
             int i=0;
+            char *BLOCKS = (char*) malloc(CIPHERTEXTLen);
+            memcpy(BLOCKS,CIPHERTEXT,CIPHERTEXTLen);
             AES_init(&a,mode,KEYLen,KEY,IV);
             for (i=0; i<(CIPHERTEXTLen/blockSize); i++)
             {
@@ -227,6 +229,18 @@ int main(int argc, char** argv)
                 exit(EXIT_FAILURE);
             }
 
+            // Decrypt all blocks together
+            AES_init(&a,mode,KEYLen,KEY,IV);
+            AES_decrypt_blocks(&a,BLOCKS,CIPHERTEXTLen/blockSize);
+            octet BLOCKSOct= {CIPHERTEXTLen,CIPHERTEXTLen,BLOCKS};
+            if (!OCT_comp(&BLOCKSOct,&PLAINTEXT1Oct))
+            {
+                printf("TEST AES DECRYPT FAILED COMPARE BLOCKS LINE %d\n",lineNo);
+                exit(EXIT_FAILURE);
+            }
+            free(BLOCKS);
+            BLOCKS = NULL;
+
             free(KEY);
             KEY = NULL;
             free(IV);
@@ -206,6 +206,9 @@ int main(int argc, char** argv)
 
             // Encrypt
             int i=0;
+            char *BLOCKS = (char*) malloc(2*PLAINTEXTLen);
+            memcpy(BLOCKS,PLAINTEXT,PLAINTEXTLen);
+            memcpy(&BLOCKS[PLAINTEXTLen],PLAINTEXT,PLAINTEXTLen);
             AES_init(&a,mode,KEYLen,KEY,IV);
             for (i=0; i<(PLAINTEXTLen/blockSize); i++)
             {
@@ -227,6 +230,32 @@ int main(int argc, char** argv)
                 exit(EXIT_FAILURE);
             }
 
+            // Encrypt all blocks together
+            AES_init(&a,mode,KEYLen,KEY,IV);
+            AES_encrypt_blocks(&a,BLOCKS,PLAINTEXTLen/blockSize);
+            octet BLOCKSOct= {PLAINTEXTLen,PLAINTEXTLen,BLOCKS};
+            if (!OCT_comp(&BLOCKSOct,&CIPHERTEXT1Oct))
+            {
+                printf("TEST AES ENCRYPT FAILED COMPARE BLOCKS LINE %d\n",lineNo);
+                exit(EXIT_FAILURE);
+            }
+
+            // Counter mode over a buffer ending in a partial block
+            if (mode==CTR16)
+            {
+                AES_init(&a,mode,KEYLen,KEY,IV);
+                AES_ctr_encrypt_bulk(&a,BLOCKS,&BLOCKS[PLAINTEXTLen],PLAINTEXTLen-5);
+                BLOCKSOct.len=PLAINTEXTLen-5;
+                CIPHERTEXT1Oct.len=PLAINTEXTLen-5;
+                if (!OCT_comp(&BLOCKSOct,&CIPHERTEXT1Oct))
+                {
+                    printf("TEST AES ENCRYPT FAILED COMPARE CTR LINE %d\n",lineNo);
+                    exit(EXIT_FAILURE);
+                }
+            }
+            free(BLOCKS);
+            BLOCKS = NULL;
+
             free(KEY);
             KEY = NULL;
             free(IV);
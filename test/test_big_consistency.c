@@ -42,6 +42,7 @@ int main()
 
     BIG F,G,H,I,Z;
     DBIG DF,DG;
+    BIG X[8],Y[8],U[8],V[8];
 
     /* Fake random source */
     RAND_clean(&rng);
@@ -257,6 +258,148 @@ int main()
         }
     }
 
+    /* Testing constant time reduction against BIG_mod, with excesses */
+    for (i=0; i<100; i++)
+    {
+        if (i&1) BIG_rcopy(H,CURVE_Order);
+        else BIG_rcopy(H,Modulus);
+        BIG_randomnum(F,H,&rng);
+        if (i>=4) BIG_pmul(F,F,FEXCESS>1600?1600:(int)FEXCESS-1);
+        else if (i>=2) BIG_copy(F,H);
+        BIG_norm(F);
+        BIG_copy(G,F);
+        BIG_mod(F,H);
+        BIG_mod_ct(G,H);
+        if(BIG_comp(F,G))
+        {
+            printf("ERROR testing constant time reduction BIG\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    /* Testing modular inverse, mod the modulus and the group order */
+    for (i=0; i<100; i++)
+    {
+        if (i&1) BIG_rcopy(H,CURVE_Order);
+        else BIG_rcopy(H,Modulus);
+        BIG_randomnum(F,H,&rng);
+        if (i==0) BIG_one(F);
+        if (i==2)
+        {
+            BIG_copy(F,H);
+            BIG_dec(F,1);
+            BIG_norm(F);
+        }
+        BIG_copy(G,F);
+        BIG_invmodp(I,G,H);
+        BIG_modmul(G,I,F,H);
+        BIG_one(Z);
+        if(BIG_comp(G,Z))
+        {
+            printf("ERROR testing modular inverse BIG\n");
+            exit(EXIT_FAILURE);
+        }
+        FP_nres(F);
+        if (i%4==2) BIG_add(F,F,H);
+        FP_inv(G,F);
+        FP_mul(G,G,F);
+        FP_reduce(G);
+        FP_one(Z);
+        if(i%2==0 && BIG_comp(G,Z))
+        {
+            printf("ERROR testing modular inverse FP\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    BIG_zero(F);
+    BIG_invmodp(I,F,H);
+    if(!BIG_iszilch(I))
+    {
+        printf("ERROR testing modular inverse of zero BIG\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Testing batch modular inverse against one at a time, with zeros and excesses */
+    BIG_rcopy(H,Modulus);
+    for (i=0; i<16; i++)
+    {
+        for (j=0; j<=i%8; j++)
+        {
+            BIG_randomnum(X[j],H,&rng);
+            if (j&1) BIG_pmul(X[j],X[j],j+1);
+            if (i>8 && j==i%4) BIG_zero(X[j]);
+        }
+        FP_inv_batch(i%8+1,U,X);
+        for (j=0; j<=i%8; j++)
+        {
+            FP_inv(F,X[j]);
+            FP_reduce(F);
+            FP_reduce(U[j]);
+            if(BIG_comp(F,U[j]))
+            {
+                printf("ERROR testing batch modular inverse FP\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+
+    /* Testing eight modular multiplications, squarings, additions and subtractions at once, with excesses */
+    BIG_rcopy(H,Modulus);
+    for (i=0; i<100; i++)
+    {
+        for (j=0; j<8; j++)
+        {
+            BIG_randomnum(X[j],H,&rng);
+            BIG_randomnum(Y[j],H,&rng);
+            if (j&1) BIG_pmul(X[j],X[j],j+1);
+            if (j&2) BIG_pmul(Y[j],Y[j],FEXCESS>1600?200:(int)(FEXCESS/8));
+        }
+        FP_mul_x8(U,X,Y);
+        for (j=0; j<8; j++)
+        {
+            FP_mul(F,X[j],Y[j]);
+            if(BIG_comp(F,U[j]))
+            {
+                printf("ERROR testing eight modular multiplications BIG\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+        FP_sqr_x8(V,X);
+        for (j=0; j<8; j++)
+        {
+            FP_sqr(F,X[j]);
+            if(BIG_comp(F,V[j]))
+            {
+                printf("ERROR testing eight modular squarings BIG\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+        FP_sub_x8(V,U,Y);
+        FP_add_x8(V,V,Y);
+        for (j=0; j<8; j++)
+        {
+            FP_reduce(V[j]);
+            FP_reduce(U[j]);
+            if(BIG_comp(U[j],V[j]))
+            {
+                printf("ERROR testing eight modular additions and subtractions BIG\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+        /* in place */
+        for (j=0; j<8; j++) BIG_copy(V[j],X[j]);
+        FP_mul_x8(V,V,Y);
+        FP_mul_x8(U,X,Y);
+        for (j=0; j<8; j++)
+        {
+            if(BIG_comp(U[j],V[j]))
+            {
+                printf("ERROR testing eight modular multiplications in place BIG\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+
     printf("SUCCESS TEST CONSISTENCY OF BIG PASSED\n");
     exit(EXIT_SUCCESS);
 }
@@ -31,6 +31,8 @@
 #include <time.h>
 #include "ecdh.h"
 
+#define N_KEYS 5
+
 int main()
 {
     int i,j=0,res;
@@ -52,8 +54,112 @@ int main()
     octet SALT= {0,sizeof(salt),salt};
     octet PW= {0,sizeof(pw),pw};
 
+    char hk[131],hm[64],ht[64],hv[64];
+    octet HK= {0,sizeof(hk),hk};
+    octet HM= {0,sizeof(hm),hm};
+    octet HT= {0,sizeof(ht),ht};
+    octet HV= {0,sizeof(hv),hv};
+    hmac_ctx HC;
+    int sha,k;
+    char bp[N_KEYS][150],bs[N_KEYS][16],bk[N_KEYS][8*EFS],rk[8*EFS],rf[EFS],ru[EFS];
+    octet BP[N_KEYS],BS[N_KEYS],BK[N_KEYS],*pBP[N_KEYS],*pBS[N_KEYS],*pBK[N_KEYS];
+    octet RK= {0,sizeof(rk),rk};
+    octet RF= {0,sizeof(rf),rf};
+    octet RU= {0,sizeof(ru),ru};
+
     csprng RNG;                /* Crypto Strong RNG */
 
+    /* HMAC test vectors from RFC 4231, test cases 2 and 6 */
+    OCT_jstring(&HK,"Jefe");
+    OCT_jstring(&HM,"what do ya want for nothing?");
+    OCT_fromHex(&HV,"5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843");
+    HMAC(SHA256,&HM,&HK,32,&HT);
+    if (!OCT_comp(&HT,&HV))
+    {
+        printf("*** HMAC Failed\n");
+        return 1;
+    }
+    OCT_empty(&HV);
+    OCT_fromHex(&HV,"164b7a7bfcf819e2e395fbe73b56e0a387bd64222e831fd610270cd7ea2505549758bf75c05a994a6d034f65f8f0e6fdcaeab1a34d4a6b4b636e070a38bce737");
+    HMAC_init(&HC,SHA512,&HK);
+    for (i=0; i<2; i++)
+    {
+        HMAC_update(&HC,HM.val,4);
+        HMAC_update(&HC,HM.val+4,HM.len-4);
+        HMAC_final(&HC,64,&HT);
+        if (!OCT_comp(&HT,&HV))
+        {
+            printf("*** HMAC_final Failed\n");
+            return 1;
+        }
+    }
+    HMAC_end(&HC);
+
+    OCT_empty(&HK);
+    OCT_jbyte(&HK,0xaa,131);
+    OCT_empty(&HM);
+    OCT_jstring(&HM,"Test Using Larger Than Block-Size Key - Hash Key First");
+    OCT_empty(&HV);
+    OCT_fromHex(&HV,"60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54");
+    HMAC_init(&HC,SHA256,&HK);
+    HMAC_ctx(&HC,&HM,32,&HT);
+    HMAC_end(&HC);
+    if (!OCT_comp(&HT,&HV))
+    {
+        printf("*** HMAC_ctx Failed\n");
+        return 1;
+    }
+
+    /* PBKDF2 and PBKDF2_batch against the definition, over several groups of lanes */
+    for (i=0; i<N_KEYS; i++)
+    {
+        BP[i].len=BS[i].len=BK[i].len=0;
+        BP[i].max=sizeof(bp[i]);
+        BS[i].max=sizeof(bs[i]);
+        BK[i].max=sizeof(bk[i]);
+        BP[i].val=bp[i];
+        BS[i].val=bs[i];
+        BK[i].val=bk[i];
+        OCT_jbyte(&BP[i],'a'+i,1+37*i);   /* last password is longer than a hash block */
+        OCT_jbyte(&BS[i],i,8+i);
+        pBP[i]=&BP[i];
+        pBS[i]=&BS[i];
+        pBK[i]=&BK[i];
+    }
+    for (sha=SHA256; sha<=SHA512; sha+=16)
+    {
+        PBKDF2_batch(sha,N_KEYS,pBP,pBS,20,3*sha+1,pBK);
+        for (i=0; i<N_KEYS; i++)
+        {
+            OCT_empty(&RK);
+            for (j=1; j<=4; j++)   /* 4 blocks for 3*sha+1 bytes */
+            {
+                OCT_jint(&BS[i],j,4);
+                HMAC(sha,&BS[i],&BP[i],EFS,&RF);
+                BS[i].len-=4;
+                OCT_copy(&RU,&RF);
+                for (k=2; k<=20; k++)
+                {
+                    HMAC(sha,&RU,&BP[i],EFS,&RU);
+                    OCT_xor(&RF,&RU);
+                }
+                OCT_joctet(&RK,&RF);
+            }
+            OCT_chop(&RK,NULL,3*sha+1);
+            if (!OCT_comp(&RK,&BK[i]))
+            {
+                printf("*** PBKDF2_batch Failed\n");
+                return 1;
+            }
+            PBKDF2(sha,&BP[i],&BS[i],20,3*sha+1,&BK[i]);
+            if (!OCT_comp(&RK,&BK[i]))
+            {
+                printf("*** PBKDF2 Failed\n");
+                return 1;
+            }
+        }
+    }
+
     time((time_t *)&ran);
 
     RAW.len=100;				/* fake random seed source */
@@ -0,0 +1,148 @@
+/**
+ * @file test_ecdsa_batch.c
+ * @brief Test batch ECDSA verification against single verification
+ *
+ * LICENSE
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ecdh.h"
+
+#define NB (ECDH_BATCH+5)
+#define NKEYS 4
+
+int main()
+{
+    int i,j,res,results[NB];
+    char raw[100];
+    csprng RNG;
+    BIG k,x,y;
+    ECP R;
+
+    char s[NKEYS][EGS],w[NKEYS][2*EFS+1];
+    octet S[NKEYS],WK[NKEYS];
+    char m[NB][32],c[NB][EGS+1],c1[NB][EGS+1],d[NB][EGS],d1[NB][EGS],kk[EGS];
+    octet M[NB],C[NB],C1[NB],D[NB],D1[NB];
+    octet K= {0,sizeof(kk),kk};
+    octet *pW[NB],*pM[NB],*pC[NB],*pD[NB];
+
+    /* Fake random source */
+    for (i=0; i<100; i++) raw[i]=(char)i;
+    RAND_seed(&RNG,100,raw);
+
+    for (i=0; i<NKEYS; i++)
+    {
+        S[i].len=0;
+        S[i].max=EGS;
+        S[i].val=s[i];
+        WK[i].len=0;
+        WK[i].max=2*EFS+1;
+        WK[i].val=w[i];
+        ECP_KEY_PAIR_GENERATE(&RNG,&S[i],&WK[i]);
+    }
+
+    for (i=0; i<NB; i++)
+    {
+        M[i].len=0;
+        M[i].max=sizeof(m[i]);
+        M[i].val=m[i];
+        C[i].len=0;
+        C[i].max=EGS+1;
+        C[i].val=c[i];
+        C1[i].len=0;
+        C1[i].max=EGS+1;
+        C1[i].val=c1[i];
+        D[i].len=0;
+        D[i].max=EGS;
+        D[i].val=d[i];
+        D1[i].len=0;
+        D1[i].max=EGS;
+        D1[i].val=d1[i];
+
+        OCT_rand(&M[i],&RNG,sizeof(m[i]));
+        if (ECPSP_DSA(HASH_TYPE_ECC,&RNG,&K,&S[i%NKEYS],&M[i],&C[i],&D[i])!=0)
+        {
+            printf("ERROR signing message %d\n",i);
+            exit(EXIT_FAILURE);
+        }
+
+        /* prepend y parity of R=k.G, except for some signatures */
+        if (i%9!=4)
+        {
+            BIG_fromBytes(k,K.val);
+            ECP_mul_gen(&R,k);
+            for (j=EGS; j>0; j--) C[i].val[j]=C[i].val[j-1];
+            C[i].val[0]=0x02+ECP_get(x,y,&R);
+            C[i].len=EGS+1;
+        }
+
+        /* wrong parity. Valid signature, but cannot be batched */
+        if (i==10) C[i].val[0]^=1;
+        /* bad signatures */
+        if (i%7==2) M[i].val[0]^=1;
+
+        pW[i]=&WK[i%NKEYS];
+        pM[i]=&M[i];
+        pC[i]=&C[i];
+        pD[i]=&D[i];
+    }
+
+    res=ECPVP_DSA_batch(HASH_TYPE_ECC,ECDH_BATCH,pW,pM,pC,pD,results);
+    for (i=0; i<ECDH_BATCH; i++)
+    {
+        if ((i%7==2 && results[i]==0) || (i%7!=2 && results[i]!=0))
+        {
+            printf("ERROR batch verification result %d\n",i);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (res==0)
+    {
+        printf("ERROR batch verification accepted bad signatures\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* against single verification, over more than one batch */
+    res=ECPVP_DSA_batch(HASH_TYPE_ECC,NB,pW,pM,pC,pD,results);
+    for (i=0; i<NB; i++)
+    {
+        OCT_copy(&C1[i],&C[i]);
+        OCT_copy(&D1[i],&D[i]);
+        if (results[i]!=ECPVP_DSA(HASH_TYPE_ECC,pW[i],&M[i],&C1[i],&D1[i]))
+        {
+            printf("ERROR batch verification differs from single verification %d\n",i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    /* good signatures only */
+    for (i=0; i<NB; i++)
+        if (i%7==2) M[i].val[0]^=1;
+    res=ECPVP_DSA_batch(HASH_TYPE_ECC,NB,pW,pM,pC,pD,results);
+    if (res!=0)
+    {
+        printf("ERROR batch verification of good signatures\n");
+        exit(EXIT_FAILURE);
+    }
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,203 @@
+/**
+ * @file test_ecp_consistency.c
+ * @brief Test for consistency of ECP multiplication methods
+ *
+ * LICENSE
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "amcl.h"
+
+#define N_ITER 20
+#define N_MULTI (ECP_PIPPENGER_MAX+ECP_PIPPENGER_MIN+3)
+
+int main()
+{
+    int i;
+    char raw[100];
+    csprng rng;
+    BIG r,s,gx,one,work[N_MULTI];
+    ECP G,P,Q,A[N_MULTI],B[N_MULTI];
+#if CURVETYPE!=MONTGOMERY
+    BIG gy,t,e[N_MULTI];
+    ECP R,S,W,X[N_MULTI];
+#endif
+
+    /* Fake random source */
+    RAND_clean(&rng);
+    for (i=0; i<100; i++) raw[i]=(char)i;
+    RAND_seed(&rng,100,raw);
+
+    BIG_rcopy(r,CURVE_Order);
+    BIG_rcopy(gx,CURVE_Gx);
+#if CURVETYPE!=MONTGOMERY
+    BIG_rcopy(gy,CURVE_Gy);
+    ECP_set(&G,gx,gy);
+#else
+    ECP_set(&G,gx);
+#endif
+
+    /* Fixed-base multiplication of the generator against generic multiplication */
+    for (i=0; i<N_ITER+5; i++)
+    {
+        switch (i)
+        {
+        case 0:
+            BIG_zero(s);
+            break;
+        case 1:
+            BIG_one(s);
+            break;
+        case 2:
+            BIG_one(s);
+            BIG_inc(s,1);
+            break;
+        case 3:
+            BIG_copy(s,r);
+            BIG_dec(s,1);
+            BIG_norm(s);
+            break;
+        case 4:
+            BIG_copy(s,r);
+            break;
+        default:
+            BIG_randomnum(s,r,&rng);
+        }
+
+        ECP_copy(&P,&G);
+        ECP_mul(&P,s);
+        ECP_mul_gen(&Q,s);
+        if (!ECP_equals(&P,&Q))
+        {
+            printf("ERROR fixed-base multiplication of generator, iteration %d\n",i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    /* Batch conversion to affine coordinates against one at a time */
+    FP_one(one);
+    for (i=0; i<N_MULTI; i++)
+    {
+        BIG_randomnum(s,r,&rng);
+        if (i==3) BIG_zero(s);
+        ECP_mul_gen(&A[i],s);
+        ECP_dbl(&A[i]);
+        ECP_copy(&B[i],&A[i]);
+        ECP_affine(&B[i]);
+    }
+    ECP_affine_batch(N_MULTI,A,work);
+    for (i=0; i<N_MULTI; i++)
+    {
+        if (ECP_isinf(&B[i]))
+        {
+            if (ECP_isinf(&A[i])) continue;
+            printf("ERROR batch conversion to affine, point %d\n",i);
+            exit(EXIT_FAILURE);
+        }
+#if CURVETYPE!=MONTGOMERY
+        if (BIG_comp(A[i].y,B[i].y))
+        {
+            printf("ERROR batch conversion to affine, point %d\n",i);
+            exit(EXIT_FAILURE);
+        }
+#endif
+        if (BIG_comp(A[i].x,B[i].x) || BIG_comp(A[i].z,one))
+        {
+            printf("ERROR batch conversion to affine, point %d\n",i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+#if CURVETYPE!=MONTGOMERY
+    /* Variable time double multiplication against sum of single multiplications */
+    for (i=0; i<N_ITER+2; i++)
+    {
+        BIG_randomnum(s,r,&rng);
+        BIG_randomnum(t,r,&rng);
+        if (i==0) BIG_zero(s);
+        if (i==1) BIG_zero(t);
+
+        BIG_randomnum(gx,r,&rng);
+        ECP_mul_gen(&W,gx);
+
+        ECP_copy(&P,&W);
+        ECP_mul(&P,s);
+        ECP_copy(&Q,&G);
+        ECP_mul(&Q,t);
+        ECP_add(&P,&Q);
+
+        ECP_copy(&R,&W);
+        ECP_mul2_vartime(&R,NULL,s,t);
+        ECP_copy(&S,&W);
+        ECP_copy(&Q,&G);
+        ECP_mul2_vartime(&S,&Q,s,t);
+        if (!ECP_equals(&P,&R) || !ECP_equals(&P,&S))
+        {
+            printf("ERROR variable time double multiplication, iteration %d\n",i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    /* Multi-multiplication against sum of single multiplications */
+    ECP_inf(&P);
+    ECP_inf(&R);
+    for (i=0; i<N_MULTI; i++)
+    {
+        BIG_randomnum(e[i],r,&rng);
+        BIG_randomnum(t,r,&rng);
+        ECP_mul_gen(&X[i],t);
+        if (i==3) ECP_inf(&X[i]);
+        if (i==5) BIG_zero(e[i]);
+        if (i==8 || i==10)
+        {
+            /* same or opposite point in the same bucket */
+            ECP_copy(&X[i],&X[i-1]);
+            if (i==10) ECP_neg(&X[i]);
+            BIG_copy(e[i],e[i-1]);
+        }
+
+        ECP_copy(&Q,&X[i]);
+        ECP_mul(&Q,e[i]);
+        ECP_add(&P,&Q);
+        if (i==ECP_MULN_MAX+3) ECP_copy(&R,&P);
+    }
+
+    /* Straus */
+    ECP_muln(&Q,ECP_MULN_MAX+4,X,e);
+    ECP_muln_ct(&S,ECP_MULN_MAX+4,X,e);
+    if (!ECP_equals(&R,&Q) || !ECP_equals(&R,&S))
+    {
+        printf("ERROR multi-multiplication of %d points\n",ECP_MULN_MAX+4);
+        exit(EXIT_FAILURE);
+    }
+
+    /* Pippenger */
+    ECP_muln(&Q,N_MULTI,X,e);
+    if (!ECP_equals(&P,&Q))
+    {
+        printf("ERROR multi-multiplication of %d points\n",N_MULTI);
+        exit(EXIT_FAILURE);
+    }
+#endif
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
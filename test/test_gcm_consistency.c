@@ -0,0 +1,143 @@
+/**
+ * @file test_gcm_consistency.c
+ * @brief Test for consistency of AES-GCM GHASH backends and call patterns
+ *
+ * LICENSE
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "amcl.h"
+
+#define MAX_LEN 600
+
+static unsign64 T16[2*GCM_TABLE8_SIZE];
+
+int main()
+{
+    int i,n,b,h,len,niv;
+    char K[32],IV[32],H[MAX_LEN],M[MAX_LEN],C[MAX_LEN],D[MAX_LEN],T1[16],T2[16];
+    gcm g;
+    gcm_key k16,k0;
+
+    for (i=0; i<32; i++)
+    {
+        K[i]=(char)(3*i+1);
+        IV[i]=(char)(5*i+7);
+    }
+    for (i=0; i<MAX_LEN; i++)
+    {
+        H[i]=(char)(i*i+11);
+        M[i]=(char)(7*i+13);
+    }
+
+    GCM_key_init(&k16,16,K,T16,GCM_TABLE8_SIZE);
+    GCM_key_init(&k0,16,K,NULL,0);
+    if (GCM_key_set_ghash(&k0,GCM_GHASH_TABLE4))
+    {
+        printf("ERROR table backend selected without a table\n");
+        exit(EXIT_FAILURE);
+    }
+    if (k16.ghash!=GCM_GHASH_BITS && k16.ghash!=GCM_GHASH_CLMUL)
+    {
+        printf("ERROR table backend chosen by default\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (len=0; len<MAX_LEN; len+=7)
+    {
+        h=len%50;
+        niv=(len%3==0)?12:(len%32)+1;
+
+        /* Portable backend, single calls */
+        GCM_init(&g,16+8*(len%3),K,niv,IV);
+        GCM_set_ghash(&g,GCM_GHASH_BITS);
+        if (GCM_set_ghash(&g,GCM_GHASH_TABLE4))
+        {
+            printf("ERROR table backend selected by GCM_init\n");
+            exit(EXIT_FAILURE);
+        }
+        GCM_add_header(&g,H,h);
+        GCM_add_plain(&g,C,M,len);
+        GCM_finish(&g,T1);
+
+        /* Default backend, block multiple calls, decrypting in place */
+        memcpy(D,C,len);
+        GCM_init(&g,16+8*(len%3),K,niv,IV);
+        GCM_add_header(&g,H,h-h%16);
+        GCM_add_header(&g,&H[h-h%16],h%16);
+        for (n=0; n+32<len; n+=32) GCM_add_cipher(&g,&D[n],&D[n],32);
+        GCM_add_cipher(&g,&D[n],&D[n],len-n);
+        GCM_finish(&g,T2);
+
+        if (memcmp(D,M,len)!=0 || memcmp(T1,T2,16)!=0)
+        {
+            printf("ERROR GHASH backends disagree, length %d\n",len);
+            exit(EXIT_FAILURE);
+        }
+
+        /* Default backend, whole buffer, out of place */
+        GCM_init(&g,16+8*(len%3),K,niv,IV);
+        GCM_add_header(&g,H,h);
+        GCM_encrypt(&g,D,M,len);
+        GCM_finish(&g,T2);
+
+        if (memcmp(D,C,len)!=0 || memcmp(T1,T2,16)!=0)
+        {
+            printf("ERROR bulk encryption, length %d\n",len);
+            exit(EXIT_FAILURE);
+        }
+
+        /* Shared keys, each backend and table size */
+        for (b=GCM_GHASH_BITS; len%3==0 && b<=GCM_GHASH_CLMUL; b++)
+        {
+            if (!GCM_key_set_ghash(&k16,b)) continue;
+            GCM_start(&g,&k16,niv,IV);
+            GCM_add_header(&g,H,h);
+            GCM_decrypt(&g,D,C,len);
+            GCM_finish(&g,T2);
+
+            if (memcmp(D,M,len)!=0 || memcmp(T1,T2,16)!=0)
+            {
+                printf("ERROR shared key, backend %d, length %d\n",b,len);
+                exit(EXIT_FAILURE);
+            }
+
+            if (!GCM_key_set_ghash(&k0,b)) continue;
+            GCM_start(&g,&k0,niv,IV);
+            GCM_add_header(&g,H,h);
+            GCM_encrypt(&g,D,M,len);
+            GCM_finish(&g,T2);
+
+            if (memcmp(D,C,len)!=0 || memcmp(T1,T2,16)!=0)
+            {
+                printf("ERROR shared key without table, backend %d, length %d\n",b,len);
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+
+    GCM_key_end(&k16);
+    GCM_key_end(&k0);
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
@@ -41,6 +41,67 @@ typedef enum { false, true } bool;
 #define LINE_LEN 600
 // #define DEBUG
 
+#define N_MULTI 11
+
+static char buf[1200];
+static hash256 h256[N_MULTI];
+static hash512 h512[N_MULTI];
+
+/* Check the multi-message hashes against one message at a time, with more messages than lanes, so that lanes take
+   new messages while others are busy. sha is 32, 48 or 64, and p selects states to resume from after a prefix, none
+   (0), on block boundaries (1) or not (2). Returns 0 if any digest differs */
+static int check_multi(int sha,int p)
+{
+    static const size_t len[N_MULTI]= {0,55,56,64,111,112,128,200,239,240,1000};
+    char md[N_MULTI][64],ref[64],*pmd[N_MULTI];
+    const char *msg[N_MULTI];
+    const hash256 *s256[N_MULTI];
+    const hash512 *s512[N_MULTI];
+    hash256 t256;
+    hash512 t512;
+    int i,pre;
+
+    for (i=0; i<N_MULTI; i++)
+    {
+        msg[i]=buf+i;
+        pmd[i]=md[i];
+        s256[i]=&h256[i];
+        s512[i]=&h512[i];
+        pre=(p==0)?0:(p==1)?(i%3)*(sha==32?64:128):i*13;
+        if (sha==32) HASH256_init(&h256[i]);
+        if (sha==48) HASH384_init(&h512[i]);
+        if (sha==64) HASH512_init(&h512[i]);
+        if (sha==32) HASH256_update(&h256[i],buf+100,pre);
+        else HASH512_update(&h512[i],buf+100,pre);
+    }
+
+    if (sha==32 && p==0) HASH256_multi(N_MULTI,msg,len,pmd);
+    if (sha==48 && p==0) HASH384_multi(N_MULTI,msg,len,pmd);
+    if (sha==64 && p==0) HASH512_multi(N_MULTI,msg,len,pmd);
+    if (sha==32 && p!=0) HASH256_multi_final(N_MULTI,s256,msg,len,pmd);
+    if (sha==48 && p!=0) HASH384_multi_final(N_MULTI,s512,msg,len,pmd);
+    if (sha==64 && p!=0) HASH512_multi_final(N_MULTI,s512,msg,len,pmd);
+
+    for (i=0; i<N_MULTI; i++)
+    {
+        t256=h256[i];
+        t512=h512[i];
+        if (sha==32)
+        {
+            HASH256_update(&t256,msg[i],len[i]);
+            HASH256_hash(&t256,ref);
+        }
+        else
+        {
+            HASH512_update(&t512,msg[i],len[i]);
+            if (sha==48) HASH384_hash(&t512,ref);
+            else HASH512_hash(&t512,ref);
+        }
+        if (memcmp(ref,md[i],sha)!=0) return 0;
+    }
+    return 1;
+}
+
 int main(int argc, char** argv)
 {
     if (argc != 3)
@@ -49,7 +110,7 @@ int main(int argc, char** argv)
         exit(EXIT_FAILURE);
     }
 
-    int i=0;
+    int i=0,b,bad;
     FILE * fp = NULL;
     char line[LINE_LEN];
     char * linePtr = NULL;
@@ -63,6 +124,11 @@ int main(int argc, char** argv)
     char * MD = NULL;
 
     char * MD1 = NULL;
+    char MD2[64];
+    char MD3[3][64];
+    const char *pMsg[3];
+    size_t lMsg[3];
+    char *pMD[3]= {MD3[0],MD3[1],MD3[2]};
 
     hash256 sha256;
     hash512 sha512;
@@ -139,17 +205,41 @@ int main(int argc, char** argv)
                 for (i=0; i<MsgLen; i++)
                     HASH512_process(&sha512,Msg[i]);
                 HASH512_hash(&sha512,MD);
+
+                // Same again in whole blocks
+                HASH512_update(&sha512,Msg,MsgLen);
+                HASH512_hash(&sha512,MD2);
             }
             else
             {
                 for (i=0; i<MsgLen; i++)
                     HASH256_process(&sha256,Msg[i]);
                 HASH256_hash(&sha256,MD);
+
+                // Same again in whole blocks, with each compression function
+                for (b=HASH256_PORTABLE; b<=HASH256_SHANI; b++)
+                {
+                    if (!HASH256_set_backend(b)) continue;
+                    HASH256_update(&sha256,Msg,MsgLen);
+                    HASH256_hash(&sha256,MD2);
+                    if (memcmp(MD,MD2,MDLen)!=0) break;
+                }
             }
 
+            // Several copies at once
+            pMsg[0]=pMsg[1]=pMsg[2]=Msg;
+            lMsg[0]=lMsg[1]=lMsg[2]=MsgLen;
+            if (!strcmp(argv[2], "sha512"))
+                HASH512_multi(3,pMsg,lMsg,pMD);
+            else
+                HASH256_multi(3,pMsg,lMsg,pMD);
+            bad=0;
+            for (i=0; i<3; i++)
+                if (memcmp(MD,MD3[i],MDLen)!=0) bad=1;
+
             octet MDOct= {MDLen,MDLen,MD};
             int rc = OCT_comp(&MD1Oct,&MDOct);
-            if (!rc)
+            if (!rc || memcmp(MD,MD2,MDLen)!=0 || bad)
             {
                 printf("TEST HASH FAILED COMPARE MD LINE %d\n",lineNo);
                 exit(EXIT_FAILURE);
@@ -169,6 +259,18 @@ int main(int argc, char** argv)
         printf("ERROR Empty test vector file\n");
         exit(EXIT_FAILURE);
     }
+
+    // Many messages at once, alone and resumed from states
+    for (i=0; i<(int)sizeof(buf); i++) buf[i]=(char)(i*7+i/256);
+    for (b=0; b<3; b++)
+    {
+        if (!check_multi(32,b) || !check_multi(48,b) || !check_multi(64,b))
+        {
+            printf("TEST HASH FAILED MULTIPLE MESSAGES\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
     printf("SUCCESS TEST HASH %s PASSED\n", argv[2]);
     exit(EXIT_SUCCESS);
 }
@@ -0,0 +1,416 @@
+/**
+ * @file test_mpin_ctx.c
+ * @brief Test MPIN server using a server context
+ *
+ * LICENSE
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/* Test good and bad PIN with a server context, with and without precomputed pairing lines, singly and in a batch */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "mpin.h"
+
+/* Server contexts are too large for the stack when pairing lines are precomputed */
+static MPIN_SERVER_CTX CTX[2];
+
+#define NB 4 /* Batch size */
+
+int main()
+{
+    int i,j,p,PIN1,PIN2,rtn;
+    unsign32 TimeValue;
+
+    char id[256];
+    octet ID = {0,sizeof(id),id};
+
+    char x[PGS],y[PGS];
+    octet X= {0, sizeof(x),x};
+    octet Y= {0,sizeof(y),y};
+
+    /* Master secret shares */
+    char ms1[PGS], ms2[PGS];
+    octet MS1= {0,sizeof(ms1),ms1};
+    octet MS2= {0,sizeof(ms2),ms2};
+
+    /* Hash values of Client ID */
+    char hcid[PFS];
+    octet HCID= {0,sizeof(hcid), hcid};
+
+    /* Client secret and shares */
+    char cs1[2*PFS+1], cs2[2*PFS+1], sec[2*PFS+1];
+    octet SEC= {0,sizeof(sec),sec};
+    octet CS1= {0,sizeof(cs1), cs1};
+    octet CS2= {0,sizeof(cs2), cs2};
+
+    /* Server secret and shares */
+    char ss1[4*PFS], ss2[4*PFS], serverSecret[4*PFS];
+    octet ServerSecret= {0,sizeof(serverSecret),serverSecret};
+    octet SS1= {0,sizeof(ss1),ss1};
+    octet SS2= {0,sizeof(ss2),ss2};
+
+    /* Time Permit and shares */
+    char tp1[2*PFS+1], tp2[2*PFS+1], tp[2*PFS+1];
+    octet TP= {0,sizeof(tp),tp};
+    octet TP1= {0,sizeof(tp1),tp1};
+    octet TP2= {0,sizeof(tp2),tp2};
+
+    /* Token stored on computer */
+    char token[2*PFS+1];
+    octet TOKEN= {0,sizeof(token),token};
+
+    char ut[2*PFS+1],u[2*PFS+1];
+    octet UT= {0,sizeof(ut),ut};
+    octet U= {0,sizeof(u),u};
+
+    char hid[2*PFS+1],htid[2*PFS+1];
+    octet HID= {0,sizeof(hid),hid};
+    octet HTID= {0,sizeof(htid),htid};
+
+    char e[12*PFS], f[12*PFS];
+    octet E= {0,sizeof(e),e};
+    octet F= {0,sizeof(f),f};
+
+    char ec[12*PFS], fc[12*PFS];
+    octet EC= {0,sizeof(ec),ec};
+    octet FC= {0,sizeof(fc),fc};
+
+    /* Batch of client values */
+    char bu[NB][2*PFS+1],but[NB][2*PFS+1],bv[NB][2*PFS+1],by[NB][PGS];
+    octet BU[NB],BUT[NB],BV[NB],BY[NB];
+    octet *pHID[NB],*pHTID[NB],*pU[NB],*pUT[NB],*pV[NB],*pY[NB];
+    int results[NB];
+
+    PIN1 = 1234;
+    PIN2 = 1240;
+
+    /* Assign the End-User an ID */
+    char* user = "testuser@miracl.com";
+    OCT_jstring(&ID,user);
+    printf("CLIENT: ID %s\n", user);
+
+    int date = 0;
+    char seed[100] = {0};
+    octet SEED = {0,sizeof(seed),seed};
+    csprng RNG;
+
+    /* unrandom seed value! */
+    SEED.len=100;
+    for (i=0; i<100; i++) SEED.val[i]=i+1;
+
+    /* initialise random number generator */
+    MPIN_CREATE_CSPRNG(&RNG,&SEED);
+
+    /* Hash ID */
+    MPIN_HASH_ID(HASH_TYPE_MPIN,&ID,&HCID);
+    OCT_output(&HCID);
+
+    /* When set only send hashed IDs to server */
+    octet *pID;
+#ifdef USE_ANONYMOUS
+    pID = &HCID;
+#else
+    pID = &ID;
+#endif
+
+    /* Generate Client master secret for MIRACL and Customer */
+    rtn = MPIN_RANDOM_GENERATE(&RNG,&MS1);
+    if (rtn != 0)
+    {
+        printf("MPIN_RANDOM_GENERATE(&RNG,&MS1) Error %d\n", rtn);
+        return 1;
+    }
+    rtn = MPIN_RANDOM_GENERATE(&RNG,&MS2);
+    if (rtn != 0)
+    {
+        printf("MPIN_RANDOM_GENERATE(&RNG,&MS2) Error %d\n", rtn);
+        return 1;
+    }
+    printf("MASTER SECRET MIRACL:= 0x");
+    OCT_output(&MS1);
+    printf("MASTER SECRET CUSTOMER:= 0x");
+    OCT_output(&MS2);
+
+    /* Generate server secret shares */
+    rtn = MPIN_GET_SERVER_SECRET(&MS1,&SS1);
+    if (rtn != 0)
+    {
+        printf("MPIN_GET_SERVER_SECRET(&MS1,&SS1) Error %d\n", rtn);
+        return 1;
+    }
+    rtn = MPIN_GET_SERVER_SECRET(&MS2,&SS2);
+    if (rtn != 0)
+    {
+        printf("MPIN_GET_SERVER_SECRET(&MS2,&SS2) Error %d\n", rtn);
+        return 1;
+    }
+    printf("SS1 = 0x");
+    OCT_output(&SS1);
+    printf("SS2 = 0x");
+    OCT_output(&SS2);
+
+    /* Combine server secret share */
+    rtn = MPIN_RECOMBINE_G2(&SS1, &SS2, &ServerSecret);
+    if (rtn != 0)
+    {
+        printf("MPIN_RECOMBINE_G2(&SS1, &SS2, &ServerSecret) Error %d\n", rtn);
+        return 1;
+    }
+    printf("ServerSecret = 0x");
+    OCT_output(&ServerSecret);
+
+    /* Generate client secret shares */
+    rtn = MPIN_GET_CLIENT_SECRET(&MS1,&HCID,&CS1);
+    if (rtn != 0)
+    {
+        printf("MPIN_GET_CLIENT_SECRET(&MS1,&HCID,&CS1) Error %d\n", rtn);
+        return 1;
+    }
+    rtn = MPIN_GET_CLIENT_SECRET(&MS2,&HCID,&CS2);
+    if (rtn != 0)
+    {
+        printf("MPIN_GET_CLIENT_SECRET(&MS2,&HCID,&CS2) Error %d\n", rtn);
+        return 1;
+    }
+    printf("CS1 = 0x");
+    OCT_output(&CS1);
+    printf("CS2 = 0x");
+    OCT_output(&CS2);
+
+    /* Combine client secret shares : TOKEN is the full client secret */
+    rtn = MPIN_RECOMBINE_G1(&CS1, &CS2, &TOKEN);
+    if (rtn != 0)
+    {
+        printf("MPIN_RECOMBINE_G1(&CS1, &CS2, &TOKEN) Error %d\n", rtn);
+        return 1;
+    }
+    printf("Client Secret = 0x");
+    OCT_output(&TOKEN);
+
+    /* Generate Time Permit shares */
+    date = MPIN_today();
+    printf("Date %d \n", date);
+    rtn = MPIN_GET_CLIENT_PERMIT(HASH_TYPE_MPIN,date,&MS1,&HCID,&TP1);
+    if (rtn != 0)
+    {
+        printf("MPIN_GET_CLIENT_PERMIT(date,&MS1,&HCID,&TP1) Error %d\n", rtn);
+        return 1;
+    }
+    rtn = MPIN_GET_CLIENT_PERMIT(HASH_TYPE_MPIN,date,&MS2,&HCID,&TP2);
+    if (rtn != 0)
+    {
+        printf("MPIN_GET_CLIENT_PERMIT(date,&MS2,&HCID,&TP2) Error %d\n", rtn);
+        return 1;
+    }
+    printf("TP1 = 0x");
+    OCT_output(&TP1);
+    printf("TP2 = 0x");
+    OCT_output(&TP2);
+
+    /* Combine Time Permit shares */
+    rtn = MPIN_RECOMBINE_G1(&TP1, &TP2, &TP);
+    if (rtn != 0)
+    {
+        printf("MPIN_RECOMBINE_G1(&TP1, &TP2, &TP) Error %d\n", rtn);
+        return 1;
+    }
+    printf("Time Permit = 0x");
+    OCT_output(&TP);
+
+    /* Client extracts PIN1 from secret to create Token */
+    rtn = MPIN_EXTRACT_PIN(HASH_TYPE_MPIN,&ID, PIN1, &TOKEN);
+    if (rtn != 0)
+    {
+        printf("MPIN_EXTRACT_PIN( &ID, PIN, &TOKEN) Error %d\n", rtn);
+        return 1;
+    }
+    printf("Token = 0x");
+    OCT_output(&TOKEN);
+
+    /* Server contexts without and with precomputed pairing lines */
+    for (p=0; p<2; p++)
+    {
+        rtn = MPIN_SERVER_CTX_CREATE(&CTX[p],&ServerSecret,p);
+        if (rtn != 0)
+        {
+            printf("MPIN_SERVER_CTX_CREATE(&CTX,&ServerSecret,%d) Error %d\n", p, rtn);
+            return 1;
+        }
+    }
+
+    /* Three pass protocol with correct PIN */
+    rtn = MPIN_CLIENT_1(HASH_TYPE_MPIN,date,&ID,&RNG,&X,PIN1,&TOKEN,&SEC,&U,&UT,&TP);
+    if (rtn != 0)
+    {
+        printf("MPIN_CLIENT_1 ERROR %d\n", rtn);
+        return 1;
+    }
+    MPIN_SERVER_1(HASH_TYPE_MPIN,date,pID,&HID,&HTID);
+    MPIN_RANDOM_GENERATE(&RNG,&Y);
+    MPIN_CLIENT_2(&X,&Y,&SEC);
+    for (p=0; p<2; p++)
+    {
+        rtn = MPIN_SERVER_2_ctx(&CTX[p],date,&HID,&HTID,&Y,&U,&UT,&SEC,&EC,&FC);
+        if (rtn != 0)
+        {
+            printf("FAILURE good PIN, precompute %d, Error Code %d\n", p, rtn);
+            return 1;
+        }
+    }
+
+    /* Three pass protocol with wrong PIN - PIN error data must match MPIN_SERVER_2 */
+    rtn = MPIN_CLIENT_1(HASH_TYPE_MPIN,date,&ID,&RNG,&X,PIN2,&TOKEN,&SEC,&U,&UT,&TP);
+    if (rtn != 0)
+    {
+        printf("MPIN_CLIENT_1 ERROR %d\n", rtn);
+        return 1;
+    }
+    MPIN_SERVER_1(HASH_TYPE_MPIN,date,pID,&HID,&HTID);
+    MPIN_RANDOM_GENERATE(&RNG,&Y);
+    MPIN_CLIENT_2(&X,&Y,&SEC);
+    rtn = MPIN_SERVER_2(date,&HID,&HTID,&Y,&ServerSecret,&U,&UT,&SEC,&E,&F);
+    if (rtn != MPIN_BAD_PIN)
+    {
+        printf("FAILURE bad PIN accepted, Error Code %d\n", rtn);
+        return 1;
+    }
+    for (p=0; p<2; p++)
+    {
+        rtn = MPIN_SERVER_2_ctx(&CTX[p],date,&HID,&HTID,&Y,&U,&UT,&SEC,&EC,&FC);
+        if (rtn != MPIN_BAD_PIN || !OCT_comp(&E,&EC) || !OCT_comp(&F,&FC))
+        {
+            printf("FAILURE bad PIN, precompute %d, Error Code %d\n", p, rtn);
+            return 1;
+        }
+    }
+
+    /* Server first pass for a batch of different clients, with and without a date */
+    for (p=0; p<2; p++)
+    {
+        int bdate=(p==0)?0:MPIN_today();
+        for (i=0; i<NB; i++)
+        {
+            BU[i].len=0;
+            BU[i].max=sizeof(bu[i]);
+            BU[i].val=bu[i];
+            BUT[i].len=0;
+            BUT[i].max=sizeof(but[i]);
+            BUT[i].val=but[i];
+            BV[i].len=0;
+            BV[i].max=sizeof(bv[i]);
+            BV[i].val=bv[i];
+            OCT_copy(&BV[i],pID);
+            OCT_jbyte(&BV[i],'a'+i,i); /* distinct IDs of different lengths */
+            pV[i]=&BV[i];
+            pU[i]=&BU[i];
+            pUT[i]=&BUT[i];
+        }
+        MPIN_SERVER_1_batch(HASH_TYPE_MPIN,bdate,NB,pV,pU,pUT);
+        for (i=0; i<NB; i++)
+        {
+            MPIN_SERVER_1(HASH_TYPE_MPIN,bdate,&BV[i],&HID,&HTID);
+            if (!OCT_comp(&HID,&BU[i]) || (bdate && !OCT_comp(&HTID,&BUT[i])))
+            {
+                printf("FAILURE server first pass batch, date %d, item %d\n", bdate, i);
+                return 1;
+            }
+        }
+    }
+    MPIN_SERVER_1(HASH_TYPE_MPIN,date,pID,&HID,&HTID);
+
+    /* Batch of clients with the third one using the wrong PIN, then all with the correct PIN */
+    for (j=0; j<2; j++)
+    {
+        for (i=0; i<NB; i++)
+        {
+            BU[i].len=0;
+            BU[i].max=sizeof(bu[i]);
+            BU[i].val=bu[i];
+            BUT[i].len=0;
+            BUT[i].max=sizeof(but[i]);
+            BUT[i].val=but[i];
+            BV[i].len=0;
+            BV[i].max=sizeof(bv[i]);
+            BV[i].val=bv[i];
+            BY[i].len=0;
+            BY[i].max=sizeof(by[i]);
+            BY[i].val=by[i];
+            pHID[i]=&HID;
+            pHTID[i]=&HTID;
+            pU[i]=&BU[i];
+            pUT[i]=&BUT[i];
+            pV[i]=&BV[i];
+            pY[i]=&BY[i];
+
+            rtn = MPIN_CLIENT_1(HASH_TYPE_MPIN,date,&ID,&RNG,&X,(j==0 && i==2)?PIN2:PIN1,&TOKEN,&BV[i],&BU[i],&BUT[i],&TP);
+            if (rtn != 0)
+            {
+                printf("MPIN_CLIENT_1 ERROR %d\n", rtn);
+                return 1;
+            }
+            MPIN_RANDOM_GENERATE(&RNG,&BY[i]);
+            MPIN_CLIENT_2(&X,&BY[i],&BV[i]);
+        }
+        MPIN_SERVER_1(HASH_TYPE_MPIN,date,pID,&HID,&HTID);
+
+        for (p=0; p<2; p++)
+        {
+            rtn = MPIN_SERVER_2_batch(&CTX[p],&RNG,NB,date,pHID,pHTID,pY,pU,pUT,pV,results);
+            for (i=0; i<NB; i++)
+            {
+                if (results[i] != ((j==0 && i==2)?MPIN_BAD_PIN:0))
+                {
+                    printf("FAILURE batch %d, precompute %d, item %d, Error Code %d\n", j, p, i, results[i]);
+                    return 1;
+                }
+            }
+            if (rtn != ((j==0)?MPIN_BAD_PIN:0))
+            {
+                printf("FAILURE batch %d, precompute %d, Error Code %d\n", j, p, rtn);
+                return 1;
+            }
+        }
+    }
+
+    /* One pass protocol with correct PIN */
+    for (p=0; p<2; p++)
+    {
+        TimeValue = MPIN_GET_TIME();
+        rtn = MPIN_CLIENT(HASH_TYPE_MPIN,date,&ID,&RNG,&X,PIN1,&TOKEN,&SEC,&U,&UT,&TP,NULL,TimeValue,&Y);
+        if (rtn != 0)
+        {
+            printf("MPIN_CLIENT ERROR %d\n", rtn);
+            return 1;
+        }
+        rtn = MPIN_SERVER_ctx(&CTX[p],HASH_TYPE_MPIN,date,&HID,&HTID,&Y,&U,&UT,&SEC,&EC,&FC,pID,NULL,TimeValue);
+        if (rtn != 0)
+        {
+            printf("FAILURE one pass, precompute %d, Error Code %d\n", p, rtn);
+            return 1;
+        }
+        MPIN_SERVER_CTX_KILL(&CTX[p]);
+    }
+
+    printf("SUCCESS\n");
+    MPIN_KILL_CSPRNG(&RNG);
+    return 0;
+}
@@ -0,0 +1,320 @@
+/**
+ * @file test_mpin_pool.c
+ * @brief Test MPIN server batch verification with a pool of threads
+ *
+ * LICENSE
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/* Test a batch of good and bad PINs split between worker threads, against the single client result */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "mpin.h"
+
+/* Server context and pool are too large for the stack */
+static MPIN_SERVER_CTX CTX;
+static MPIN_POOL POOL;
+
+#define NB 20      /* Batch size */
+#define NTHREADS 4 /* Worker threads */
+
+int main()
+{
+    int i,PIN1,PIN2,rtn;
+
+    char id[256];
+    octet ID = {0,sizeof(id),id};
+
+    char x[PGS];
+    octet X= {0, sizeof(x),x};
+
+    /* Master secret shares */
+    char ms1[PGS], ms2[PGS];
+    octet MS1= {0,sizeof(ms1),ms1};
+    octet MS2= {0,sizeof(ms2),ms2};
+
+    /* Hash values of Client ID */
+    char hcid[PFS];
+    octet HCID= {0,sizeof(hcid), hcid};
+
+    /* Client secret and shares */
+    char cs1[2*PFS+1], cs2[2*PFS+1];
+    octet CS1= {0,sizeof(cs1), cs1};
+    octet CS2= {0,sizeof(cs2), cs2};
+
+    /* Server secret and shares */
+    char ss1[4*PFS], ss2[4*PFS], serverSecret[4*PFS];
+    octet ServerSecret= {0,sizeof(serverSecret),serverSecret};
+    octet SS1= {0,sizeof(ss1),ss1};
+    octet SS2= {0,sizeof(ss2),ss2};
+
+    /* Time Permit and shares */
+    char tp1[2*PFS+1], tp2[2*PFS+1], tp[2*PFS+1];
+    octet TP= {0,sizeof(tp),tp};
+    octet TP1= {0,sizeof(tp1),tp1};
+    octet TP2= {0,sizeof(tp2),tp2};
+
+    /* Token stored on computer */
+    char token[2*PFS+1];
+    octet TOKEN= {0,sizeof(token),token};
+
+    char hid[2*PFS+1],htid[2*PFS+1];
+    octet HID= {0,sizeof(hid),hid};
+    octet HTID= {0,sizeof(htid),htid};
+
+    /* Batch of client values */
+    char bu[NB][2*PFS+1],but[NB][2*PFS+1],bv[NB][2*PFS+1],by[NB][PGS];
+    octet BU[NB],BUT[NB],BV[NB],BY[NB];
+    octet *pHID[NB],*pHTID[NB],*pU[NB],*pUT[NB],*pV[NB],*pY[NB];
+    int results[NB],expected[NB];
+
+    PIN1 = 1234;
+    PIN2 = 1240;
+
+    /* Assign the End-User an ID */
+    char* user = "testuser@miracl.com";
+    OCT_jstring(&ID,user);
+    printf("CLIENT: ID %s\n", user);
+
+    int date = 0;
+    char seed[100] = {0};
+    octet SEED = {0,sizeof(seed),seed};
+    csprng RNG;
+
+    /* unrandom seed value! */
+    SEED.len=100;
+    for (i=0; i<100; i++) SEED.val[i]=i+1;
+
+    /* initialise random number generator */
+    MPIN_CREATE_CSPRNG(&RNG,&SEED);
+
+    /* Hash ID */
+    MPIN_HASH_ID(HASH_TYPE_MPIN,&ID,&HCID);
+    OCT_output(&HCID);
+
+    /* When set only send hashed IDs to server */
+    octet *pID;
+#ifdef USE_ANONYMOUS
+    pID = &HCID;
+#else
+    pID = &ID;
+#endif
+
+    /* Generate Client master secret for MIRACL and Customer */
+    rtn = MPIN_RANDOM_GENERATE(&RNG,&MS1);
+    if (rtn != 0)
+    {
+        printf("MPIN_RANDOM_GENERATE(&RNG,&MS1) Error %d\n", rtn);
+        return 1;
+    }
+    rtn = MPIN_RANDOM_GENERATE(&RNG,&MS2);
+    if (rtn != 0)
+    {
+        printf("MPIN_RANDOM_GENERATE(&RNG,&MS2) Error %d\n", rtn);
+        return 1;
+    }
+    printf("MASTER SECRET MIRACL:= 0x");
+    OCT_output(&MS1);
+    printf("MASTER SECRET CUSTOMER:= 0x");
+    OCT_output(&MS2);
+
+    /* Generate server secret shares */
+    rtn = MPIN_GET_SERVER_SECRET(&MS1,&SS1);
+    if (rtn != 0)
+    {
+        printf("MPIN_GET_SERVER_SECRET(&MS1,&SS1) Error %d\n", rtn);
+        return 1;
+    }
+    rtn = MPIN_GET_SERVER_SECRET(&MS2,&SS2);
+    if (rtn != 0)
+    {
+        printf("MPIN_GET_SERVER_SECRET(&MS2,&SS2) Error %d\n", rtn);
+        return 1;
+    }
+    printf("SS1 = 0x");
+    OCT_output(&SS1);
+    printf("SS2 = 0x");
+    OCT_output(&SS2);
+
+    /* Combine server secret share */
+    rtn = MPIN_RECOMBINE_G2(&SS1, &SS2, &ServerSecret);
+    if (rtn != 0)
+    {
+        printf("MPIN_RECOMBINE_G2(&SS1, &SS2, &ServerSecret) Error %d\n", rtn);
+        return 1;
+    }
+    printf("ServerSecret = 0x");
+    OCT_output(&ServerSecret);
+
+    /* Generate client secret shares */
+    rtn = MPIN_GET_CLIENT_SECRET(&MS1,&HCID,&CS1);
+    if (rtn != 0)
+    {
+        printf("MPIN_GET_CLIENT_SECRET(&MS1,&HCID,&CS1) Error %d\n", rtn);
+        return 1;
+    }
+    rtn = MPIN_GET_CLIENT_SECRET(&MS2,&HCID,&CS2);
+    if (rtn != 0)
+    {
+        printf("MPIN_GET_CLIENT_SECRET(&MS2,&HCID,&CS2) Error %d\n", rtn);
+        return 1;
+    }
+    printf("CS1 = 0x");
+    OCT_output(&CS1);
+    printf("CS2 = 0x");
+    OCT_output(&CS2);
+
+    /* Combine client secret shares : TOKEN is the full client secret */
+    rtn = MPIN_RECOMBINE_G1(&CS1, &CS2, &TOKEN);
+    if (rtn != 0)
+    {
+        printf("MPIN_RECOMBINE_G1(&CS1, &CS2, &TOKEN) Error %d\n", rtn);
+        return 1;
+    }
+    printf("Client Secret = 0x");
+    OCT_output(&TOKEN);
+
+    /* Generate Time Permit shares */
+    date = MPIN_today();
+    printf("Date %d \n", date);
+    rtn = MPIN_GET_CLIENT_PERMIT(HASH_TYPE_MPIN,date,&MS1,&HCID,&TP1);
+    if (rtn != 0)
+    {
+        printf("MPIN_GET_CLIENT_PERMIT(date,&MS1,&HCID,&TP1) Error %d\n", rtn);
+        return 1;
+    }
+    rtn = MPIN_GET_CLIENT_PERMIT(HASH_TYPE_MPIN,date,&MS2,&HCID,&TP2);
+    if (rtn != 0)
+    {
+        printf("MPIN_GET_CLIENT_PERMIT(date,&MS2,&HCID,&TP2) Error %d\n", rtn);
+        return 1;
+    }
+    printf("TP1 = 0x");
+    OCT_output(&TP1);
+    printf("TP2 = 0x");
+    OCT_output(&TP2);
+
+    /* Combine Time Permit shares */
+    rtn = MPIN_RECOMBINE_G1(&TP1, &TP2, &TP);
+    if (rtn != 0)
+    {
+        printf("MPIN_RECOMBINE_G1(&TP1, &TP2, &TP) Error %d\n", rtn);
+        return 1;
+    }
+    printf("Time Permit = 0x");
+    OCT_output(&TP);
+
+    /* Client extracts PIN1 from secret to create Token */
+    rtn = MPIN_EXTRACT_PIN(HASH_TYPE_MPIN,&ID, PIN1, &TOKEN);
+    if (rtn != 0)
+    {
+        printf("MPIN_EXTRACT_PIN( &ID, PIN, &TOKEN) Error %d\n", rtn);
+        return 1;
+    }
+    printf("Token = 0x");
+    OCT_output(&TOKEN);
+
+    rtn = MPIN_SERVER_CTX_CREATE(&CTX,&ServerSecret,1);
+    if (rtn != 0)
+    {
+        printf("MPIN_SERVER_CTX_CREATE(&CTX,&ServerSecret,1) Error %d\n", rtn);
+        return 1;
+    }
+    rtn = MPIN_POOL_CREATE(&POOL,NTHREADS,&RNG);
+    if (rtn != 0)
+    {
+        printf("MPIN_POOL_CREATE(&POOL,%d,&RNG) Error %d\n", NTHREADS, rtn);
+        return 1;
+    }
+
+    /* Every seventh client uses the wrong PIN */
+    MPIN_SERVER_1(HASH_TYPE_MPIN,date,pID,&HID,&HTID);
+    for (i=0; i<NB; i++)
+    {
+        BU[i].len=0;
+        BU[i].max=sizeof(bu[i]);
+        BU[i].val=bu[i];
+        BUT[i].len=0;
+        BUT[i].max=sizeof(but[i]);
+        BUT[i].val=but[i];
+        BV[i].len=0;
+        BV[i].max=sizeof(bv[i]);
+        BV[i].val=bv[i];
+        BY[i].len=0;
+        BY[i].max=sizeof(by[i]);
+        BY[i].val=by[i];
+        pHID[i]=&HID;
+        pHTID[i]=&HTID;
+        pU[i]=&BU[i];
+        pUT[i]=&BUT[i];
+        pV[i]=&BV[i];
+        pY[i]=&BY[i];
+
+        rtn = MPIN_CLIENT_1(HASH_TYPE_MPIN,date,&ID,&RNG,&X,(i%7==3)?PIN2:PIN1,&TOKEN,&BV[i],&BU[i],&BUT[i],&TP);
+        if (rtn != 0)
+        {
+            printf("MPIN_CLIENT_1 ERROR %d\n", rtn);
+            return 1;
+        }
+        MPIN_RANDOM_GENERATE(&RNG,&BY[i]);
+        MPIN_CLIENT_2(&X,&BY[i],&BV[i]);
+        expected[i]=MPIN_SERVER_2_ctx(&CTX,date,&HID,&HTID,&BY[i],&BU[i],&BUT[i],&BV[i],NULL,NULL);
+    }
+
+    /* Whole batch, then a batch with fewer clients than workers */
+    rtn = MPIN_SERVER_2_pool(&POOL,&CTX,NB,date,pHID,pHTID,pY,pU,pUT,pV,results);
+    if (rtn != MPIN_BAD_PIN)
+    {
+        printf("FAILURE batch Error Code %d\n", rtn);
+        return 1;
+    }
+    for (i=0; i<NB; i++)
+    {
+        if (results[i] != expected[i])
+        {
+            printf("FAILURE batch item %d, Error Code %d\n", i, results[i]);
+            return 1;
+        }
+    }
+
+    rtn = MPIN_SERVER_2_pool(&POOL,&CTX,NTHREADS-1,date,pHID,pHTID,pY,pU,pUT,pV,results);
+    if (rtn != 0)
+    {
+        printf("FAILURE small batch Error Code %d\n", rtn);
+        return 1;
+    }
+    for (i=0; i<NTHREADS-1; i++)
+    {
+        if (results[i] != expected[i])
+        {
+            printf("FAILURE small batch item %d, Error Code %d\n", i, results[i]);
+            return 1;
+        }
+    }
+
+    MPIN_POOL_KILL(&POOL);
+    MPIN_SERVER_CTX_KILL(&CTX);
+
+    printf("SUCCESS\n");
+    MPIN_KILL_CSPRNG(&RNG);
+    return 0;
+}
@@ -0,0 +1,238 @@
+/**
+ * @file test_pair.c
+ * @brief Test pairing with precomputed lines against the direct calculation
+ *
+ * LICENSE
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "amcl.h"
+
+#define N_ITER 5
+#define N_MULTI (PAIR_MULTI_MAX+3)
+#define N_MULN (ECP_PIPPENGER_MIN+5)
+
+static pair_table T,U;
+static ECP2 X[N_MULN],Y[N_MULN];
+static BIG E[N_MULN];
+static FP2 Z[N_MULN],IZ[N_MULN];
+
+int main()
+{
+    int i,j;
+    char raw[100];
+    csprng rng;
+    BIG r,s,gx,gy;
+    FP2 qx,qy,t;
+    ECP G,Q,S;
+    ECP2 W,P,R;
+    FP12 e,f,g;
+    ECP2 MP[N_MULTI],*pMP[N_MULTI];
+    ECP MQ[N_MULTI],*pMQ[N_MULTI];
+
+    /* Fake random source */
+    RAND_clean(&rng);
+    for (i=0; i<100; i++) raw[i]=(char)i;
+    RAND_seed(&rng,100,raw);
+
+    BIG_rcopy(r,CURVE_Order);
+
+    BIG_rcopy(gx,CURVE_Gx);
+    BIG_rcopy(gy,CURVE_Gy);
+    ECP_set(&G,gx,gy);
+
+    BIG_rcopy(qx.a,CURVE_Pxa_NRES);
+    BIG_rcopy(qx.b,CURVE_Pxb_NRES);
+    BIG_rcopy(qy.a,CURVE_Pya_NRES);
+    BIG_rcopy(qy.b,CURVE_Pyb_NRES);
+    ECP2_set(&W,&qx,&qy);
+
+    /* Point at infinity has no lines */
+    ECP2_inf(&P);
+    if (PAIR_precompute(&T,&P))
+    {
+        printf("ERROR precomputing lines of the point at infinity\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (i=0; i<N_ITER; i++)
+    {
+        BIG_randomnum(s,r,&rng);
+        ECP2_copy(&P,&W);
+        PAIR_G2mul(&P,s);
+        BIG_randomnum(s,r,&rng);
+        ECP2_copy(&R,&W);
+        PAIR_G2mul(&R,s);
+
+        if (!PAIR_precompute(&T,&P) || !PAIR_precompute(&U,&R))
+        {
+            printf("ERROR precomputing lines\n");
+            exit(EXIT_FAILURE);
+        }
+        if (T.n!=PAIR_TABLE_LINES || U.n!=PAIR_TABLE_LINES)
+        {
+            printf("ERROR number of lines %d, expected %d\n",T.n,PAIR_TABLE_LINES);
+            exit(EXIT_FAILURE);
+        }
+
+        for (j=0; j<N_ITER; j++)
+        {
+            BIG_randomnum(s,r,&rng);
+            ECP_copy(&Q,&G);
+            PAIR_G1mul(&Q,s);
+            BIG_randomnum(s,r,&rng);
+            ECP_copy(&S,&G);
+            PAIR_G1mul(&S,s);
+
+            PAIR_ate(&e,&P,&Q);
+            PAIR_ate_precomp(&f,&T,&Q);
+            if (!FP12_equals(&e,&f))
+            {
+                printf("ERROR pairing with precomputed lines, iteration %d %d\n",i,j);
+                exit(EXIT_FAILURE);
+            }
+
+            PAIR_double_ate(&e,&P,&Q,&R,&S);
+            PAIR_double_ate_precomp(&f,&T,&Q,&U,&S);
+            PAIR_fexp(&e);
+            PAIR_fexp(&f);
+            if (!FP12_equals(&e,&f))
+            {
+                printf("ERROR double pairing with precomputed lines, iteration %d %d\n",i,j);
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+
+    /* Multi-pairing against product of single pairings, over more than one batch */
+    FP12_one(&g);
+    for (i=0; i<N_MULTI; i++)
+    {
+        BIG_randomnum(s,r,&rng);
+        ECP2_copy(&MP[i],&W);
+        PAIR_G2mul(&MP[i],s);
+        BIG_randomnum(s,r,&rng);
+        ECP_copy(&MQ[i],&G);
+        PAIR_G1mul(&MQ[i],s);
+        pMP[i]=&MP[i];
+        pMQ[i]=&MQ[i];
+
+        PAIR_ate(&e,&MP[i],&MQ[i]);
+        PAIR_fexp(&e);
+        FP12_mul(&g,&e);
+    }
+    PAIR_multi_ate(&f,N_MULTI,pMP,pMQ);
+    PAIR_fexp(&f);
+    if (!FP12_equals(&f,&g))
+    {
+        printf("ERROR multi-pairing\n");
+        exit(EXIT_FAILURE);
+    }
+    if (PAIR_multi_isunity(N_MULTI,pMP,pMQ))
+    {
+        printf("ERROR multi-pairing product is unity\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* e(s.P,Q).e(P,-s.Q).e(O,Q)=1 */
+    BIG_randomnum(s,r,&rng);
+    ECP2_copy(&MP[0],&W);
+    PAIR_G2mul(&MP[0],s);
+    ECP_copy(&MQ[0],&G);
+    ECP2_copy(&MP[1],&W);
+    ECP_copy(&MQ[1],&G);
+    PAIR_G1mul(&MQ[1],s);
+    ECP_neg(&MQ[1]);
+    ECP2_inf(&MP[2]);
+    ECP_copy(&MQ[2],&G);
+    if (!PAIR_multi_isunity(3,pMP,pMQ))
+    {
+        printf("ERROR multi-pairing product is not unity\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* G2 multi-multiplication against sum of single multiplications */
+    ECP2_inf(&P);
+    for (i=0; i<N_MULN; i++)
+    {
+        BIG_randomnum(E[i],r,&rng);
+        BIG_randomnum(s,r,&rng);
+        ECP2_copy(&X[i],&W);
+        ECP2_mul(&X[i],s);
+        if (i==3) ECP2_inf(&X[i]);
+        if (i==8 || i==10)
+        {
+            /* same or opposite point in the same bucket */
+            ECP2_copy(&X[i],&X[i-1]);
+            if (i==10) ECP2_neg(&X[i]);
+            BIG_copy(E[i],E[i-1]);
+        }
+
+        ECP2_copy(&R,&X[i]);
+        ECP2_mul(&R,E[i]);
+        ECP2_add(&P,&R);
+        if (i==ECP_MULN_MAX+3) ECP2_copy(&MP[0],&P);
+    }
+    ECP2_muln(&R,ECP_MULN_MAX+4,X,E);
+    ECP2_muln_ct(&MP[1],ECP_MULN_MAX+4,X,E);
+    if (!ECP2_equals(&R,&MP[0]) || !ECP2_equals(&MP[1],&MP[0]))
+    {
+        printf("ERROR G2 multi-multiplication of %d points\n",ECP_MULN_MAX+4);
+        exit(EXIT_FAILURE);
+    }
+    ECP2_muln(&R,N_MULN,X,E);
+    if (!ECP2_equals(&R,&P))
+    {
+        printf("ERROR G2 multi-multiplication of %d points\n",N_MULN);
+        exit(EXIT_FAILURE);
+    }
+
+    /* Batch inversion and conversion to affine coordinates against one at a time */
+    for (i=0; i<N_MULN; i++)
+    {
+        ECP2_dbl(&X[i]);
+        ECP2_copy(&Y[i],&X[i]);
+        ECP2_affine(&Y[i]);
+        FP2_copy(&Z[i],&(X[i].z));
+    }
+    FP2_inv_batch(N_MULN,IZ,Z);
+    for (i=0; i<N_MULN; i++)
+    {
+        FP2_inv(&t,&Z[i]);
+        if (!FP2_equals(&t,&IZ[i]))
+        {
+            printf("ERROR batch inversion of FP2, element %d\n",i);
+            exit(EXIT_FAILURE);
+        }
+    }
+    ECP2_affine_batch(N_MULN,X,Z);
+    for (i=0; i<N_MULN; i++)
+    {
+        if (X[i].inf!=Y[i].inf || (!Y[i].inf && (!FP2_equals(&(X[i].x),&(Y[i].x)) || !FP2_equals(&(X[i].y),&(Y[i].y)) || !FP2_isunity(&(X[i].z)))))
+        {
+            printf("ERROR batch conversion of ECP2 to affine, point %d\n",i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}